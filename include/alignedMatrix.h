@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+template <typename T, size_t Alignment = 64>
+class AlignedMatrix {
+    static_assert(std::is_trivially_copyable<T>::value, "AlignedMatrix holds trivially copyable cells only");
+    static_assert(Alignment % sizeof(T) == 0, "Cell size must divide the alignment");
+
+private:
+    unsigned char* raw_ = nullptr;
+    T* data_ = nullptr;
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t stride_ = 0;
+
+    static size_t paddedStride(size_t cols) {
+        const size_t perLine = Alignment / sizeof(T);
+        return (cols + perLine - 1) / perLine * perLine;
+    }
+
+    void allocate(size_t rows, size_t cols) {
+        rows_ = rows;
+        cols_ = cols;
+        stride_ = paddedStride(cols);
+        const size_t cells = rows_ * stride_;
+        if (cells == 0) return;
+        raw_ = new unsigned char[cells * sizeof(T) + Alignment - 1];
+        const uintptr_t address = reinterpret_cast<uintptr_t>(raw_);
+        data_ = reinterpret_cast<T*>((address + Alignment - 1) & ~static_cast<uintptr_t>(Alignment - 1));
+    }
+
+public:
+    AlignedMatrix() = default;
+
+    AlignedMatrix(size_t rows, size_t cols, const T& value = T()) {
+        allocate(rows, cols);
+        fill(value);
+    }
+
+    ~AlignedMatrix() { delete[] raw_; }
+
+    AlignedMatrix(const AlignedMatrix& other) {
+        allocate(other.rows_, other.cols_);
+        for (size_t i = 0; i < rows_ * stride_; ++i) {
+            data_[i] = other.data_[i];
+        }
+    }
+
+    AlignedMatrix(AlignedMatrix&& other) noexcept { swap(other); }
+
+    AlignedMatrix& operator=(const AlignedMatrix& other) {
+        if (this != &other) {
+            AlignedMatrix tmp(other);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    AlignedMatrix& operator=(AlignedMatrix&& other) noexcept {
+        if (this != &other) {
+            AlignedMatrix tmp(std::move(other));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    T* operator[](size_t row) { return data_ + row * stride_; }
+    const T* operator[](size_t row) const { return data_ + row * stride_; }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    size_t rows() const noexcept { return rows_; }
+    size_t cols() const noexcept { return cols_; }
+    size_t stride() const noexcept { return stride_; }
+
+    // Padding cells are filled too, so full-stride row scans see the same value past cols().
+    void fill(const T& value) {
+        for (size_t i = 0; i < rows_ * stride_; ++i) {
+            data_[i] = value;
+        }
+    }
+
+    void swap(AlignedMatrix& other) noexcept {
+        std::swap(raw_, other.raw_);
+        std::swap(data_, other.data_);
+        std::swap(rows_, other.rows_);
+        std::swap(cols_, other.cols_);
+        std::swap(stride_, other.stride_);
+    }
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include "dijkstra.h"
+
+// All-pairs shortest paths as one Dijkstra run per source, the runs spread over threads that steal work from
+// each other, each with its own workspace. Rows can be computed for a range of sources only, so one matrix
+// can be split into jobs for several machines, and written straight into a memory-mapped file.
+template <typename W, typename D = W>
+class BasicAllPairs {
+public:
+    // threads = 0 uses every hardware thread; d is the arity of the per-thread heaps.
+    explicit BasicAllPairs(BasicGraphRef<W> graph, size_t threads = 0, int d = 4);
+
+    BasicAllPairs(const BasicAllPairs&) = delete;
+    BasicAllPairs& operator=(const BasicAllPairs&) = delete;
+
+    size_t getNumVertices() const { return numVertices; }
+    size_t getThreadCount() const { return threads; }
+
+    // Rows for the sources in [firstSource, lastSource) into matrix, row r holding the distances from
+    // firstSource + r to every vertex; WeightTraits<D>::unreachable() marks vertices out of reach.
+    void computeRows(int firstSource, int lastSource, D* matrix) const;
+    myVector<D> compute() const;
+    // Same rows as raw row-major D values in a file of (lastSource - firstSource) * V * sizeof(D) bytes,
+    // so the files of consecutive ranges concatenate into the full matrix.
+    void computeToFile(const std::string& path, int firstSource, int lastSource) const;
+
+private:
+    BasicDijkstra<W, D> engine;
+    size_t numVertices;
+    size_t threads;
+    int d;
+};
+
+typedef BasicAllPairs<int, int> AllPairs;
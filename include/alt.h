@@ -0,0 +1,144 @@
+#pragma once
+#include <string>
+#include "astar.h"
+
+// Landmark distance tables for ALT (A*, landmarks, triangle inequality) queries.
+// Tables are indexed by original vertex ids and stored vertex-major, so the bounds for one vertex
+// read a single contiguous run of landmark distances. Unreachable entries hold WeightTraits<D>::infinity().
+template <typename W, typename D = W>
+class BasicLandmarks {
+public:
+    // FARTHEST repeatedly takes the vertex farthest from the landmarks chosen so far.
+    // AVOID grows shortest path trees from random roots and descends into the subtree whose
+    // distances the current landmarks bound worst. PLANAR splits the plane around the centre
+    // into equal angular sectors and takes the farthest vertex of each; it needs coordinates.
+    enum Strategy { FARTHEST, AVOID, PLANAR };
+
+    static myVector<uint32_t> selectLandmarks(BasicGraphRef<W> graph, size_t count, Strategy strategy,
+        const VertexCoordinates* coordinates = nullptr, uint32_t seed = 1);
+
+    // Runs one Dijkstra per landmark (two on directed graphs) on the given number of threads (0 = all).
+    BasicLandmarks(BasicGraphRef<W> graph, const myVector<uint32_t>& landmarks, size_t threads = 0);
+
+    size_t getNumVertices() const { return numVertices; }
+    size_t getNumLandmarks() const { return landmarks.size(); }
+    bool isDirected() const { return directed; }
+    const myVector<uint32_t>& getLandmarks() const { return landmarks; }
+
+    D distanceFrom(size_t landmark, size_t v) const { return fromTable[v * landmarks.size() + landmark]; }
+    D distanceTo(size_t landmark, size_t v) const {
+        return (directed ? toTable : fromTable)[v * landmarks.size() + landmark];
+    }
+
+    // Largest triangle-inequality bound on dist(v, target) over the given landmark indices.
+    D lowerBound(size_t v, size_t target, const uint32_t* active, size_t activeCount) const {
+        const D infinity = WeightTraits<D>::infinity();
+        const size_t k = landmarks.size();
+        const D* fromV = fromTable.data() + v * k;
+        const D* fromT = fromTable.data() + target * k;
+        const D* toV = (directed ? toTable : fromTable).data() + v * k;
+        const D* toT = (directed ? toTable : fromTable).data() + target * k;
+        D best = D();
+        for (size_t i = 0; i < activeCount; ++i) {
+            const uint32_t l = active[i];
+            if (fromV[l] != infinity && fromT[l] != infinity && fromT[l] > fromV[l] && fromT[l] - fromV[l] > best) {
+                best = fromT[l] - fromV[l];
+            }
+            if (toV[l] != infinity && toT[l] != infinity && toV[l] > toT[l] && toV[l] - toT[l] > best) {
+                best = toV[l] - toT[l];
+            }
+        }
+        return best;
+    }
+
+    void save(const std::string& path) const;
+    // The distance type must match the one the tables were written with.
+    static BasicLandmarks load(const std::string& path);
+
+private:
+    size_t numVertices;
+    bool directed;
+    myVector<uint32_t> landmarks;
+    myVector<D> fromTable;
+    myVector<D> toTable;
+
+    BasicLandmarks() : numVertices(0), directed(false) {}
+};
+
+typedef BasicLandmarks<int, int> Landmarks;
+
+template <typename W, typename D>
+class LandmarkHeuristic {
+private:
+    const BasicLandmarks<W, D>* landmarks;
+    const myVector<uint32_t>* active;
+
+public:
+    LandmarkHeuristic(const BasicLandmarks<W, D>& landmarks, const myVector<uint32_t>& active)
+        : landmarks(&landmarks), active(&active) {
+    }
+
+    double operator()(size_t v, size_t target) const {
+        return static_cast<double>(landmarks->lowerBound(v, target, active->data(), active->size()));
+    }
+};
+
+// A* over landmark bounds. Each query activates the landmarks that give the best bound between
+// its source and target, so a bound costs activeLandmarks table lookups instead of one per landmark.
+template <typename W, typename D = W>
+class BasicAlt {
+public:
+    typedef BasicAStar<W, D, LandmarkHeuristic<W, D>> Search;
+    typedef BasicPathResult<D> PathResult;
+    enum HeapType { D_HEAP, BINOMIAL_HEAP };
+
+    // The landmark tables must outlive the engine and describe the same graph.
+    BasicAlt(BasicGraphRef<W> graph, const BasicLandmarks<W, D>& landmarks, size_t activeLandmarks = 4)
+        : landmarks(landmarks), activeLandmarks(activeLandmarks), search(graph, LandmarkHeuristic<W, D>(landmarks, active)) {
+        if (landmarks.getNumVertices() != graph.getNumVertices()) {
+            throw std::invalid_argument("Landmark tables were computed for a different graph");
+        }
+        if (activeLandmarks == 0) {
+            throw std::invalid_argument("At least one landmark must be active");
+        }
+    }
+
+    BasicAlt(const BasicAlt&) = delete;
+    BasicAlt& operator=(const BasicAlt&) = delete;
+
+    PathResult shortestPath(int source, int target, HeapType heapType, int d) {
+        const int n = static_cast<int>(landmarks.getNumVertices());
+        if (source >= 0 && source < n && target >= 0 && target < n) {
+            activate(static_cast<size_t>(source), static_cast<size_t>(target));
+        }
+        return search.shortestPath(source, target, heapType == D_HEAP ? Search::D_HEAP : Search::BINOMIAL_HEAP, d);
+    }
+
+    const myVector<uint32_t>& getActiveLandmarks() const { return active; }
+    size_t getLastSettledCount() const { return search.getLastSettledCount(); }
+
+private:
+    const BasicLandmarks<W, D>& landmarks;
+    size_t activeLandmarks;
+    myVector<uint32_t> active;
+    Search search;
+
+    void activate(size_t source, size_t target) {
+        const size_t k = landmarks.getNumLandmarks();
+        myVector<D> bounds(k);
+        myVector<uint32_t> order(k);
+        for (uint32_t l = 0; l < k; ++l) {
+            bounds[l] = landmarks.lowerBound(source, target, &l, 1);
+            order[l] = l;
+        }
+        const size_t count = activeLandmarks < k ? activeLandmarks : k;
+        std::partial_sort(order.data(), order.data() + count, order.data() + k,
+            [&](uint32_t a, uint32_t b) { return bounds[a] > bounds[b] || (bounds[a] == bounds[b] && a < b); });
+        active.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            active[i] = order[i];
+        }
+    }
+};
+
+typedef BasicAlt<int, int> Alt;
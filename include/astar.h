@@ -0,0 +1,187 @@
+#pragma once
+#include <cmath>
+#include <type_traits>
+#include "dijkstra.h"
+#include "coordinates.h"
+
+// A heuristic is any functor h(v, target) returning a lower bound on the v -> target distance in weight units.
+// The coordinate heuristics multiply by scale, which must not exceed the smallest ratio of edge weight to
+// coordinate length in the graph, or the bound stops being admissible and paths may come out too long.
+
+struct ZeroHeuristic {
+    double operator()(size_t, size_t) const { return 0.0; }
+};
+
+class EuclideanHeuristic {
+private:
+    const VertexCoordinates* coordinates;
+    double scale;
+
+public:
+    explicit EuclideanHeuristic(const VertexCoordinates& coordinates, double scale = 1.0)
+        : coordinates(&coordinates), scale(scale) {
+    }
+
+    double operator()(size_t v, size_t target) const {
+        const double dx = coordinates->getX(v) - coordinates->getX(target);
+        const double dy = coordinates->getY(v) - coordinates->getY(target);
+        return scale * std::sqrt(dx * dx + dy * dy);
+    }
+};
+
+class ManhattanHeuristic {
+private:
+    const VertexCoordinates* coordinates;
+    double scale;
+
+public:
+    explicit ManhattanHeuristic(const VertexCoordinates& coordinates, double scale = 1.0)
+        : coordinates(&coordinates), scale(scale) {
+    }
+
+    double operator()(size_t v, size_t target) const {
+        return scale * (std::fabs(coordinates->getX(v) - coordinates->getX(target)) +
+            std::fabs(coordinates->getY(v) - coordinates->getY(target)));
+    }
+};
+
+// Great-circle distance with x as longitude and y as latitude in degrees; radius defaults to metres.
+class HaversineHeuristic {
+private:
+    const VertexCoordinates* coordinates;
+    double scale;
+
+public:
+    explicit HaversineHeuristic(const VertexCoordinates& coordinates, double scale = 1.0, double radius = 6371000.0)
+        : coordinates(&coordinates), scale(scale * radius) {
+    }
+
+    double operator()(size_t v, size_t target) const {
+        const double toRadians = 3.14159265358979323846 / 180.0;
+        const double lat1 = coordinates->getY(v) * toRadians;
+        const double lat2 = coordinates->getY(target) * toRadians;
+        const double sinLat = std::sin((lat2 - lat1) / 2);
+        const double sinLon = std::sin((coordinates->getX(target) - coordinates->getX(v)) * toRadians / 2);
+        const double a = sinLat * sinLat + std::cos(lat1) * std::cos(lat2) * sinLon * sinLon;
+        return scale * 2 * std::asin(std::sqrt(std::fmin(1.0, a)));
+    }
+};
+
+// Point-to-point A*. The heuristic is a template parameter so every estimate is an inlined call.
+// It always receives original vertex ids, also on reordered graphs. Vertices are reopened when a
+// shorter path to them turns up, so an admissible but inconsistent heuristic still gives exact distances.
+template <typename W, typename D = W, typename Heuristic = EuclideanHeuristic>
+class BasicAStar {
+    static_assert(DistanceCompatible<D, W>::value, "Distance type must be able to hold any edge weight");
+
+public:
+    enum HeapType { D_HEAP, BINOMIAL_HEAP };
+
+    typedef BasicHeapNode<D> Node;
+    typedef BasicPathResult<D> PathResult;
+
+    BasicAStar(BasicGraphRef<W> graph, Heuristic heuristic) : graph(graph), heuristic(heuristic), lastSettled(0) {
+        if (graph.getNumVertices() == 0) {
+            throw std::invalid_argument("Graph cannot be empty");
+        }
+    }
+
+    BasicAStar(const BasicAStar&) = delete;
+    BasicAStar& operator=(const BasicAStar&) = delete;
+
+    PathResult shortestPath(int source, int target, HeapType heapType, int d) {
+        const int n = static_cast<int>(graph.getNumVertices());
+        if (source < 0 || source >= n) {
+            throw std::out_of_range("Start vertex out of range");
+        }
+        if (target < 0 || target >= n) {
+            throw std::out_of_range("Target vertex out of range");
+        }
+        const int from = graph.toInternal(source);
+        const int to = graph.toInternal(target);
+
+        PathResult result = graph.visit([&](const auto& g) {
+            if (heapType == D_HEAP) {
+                DHeap<Node> queue(d);
+                return search(g, from, to, queue);
+            }
+            BinomialHeap<Node> queue;
+            return search(g, from, to, queue);
+        });
+
+        for (size_t i = 0; i < result.path.size(); ++i) {
+            result.path[i] = graph.toOriginal(result.path[i]);
+        }
+        return result;
+    }
+
+    // Vertices expanded by the last query, counting reopened vertices once per expansion.
+    size_t getLastSettledCount() const { return lastSettled; }
+
+private:
+    BasicGraphRef<W> graph;
+    Heuristic heuristic;
+    size_t lastSettled;
+
+    static D toDistance(double bound, std::true_type) { return static_cast<D>(bound); }
+
+    // Rounding down keeps an integer bound admissible and, for integer weights, consistent.
+    static D toDistance(double bound, std::false_type) {
+        return bound > 0 ? static_cast<D>(std::floor(bound)) : D();
+    }
+
+    D estimate(int v, int target) const {
+        const double bound = static_cast<double>(heuristic(static_cast<size_t>(graph.toOriginal(v)), static_cast<size_t>(graph.toOriginal(target))));
+        return toDistance(bound, std::is_floating_point<D>());
+    }
+
+    template <typename Heap, typename G>
+    PathResult search(const G& g, int source, int target, Heap& queue) {
+        const size_t n = g.getNumVertices();
+        const D infinity = WeightTraits<D>::infinity();
+        myVector<D> dist(n, infinity);
+        myVector<D> bound(n, D());
+        myVector<bool> estimated(n, false);
+        myVector<int> predecessors(n, -1);
+        lastSettled = 0;
+
+        dist[source] = 0;
+        bound[source] = estimate(source, target);
+        estimated[source] = true;
+        queue.push({ source, bound[source] });
+
+        while (!queue.empty()) {
+            const Node current = queue.top();
+            queue.pop();
+            const int u = current.vertex;
+            if (current.distance != addDistance(dist[u], bound[u])) continue;
+            ++lastSettled;
+            if (u == target) break;
+
+            g.forEachNeighbor(u, [&](size_t neighbor, W weight) {
+                const int v = static_cast<int>(neighbor);
+                const D candidate = addDistance(dist[u], weight);
+                if (candidate < dist[v]) {
+                    dist[v] = candidate;
+                    predecessors[v] = u;
+                    if (!estimated[v]) {
+                        bound[v] = estimate(v, target);
+                        estimated[v] = true;
+                    }
+                    queue.push({ v, addDistance(candidate, bound[v]) });
+                }
+            });
+        }
+
+        PathResult result;
+        if (dist[target] == infinity) {
+            result.distance = WeightTraits<D>::unreachable();
+            return result;
+        }
+        result.distance = dist[target];
+        result.path = reconstructPath(source, target, predecessors);
+        return result;
+    }
+};
+
+typedef BasicAStar<int, int, EuclideanHeuristic> AStar;
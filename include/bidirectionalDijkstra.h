@@ -0,0 +1,50 @@
+#pragma once
+#include "dijkstra.h"
+
+// Point-to-point search growing one tree forward from the source and one backward from the target
+// (over in-arcs on directed graphs). The side with the smaller queue moves next; the search stops once
+// the two queue minima together reach the best source-target distance seen where the trees touch.
+template <typename W, typename D = W>
+class BasicBidirectionalDijkstra {
+    static_assert(DistanceCompatible<D, W>::value, "Distance type must be able to hold any edge weight");
+
+public:
+    enum HeapType { D_HEAP, BINOMIAL_HEAP };
+
+    typedef BasicHeapNode<D> Node;
+    typedef BasicPathResult<D> PathResult;
+
+    explicit BasicBidirectionalDijkstra(BasicGraphRef<W> graph) : graph(graph), lastSettled(0) {
+        if (graph.getNumVertices() == 0) {
+            throw std::invalid_argument("Graph cannot be empty");
+        }
+    }
+
+    BasicBidirectionalDijkstra(const BasicBidirectionalDijkstra&) = delete;
+    BasicBidirectionalDijkstra& operator=(const BasicBidirectionalDijkstra&) = delete;
+
+    PathResult shortestPath(int source, int target, HeapType heapType, int d);
+
+    // Vertices settled by the last query in both directions together.
+    size_t getLastSettledCount() const { return lastSettled; }
+
+private:
+    struct Side {
+        myVector<D> dist;
+        myVector<int> links;
+        myVector<bool> settled;
+
+        explicit Side(size_t n) : dist(n, WeightTraits<D>::infinity()), links(n, -1), settled(n, false) {}
+    };
+
+    BasicGraphRef<W> graph;
+    size_t lastSettled;
+
+    template <typename Heap, typename G>
+    PathResult search(const G& g, int source, int target, Heap& forwardQueue, Heap& backwardQueue);
+
+    template <typename Heap, typename G>
+    void settleNext(const G& g, Heap& queue, Side& side, const Side& other, D& best, int& meeting);
+};
+
+typedef BasicBidirectionalDijkstra<int, int> BidirectionalDijkstra;
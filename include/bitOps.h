@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Both helpers expect a non-zero word where it matters: countTrailingZeros(0) is undefined.
+inline unsigned countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    unsigned count = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+inline unsigned popCount(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<unsigned>(__popcnt64(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<unsigned>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Calls f(index) for every set bit of words[0, count), in increasing order.
+template <typename F>
+void forEachSetBit(const uint64_t* words, size_t count, F&& f) {
+    for (size_t w = 0; w < count; ++w) {
+        uint64_t word = words[w];
+        while (word) {
+            f(w * 64 + countTrailingZeros(word));
+            word &= word - 1;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+#include "myvector.h"
+
+// Dial's bucket queue: a circular array with one bucket per key, for integer keys (the distance member of T)
+// that never fall below the last key popped (or the first key pushed) and never exceed it by more than maxStep.
+// With Dijkstra on integer weights maxStep is the largest edge weight, and push and pop are O(1) amortized.
+template <typename T>
+class BucketQueue {
+private:
+    myVector<myVector<T>> buckets;
+    // The cursor only moves forward when the minimum is asked for, so a push right after a pop may still
+    // use the key just popped even if its bucket emptied.
+    mutable size_t cursor;
+    mutable uint64_t currentKey;
+    size_t count;
+    bool anchored;
+
+    static uint64_t key(const T& value) { return static_cast<uint64_t>(value.distance); }
+
+    void advance() const {
+        while (buckets[cursor].empty()) {
+            cursor = cursor + 1 == buckets.size() ? 0 : cursor + 1;
+            ++currentKey;
+        }
+    }
+
+public:
+    static const uint64_t maxRange = uint64_t(1) << 24;
+
+    explicit BucketQueue(uint64_t maxStep) : cursor(0), currentKey(0), count(0), anchored(false) {
+        if (maxStep >= maxRange) throw std::invalid_argument("Key range is too large for a bucket queue");
+        buckets.resize(static_cast<size_t>(maxStep + 1));
+    }
+
+    void push(const T& value) {
+        const uint64_t k = key(value);
+        const bool outside = k < currentKey || k - currentKey >= buckets.size();
+        // An empty queue keeps its window, since the keys pushed after a pop may come in any order.
+        if (count == 0 && (!anchored || outside)) {
+            anchored = true;
+            currentKey = k;
+            cursor = static_cast<size_t>(k % buckets.size());
+        }
+        else if (outside) {
+            throw std::out_of_range("Key outside the bucket queue window");
+        }
+        size_t slot = cursor + static_cast<size_t>(k - currentKey);
+        if (slot >= buckets.size()) slot -= buckets.size();
+        buckets[slot].push_back(value);
+        ++count;
+    }
+
+    const T& top() const {
+        if (count == 0) throw std::out_of_range("Queue is empty");
+        advance();
+        return buckets[cursor].back();
+    }
+
+    void pop() {
+        if (count == 0) throw std::out_of_range("Queue is empty");
+        advance();
+        buckets[cursor].pop_back();
+        --count;
+    }
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    size_t getNumBuckets() const { return buckets.size(); }
+
+    void clear() {
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            buckets[i].clear();
+        }
+        count = 0;
+        anchored = false;
+    }
+};
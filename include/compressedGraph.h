@@ -0,0 +1,114 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "csrGraph.h"
+
+// Read-only adjacency with every row stored as
+//   varint degree | degree fixed-width weights | varint gaps between sorted targets.
+// The first target is stored zigzag-encoded relative to the row's own vertex, so locality-improving
+// orderings (see reorder.h) give one-byte gaps. Integer weights are stored as offsets from the
+// smallest weight in the narrowest of 1, 2, 4 or 8 bytes; floating weights keep their own width.
+template <typename W>
+class BasicCompressedGraph {
+private:
+    static const size_t BLOCK_SHIFT = 6;
+
+    struct Adjacency {
+        myVector<uint64_t> blockOffsets;
+        myVector<uint32_t> rowOffsets;
+        myVector<uint8_t> bytes;
+    };
+
+    size_t numVertices;
+    bool directed;
+    size_t numArcs;
+    W minWeight;
+    size_t weightWidth;
+    Adjacency forward;
+    Adjacency backward;
+
+    void compress(const uint64_t* offsets, const uint32_t* targets, const W* weights, size_t threads, Adjacency& out);
+
+    static uint64_t readVarint(const uint8_t*& p) {
+        uint64_t value = *p++;
+        if (value < 0x80) return value;
+        value &= 0x7f;
+        for (unsigned shift = 7;; shift += 7) {
+            const uint64_t byte = *p++;
+            value |= (byte & 0x7f) << shift;
+            if (byte < 0x80) return value;
+        }
+    }
+
+    template <size_t Width>
+    W loadWeight(const uint8_t* p, std::true_type) const {
+        W weight;
+        std::memcpy(&weight, p, sizeof(W));
+        return weight;
+    }
+
+    template <size_t Width>
+    W loadWeight(const uint8_t* p, std::false_type) const {
+        uint64_t value = 0;
+        for (size_t i = 0; i < Width; ++i) {
+            value |= static_cast<uint64_t>(p[i]) << (8 * i);
+        }
+        return static_cast<W>(minWeight + static_cast<W>(value));
+    }
+
+    const uint8_t* rowStart(const Adjacency& adjacency, size_t u) const {
+        return adjacency.bytes.data() + adjacency.blockOffsets[u >> BLOCK_SHIFT] + adjacency.rowOffsets[u];
+    }
+
+    template <size_t Width, typename F>
+    void decodeRow(const uint8_t* p, size_t degree, size_t u, F& f) const {
+        const uint8_t* gaps = p + degree * Width;
+        const uint64_t first = readVarint(gaps);
+        size_t v = static_cast<size_t>(static_cast<int64_t>(u) + ((first & 1) ? -static_cast<int64_t>(first >> 1) - 1 : static_cast<int64_t>(first >> 1)));
+        f(v, loadWeight<Width>(p, std::is_floating_point<W>()));
+        for (size_t i = 1; i < degree; ++i) {
+            v += static_cast<size_t>(readVarint(gaps)) + 1;
+            f(v, loadWeight<Width>(p + i * Width, std::is_floating_point<W>()));
+        }
+    }
+
+    template <typename F>
+    void forEachInRow(const Adjacency& adjacency, size_t u, F& f) const {
+        const uint8_t* p = rowStart(adjacency, u);
+        const size_t degree = static_cast<size_t>(readVarint(p));
+        if (degree == 0) return;
+        switch (weightWidth) {
+        case 1: decodeRow<1>(p, degree, u, f); break;
+        case 2: decodeRow<2>(p, degree, u, f); break;
+        case 4: decodeRow<4>(p, degree, u, f); break;
+        default: decodeRow<8>(p, degree, u, f); break;
+        }
+    }
+
+public:
+    typedef W WeightType;
+
+    // Rows are compressed on the given number of threads (0 picks the hardware concurrency).
+    explicit BasicCompressedGraph(const BasicCsrGraph<W>& graph, size_t threads = 1);
+
+    size_t getNumVertices() const { return numVertices; }
+    bool isDirected() const { return directed; }
+    size_t getNumArcs() const { return numArcs; }
+    size_t getWeightWidth() const { return weightWidth; }
+    size_t getDegree(size_t u) const;
+    W getEdgeWeight(size_t u, size_t v) const;
+    size_t getMemoryBytes() const;
+
+    template <typename F>
+    void forEachNeighbor(size_t u, F&& f) const {
+        forEachInRow(forward, u, f);
+    }
+
+    template <typename F>
+    void forEachInNeighbor(size_t v, F&& f) const {
+        forEachInRow(directed ? backward : forward, v, f);
+    }
+};
+
+typedef BasicCompressedGraph<int> CompressedGraph;
@@ -0,0 +1,104 @@
+#pragma once
+#include "dijkstra.h"
+
+// Contraction hierarchy over original vertex ids. Vertices are contracted in rounds of independent sets
+// (vertices whose priority is the lowest within two hops), each round in parallel; a shortcut
+// u -> w through v is added unless a witness search finds a path from u to w of at most the same length
+// that avoids v. Every arc of the hierarchy leads from a vertex to one ranked higher (up arcs, stored at
+// the tail) or comes from one ranked higher (down arcs, stored at the head), and keeps the vertex it
+// bypasses so paths can be unpacked into original arcs.
+template <typename W, typename D = W>
+class BasicContractionHierarchy {
+    static_assert(DistanceCompatible<D, W>::value, "Distance type must be able to hold any edge weight");
+
+public:
+    // Witness searches give up after settleLimit vertices or hopLimit arcs; a missed witness only costs
+    // an extra shortcut, never a wrong distance.
+    explicit BasicContractionHierarchy(BasicGraphRef<W> graph, size_t threads = 0,
+        size_t settleLimit = 500, size_t hopLimit = 5);
+
+    size_t getNumVertices() const { return rank.size(); }
+    bool isDirected() const { return directed; }
+    size_t getNumShortcuts() const { return numShortcuts; }
+    size_t getNumUpArcs() const { return up.targets.size(); }
+    size_t getNumDownArcs() const { return down.targets.size(); }
+
+    // Position of v in the contraction order; the last contracted vertex has the highest rank.
+    uint32_t getRank(size_t v) const { return rank[v]; }
+
+    // f(w, weight) for every arc v -> w with w ranked above v.
+    template <typename F>
+    void forEachUpArc(size_t v, F&& f) const {
+        for (uint64_t i = up.offsets[v]; i < up.offsets[v + 1]; ++i) f(static_cast<size_t>(up.targets[i]), up.weights[i]);
+    }
+
+    // f(u, weight) for every arc u -> v with u ranked above v.
+    template <typename F>
+    void forEachDownArc(size_t v, F&& f) const {
+        for (uint64_t i = down.offsets[v]; i < down.offsets[v + 1]; ++i) f(static_cast<size_t>(down.targets[i]), down.weights[i]);
+    }
+
+    // Appends the vertices of the original path behind hierarchy arc u -> v, without u, to path.
+    void unpackArc(size_t u, size_t v, myVector<int>& path) const;
+
+private:
+    struct ArcList {
+        myVector<uint64_t> offsets;
+        myVector<uint32_t> targets;
+        myVector<D> weights;
+        myVector<int32_t> middles;
+    };
+
+    bool directed;
+    size_t numShortcuts;
+    myVector<uint32_t> rank;
+    ArcList up;
+    ArcList down;
+
+    // Index of the arc to target in the row of v, which holds it.
+    static uint64_t findArc(const ArcList& arcs, size_t v, size_t target);
+};
+
+typedef BasicContractionHierarchy<int, int> ContractionHierarchy;
+
+// Query engine for a hierarchy: an upward search from the source and one from the target over down arcs,
+// meeting at the highest-ranked vertex of the path. A vertex is stalled, and its arcs skipped, when an arc
+// from a higher-ranked vertex already labelled by the same search shows its label is not a shortest distance.
+// The labels live in the engine and are reset only where touched, so one engine should serve many queries;
+// use one engine per thread.
+template <typename W, typename D = W>
+class BasicChQuery {
+public:
+    typedef BasicHeapNode<D> Node;
+    typedef BasicPathResult<D> PathResult;
+
+    explicit BasicChQuery(const BasicContractionHierarchy<W, D>& hierarchy, int d = 4);
+
+    BasicChQuery(const BasicChQuery&) = delete;
+    BasicChQuery& operator=(const BasicChQuery&) = delete;
+
+    PathResult shortestPath(int source, int target);
+
+    // Same search without unpacking the path; WeightTraits<D>::unreachable() when there is none.
+    D distance(int source, int target);
+
+    // Vertices settled by the last query in both directions together, stalled ones included.
+    size_t getLastSettledCount() const { return lastSettled; }
+
+private:
+    const BasicContractionHierarchy<W, D>& hierarchy;
+    DHeap<Node> forwardQueue;
+    DHeap<Node> backwardQueue;
+    myVector<D> forwardDist;
+    myVector<D> backwardDist;
+    myVector<int> forwardParent;
+    myVector<int> backwardParent;
+    myVector<uint32_t> touched;
+    size_t lastSettled;
+
+    void checkVertices(int source, int target) const;
+    int search(int source, int target, D& best);
+    void reset();
+};
+
+typedef BasicChQuery<int, int> ChQuery;
@@ -0,0 +1,29 @@
+#pragma once
+#include <stdexcept>
+#include "myvector.h"
+
+// Optional per-vertex positions: planar x/y, or longitude/latitude in degrees for geographic graphs.
+// Kept outside the graph classes so every backend can share one table indexed by original vertex id.
+class VertexCoordinates {
+private:
+    myVector<double> xs;
+    myVector<double> ys;
+
+public:
+    explicit VertexCoordinates(size_t vertices) : xs(vertices, 0.0), ys(vertices, 0.0) {}
+
+    size_t size() const { return xs.size(); }
+
+    void set(size_t v, double x, double y) {
+        if (v >= xs.size()) {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        xs[v] = x;
+        ys[v] = y;
+    }
+
+    double getX(size_t v) const { return xs[v]; }
+    double getY(size_t v) const { return ys[v]; }
+    const myVector<double>& getAllX() const { return xs; }
+    const myVector<double>& getAllY() const { return ys; }
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+// Vector instruction sets the kernels can be compiled for. The kernels are built with per-function target
+// attributes, so the binary runs anywhere and the widest supported kernel is picked at run time.
+enum SimdLevel { SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512 };
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define SIMD_X86 1
+#define SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX512
+#else
+#define SIMD_X86 0
+#endif
+
+// Widest level both compiled in and supported by the processor and operating system; detected once.
+SimdLevel detectSimdLevel();
+
+// The requested level, lowered to what detectSimdLevel() allows.
+inline SimdLevel supportedSimdLevel(SimdLevel requested) {
+    const SimdLevel available = detectSimdLevel();
+    return requested < available ? requested : available;
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "graph.h"
+
+template <typename W>
+class BasicCsrGraph;
+
+template <typename W>
+class BasicDynamicGraph;
+
+// Defined in graphFile.cpp; maps the file and points the graph at the mapped pages.
+template <typename W = int>
+BasicCsrGraph<W> loadGraphFile(const std::string& path);
+
+template <typename W>
+class BasicCsrGraph {
+private:
+    struct Storage {
+        myVector<uint64_t> offsets;
+        myVector<uint32_t> targets;
+        myVector<W> weights;
+        myVector<uint64_t> reverseOffsets;
+        myVector<uint32_t> reverseTargets;
+        myVector<W> reverseWeights;
+    };
+
+    size_t numVertices;
+    bool directed;
+    size_t numArcs;
+    const uint64_t* offsets;
+    const uint32_t* targets;
+    const W* weights;
+    const uint64_t* reverseOffsets;
+    const uint32_t* reverseTargets;
+    const W* reverseWeights;
+    std::shared_ptr<const void> owner;
+
+    template <typename T>
+    friend class BasicCsrGraphBuilder;
+    template <typename T>
+    friend BasicCsrGraph<T> loadGraphFile(const std::string& path);
+    friend class BasicDynamicGraph<W>;
+    BasicCsrGraph(size_t vertices, bool directed, std::shared_ptr<const Storage> storage);
+    BasicCsrGraph(size_t vertices, bool directed, size_t arcs, std::shared_ptr<const void> owner);
+
+    // Copies any graph exposing forEachNeighbor/forEachInNeighbor with rows already sorted by target.
+    template <typename G>
+    static std::shared_ptr<const Storage> storageFrom(const G& graph) {
+        const size_t n = graph.getNumVertices();
+        auto storage = std::make_shared<Storage>();
+        storage->offsets.resize(n + 1, 0);
+        for (size_t u = 0; u < n; ++u) {
+            graph.forEachNeighbor(u, [&](size_t v, W weight) {
+                storage->targets.push_back(static_cast<uint32_t>(v));
+                storage->weights.push_back(weight);
+            });
+            storage->offsets[u + 1] = storage->targets.size();
+        }
+
+        if (graph.isDirected()) {
+            storage->reverseOffsets.resize(n + 1, 0);
+            for (size_t v = 0; v < n; ++v) {
+                graph.forEachInNeighbor(v, [&](size_t u, W weight) {
+                    storage->reverseTargets.push_back(static_cast<uint32_t>(u));
+                    storage->reverseWeights.push_back(weight);
+                });
+                storage->reverseOffsets[v + 1] = storage->reverseTargets.size();
+            }
+        }
+
+        return storage;
+    }
+
+public:
+    typedef W WeightType;
+
+    explicit BasicCsrGraph(const BasicGraph<W>& dense);
+
+    bool isConnected() const;
+    void printGraph() const;
+
+    size_t getNumVertices() const { return numVertices; }
+    bool isDirected() const { return directed; }
+    size_t getNumArcs() const { return numArcs; }
+    size_t getDegree(size_t u) const { return static_cast<size_t>(offsets[u + 1] - offsets[u]); }
+    size_t getInDegree(size_t v) const;
+    W getEdgeWeight(size_t u, size_t v) const;
+    const uint64_t* getOffsets() const { return offsets; }
+    const uint32_t* getTargets() const { return targets; }
+    const W* getWeights() const { return weights; }
+    const uint64_t* getReverseOffsets() const { return directed ? reverseOffsets : offsets; }
+    const uint32_t* getReverseTargets() const { return directed ? reverseTargets : targets; }
+    const W* getReverseWeights() const { return directed ? reverseWeights : weights; }
+    myVector<int> getPath(int start, int end, const myVector<int>& predecessors) const;
+
+    template <typename F>
+    void forEachNeighbor(size_t u, F&& f) const {
+        const uint64_t end = offsets[u + 1];
+        for (uint64_t i = offsets[u]; i < end; ++i) {
+            f(static_cast<size_t>(targets[i]), weights[i]);
+        }
+    }
+
+    // An undirected graph is its own transpose, so only directed graphs keep reverse arrays.
+    template <typename F>
+    void forEachInNeighbor(size_t v, F&& f) const {
+        if (!directed) {
+            forEachNeighbor(v, f);
+            return;
+        }
+        const uint64_t end = reverseOffsets[v + 1];
+        for (uint64_t i = reverseOffsets[v]; i < end; ++i) {
+            f(static_cast<size_t>(reverseTargets[i]), reverseWeights[i]);
+        }
+    }
+};
+
+typedef BasicCsrGraph<int> CsrGraph;
+
+template <typename W>
+class BasicCsrGraphBuilder {
+private:
+    struct Edge {
+        uint32_t u;
+        uint32_t v;
+        W weight;
+    };
+
+    size_t numVertices;
+    bool directed;
+    myVector<Edge> edges;
+
+    void buildAdjacency(bool forward, bool backward, size_t threads, myVector<uint64_t>& offsets,
+        myVector<uint32_t>& targets, myVector<W>& weights) const;
+
+public:
+    explicit BasicCsrGraphBuilder(size_t vertices, bool directed = false);
+
+    void reserve(size_t edgeCount) { edges.reserve(edgeCount); }
+    // Self-loops throw std::invalid_argument; the importers drop the ones real data sets contain.
+    void addEdge(size_t u, size_t v, W weight);
+    size_t getNumEdges() const { return edges.size(); }
+
+    // Neighbor lists come out sorted by target; parallel edges collapse to the lightest one.
+    // Rows are sorted on the given number of threads (0 picks the hardware concurrency).
+    BasicCsrGraph<W> build(size_t threads = 1);
+};
+
+typedef BasicCsrGraphBuilder<int> CsrGraphBuilder;
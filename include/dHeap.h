@@ -62,6 +62,7 @@ public:
 
     bool empty() const { return data.empty(); }
     size_t size() const { return data.size(); }
+    void clear() { data.clear(); }
     int getArity() const { return d; }
 
     void setArity(int newD) {
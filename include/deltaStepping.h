@@ -0,0 +1,50 @@
+#pragma once
+#include "dijkstra.h"
+
+// Parallel one-to-all shortest paths by delta-stepping. Tentative distances sit in buckets of width delta;
+// a bucket is emptied in phases that relax its light arcs (weight <= delta) until nothing falls back into it,
+// then the heavy arcs of every vertex it held are relaxed once. Each thread owns a slice of the vertices and
+// alone updates their distances, predecessors and buckets: relaxations of arcs into another thread's slice go
+// to a per-thread buffer that the owner drains after a barrier, so the hot loops need no atomics.
+template <typename W, typename D = W>
+class BasicDeltaStepping {
+    static_assert(DistanceCompatible<D, W>::value, "Distance type must be able to hold any edge weight");
+
+public:
+    // Scans the arcs to pick the default delta, again before any query after the graph changed (see
+    // BasicGraphRef::getVersion); threads = 0 uses every hardware thread.
+    explicit BasicDeltaStepping(BasicGraphRef<W> graph, size_t threads = 0);
+
+    BasicDeltaStepping(const BasicDeltaStepping&) = delete;
+    BasicDeltaStepping& operator=(const BasicDeltaStepping&) = delete;
+
+    // Same output as BasicDijkstra::shortestPathsWithPredecessors; among equally short paths the
+    // predecessor chosen may differ. A delta of zero uses getDefaultDelta().
+    myVector<D> shortestPathsWithPredecessors(int start, myVector<int>& predecessors, D delta = D());
+
+    // Largest arc weight over the average out-degree, the choice that keeps light phases short on
+    // graphs with spread-out weights while leaving few buckets to walk through.
+    D getDefaultDelta() const {
+        refreshWeights();
+        return defaultDelta;
+    }
+    size_t getThreadCount() const { return threads; }
+
+private:
+    BasicGraphRef<W> graph;
+    size_t threads;
+    // The bucket array is sized from the largest weight, so these follow the graph's version.
+    mutable W maxWeight;
+    mutable D defaultDelta;
+    mutable uint64_t weightVersion;
+
+    void scanWeights() const;
+    void refreshWeights() const {
+        if (graph.getVersion() != weightVersion) scanWeights();
+    }
+
+    template <typename G>
+    void run(const G& g, int start, D delta, myVector<D>& dist, myVector<int>& predecessors) const;
+};
+
+typedef BasicDeltaStepping<int, int> DeltaStepping;
@@ -0,0 +1,29 @@
+#pragma once
+#include "graph.h"
+#include "cpuFeatures.h"
+
+// Vector kernels for searches over a distance array and adjacency-matrix rows, as in the array-based Dijkstra
+// for dense graphs: settled vertices are bits in a bitset and are skipped by both kernels. Distances of
+// int, int64_t, float or double are scanned with AVX-512, AVX2 or scalar code as the processor allows; rows are
+// vectorised when the weight type is the distance type and otherwise relaxed by the scalar loop.
+template <typename W, typename D = W>
+class BasicDenseScan {
+public:
+    explicit BasicDenseScan(SimdLevel simd = SIMD_AVX512);
+
+    // Unsettled vertex in [0, n) of least finite distance, or -1 when none is left.
+    int selectMin(const D* dist, const uint64_t* settled, size_t n) const;
+
+    // For every arc u -> v to an unsettled v, lowers dist[v] to du + weight and sets predecessors[v] = u when
+    // that is shorter. improved, when given, receives one bit per vertex set exactly for the lowered ones.
+    // Throws std::overflow_error as addDistance does.
+    void relaxRow(const BasicGraph<W>& graph, size_t u, D du, const uint64_t* settled, D* dist, int* predecessors,
+        uint64_t* improved) const;
+
+    SimdLevel getSimdLevel() const { return simd; }
+
+private:
+    SimdLevel simd;
+};
+
+typedef BasicDenseScan<int, int> DenseScan;
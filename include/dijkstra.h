@@ -1,61 +1,276 @@
 #pragma once
-#include "graph.h"
+#include "graphRef.h"
+#include "reverseView.h"
 #include "dHeap.h"
 #include "binomialHeap.h"  
+#include "bucketQueue.h"
+#include "denseScan.h"
 
-struct HeapNode {
+template <typename D>
+struct BasicHeapNode {
     int vertex;
-    int distance;
+    D distance;
 
-    bool operator<(const HeapNode& other) const {
+    bool operator<(const BasicHeapNode& other) const {
         return distance < other.distance;
     }
 
-    bool operator>(const HeapNode& other) const {
+    bool operator>(const BasicHeapNode& other) const {
         return distance > other.distance;
     }
 };
 
-class Dijkstra {
+typedef BasicHeapNode<int> HeapNode;
+
+// distance is the unreachable value and path is empty when the target cannot be reached.
+template <typename D>
+struct BasicPathResult {
+    D distance;
+    myVector<int> path;
+};
+
+template <typename W, typename D>
+class BasicDijkstra;
+
+// Scratch state for repeated point-to-point queries on one graph. Each entry carries the number of the query
+// that wrote it, so starting a query only bumps that number instead of refilling arrays of size V, and the heap
+// keeps its capacity. A workspace serves one query at a time; give each thread its own.
+template <typename D>
+class BasicDijkstraWorkspace {
 public:
-    enum HeapType { D_HEAP, BINOMIAL_HEAP };  
+    explicit BasicDijkstraWorkspace(size_t numVertices, int d = 4)
+        : dist(numVertices), predecessors(numVertices), stamps(numVertices, 0), epoch(0), heap(d), settledCount(0) {
+    }
+
+    BasicDijkstraWorkspace(const BasicDijkstraWorkspace&) = delete;
+    BasicDijkstraWorkspace& operator=(const BasicDijkstraWorkspace&) = delete;
+
+    size_t getNumVertices() const { return stamps.size(); }
+    // Vertices settled by the last query, the measure of its work.
+    size_t getLastSettledCount() const { return settledCount; }
+
+private:
+    template <typename, typename>
+    friend class BasicDijkstra;
+
+    myVector<D> dist;
+    myVector<int> predecessors;
+    // epoch marks a vertex reached by the current query, epoch + 1 a settled one; anything older is stale.
+    myVector<uint32_t> stamps;
+    uint32_t epoch;
+    DHeap<BasicHeapNode<D>> heap;
+    size_t settledCount;
+
+    void reset() {
+        heap.clear();
+        settledCount = 0;
+        epoch += 2;
+        if (epoch == 0) {
+            for (size_t v = 0; v < stamps.size(); ++v) stamps[v] = 0;
+            epoch = 2;
+        }
+    }
+
+    bool isReached(size_t v) const { return stamps[v] >= epoch; }
+    bool isSettled(size_t v) const { return stamps[v] == epoch + 1; }
+};
 
-    explicit Dijkstra(const Graph& graph) : graph(graph) {
+typedef BasicDijkstraWorkspace<int> DijkstraWorkspace;
+
+// W is the edge weight type, D the type distances are accumulated in.
+// A path longer than D can represent throws std::overflow_error instead of wrapping around.
+template <typename W, typename D = W>
+class BasicDijkstra {
+    static_assert(DistanceCompatible<D, W>::value, "Distance type must be able to hold any edge weight");
+
+public:
+    // DIAL_BUCKETS needs integer distances and keeps one bucket per unit of the largest edge weight;
+    // AUTO takes it when that weight is at most autoBucketLimit and falls back to the d-heap otherwise.
+    // DENSE_SCAN uses no queue: each step scans the distance array for the closest unsettled vertex, O(V^2) in
+    // all, which beats a queue once E nears V^2. AUTO takes it on an adjacency-matrix Graph with at least
+    // V^2 / autoDenseDivisor arcs when the AVX-512 kernels run, and at least V^2 / 2 otherwise.
+    enum HeapType { D_HEAP, BINOMIAL_HEAP, DIAL_BUCKETS, AUTO, DENSE_SCAN };  
+    static const uint64_t autoBucketLimit = 4096;
+    static const size_t autoDenseDivisor = 32;
+
+    typedef BasicHeapNode<D> Node;
+    typedef BasicPathResult<D> PathResult;
+    typedef BasicDijkstraWorkspace<D> Workspace;
+
+    // Accepts any backend (see graphRef.h); a reordered graph keeps original ids in arguments and results.
+    // Scans the arcs for the largest weight, which sizes the bucket queue; queries rescan only after the graph
+    // has changed (see BasicGraphRef::getVersion).
+    explicit BasicDijkstra(BasicGraphRef<W> graph) : graph(graph), denseScan(), maxWeight(W()), weightVersion(0), lastSettled(0) {
         if (graph.getNumVertices() == 0) {
             throw std::invalid_argument("Graph cannot be empty");
         }
+        scanMaxWeight();
     }
-    ~Dijkstra() = default;
+    ~BasicDijkstra() = default;
 
-    Dijkstra(const Dijkstra&) = delete;
-    Dijkstra& operator=(const Dijkstra&) = delete;
+    BasicDijkstra(const BasicDijkstra&) = delete;
+    BasicDijkstra& operator=(const BasicDijkstra&) = delete;
 
-    myVector<int> shortestPathsWithPredecessors(int start, HeapType heapType, myVector<int>& predecessors, int d);
-    void printResults(int start, const myVector<int>& dist) const;
+    myVector<D> shortestPathsWithPredecessors(int start, HeapType heapType, myVector<int>& predecessors, int d);
+    myVector<D> shortestPathsToTarget(int target, HeapType heapType, myVector<int>& successors, int d);
+    // One search from all sources at once: every vertex gets its distance to the nearest source and, in owners,
+    // the index in sources of that source (-1 if none reaches it), which partitions the graph into Voronoi cells.
+    // Sources may start at a non-negative offset, as if each had an extra arc of that length; a vertex listed
+    // twice keeps its smallest offset.
+    myVector<D> shortestPathsFromSources(const myVector<int>& sources, HeapType heapType, myVector<int>& owners, myVector<int>& predecessors, int d);
+    myVector<D> shortestPathsFromSources(const myVector<int>& sources, const myVector<D>& offsets, HeapType heapType,
+        myVector<int>& owners, myVector<int>& predecessors, int d);
+    // Stops as soon as the target is settled, so only the part of the graph closer than the target is explored.
+    PathResult shortestPath(int source, int target, HeapType heapType, int d);
+    // Same searches on a reused workspace, so the cost follows the vertices a query touches rather than V.
+    // The workspace must be sized for this graph; the d-heap arity is the workspace's.
+    PathResult shortestPath(int source, int target, Workspace& workspace);
+    D distance(int source, int target, Workspace& workspace);
+    // All distances from source, written to distances[0, V) by original id. Only reads the engine, so several
+    // threads may call it at once, each with its own workspace.
+    void distancesInto(int source, Workspace& workspace, D* distances) const;
+    void printResults(int start, const myVector<D>& dist) const;
+    // Vertices settled by the last search run without a workspace.
+    size_t getLastSettledCount() const { return lastSettled; }
 
 private:
-    const Graph& graph;
+    BasicGraphRef<W> graph;
+    BasicDenseScan<W, D> denseScan;
+    W maxWeight;
+    uint64_t weightVersion;
+    size_t lastSettled;
+
+    void scanMaxWeight() {
+        const size_t n = graph.getNumVertices();
+        maxWeight = W();
+        graph.visit([&](const auto& g) {
+            for (size_t u = 0; u < n; ++u) {
+                g.forEachNeighbor(u, [&](size_t, W weight) {
+                    if (weight > maxWeight) maxWeight = weight;
+                });
+            }
+        });
+        weightVersion = graph.getVersion();
+    }
+
+    template <typename F>
+    auto visitGraph(F&& f) const {
+        return graph.visit(f);
+    }
+
+    template <typename Search>
+    myVector<D> inOriginalIds(int vertex, myVector<int>& links, Search&& search) {
+        const BasicReorderedGraph<W>* reordered = graph.getReordering();
+        if (!reordered) return search(vertex, links);
+        if (vertex < 0 || vertex >= static_cast<int>(reordered->getNumVertices())) {
+            throw std::out_of_range("Start vertex out of range");
+        }
+        myVector<int> internalLinks;
+        myVector<D> dist = search(reordered->toInternal(vertex), internalLinks);
+        links = reordered->verticesToOriginal(internalLinks);
+        return reordered->valuesToOriginal(dist);
+    }
+
+    // A target of -1 settles every reachable vertex.
+    template <typename G>
+    myVector<D> run(const G& g, int start, HeapType heapType, myVector<int>& predecessors, int d, int target = -1);
+    // Seeds are vertices with their starting distances, in internal ids.
+    template <typename G>
+    myVector<D> runFromSeeds(const G& g, myVector<Node> seeds, HeapType heapType, myVector<int>& predecessors, int d, int target);
 
+    // Leaves the result in the workspace, in internal ids.
+    template <typename G>
+    void runInWorkspace(const G& g, int start, int target, Workspace& workspace) const;
+
+    void checkQuery(int source, int target, const Workspace& workspace) const;
+
+    bool prefersDenseScan(const BasicGraph<W>& g) const {
+        const uint64_t n = g.getNumVertices();
+        const uint64_t divisor = denseScan.getSimdLevel() == SIMD_AVX512 ? autoDenseDivisor : 2;
+        return static_cast<uint64_t>(g.getNumArcs()) * divisor >= n * n;
+    }
+
+    template <typename G>
+    bool prefersDenseScan(const G&) const {
+        return false;
+    }
+
+    // The matrix rows go through the vector kernel; other backends relax their arcs one by one.
+    void relaxUnsettled(const BasicGraph<W>& g, int u, const myVector<uint64_t>& settled, myVector<D>& dist, myVector<int>& predecessors) const {
+        denseScan.relaxRow(g, static_cast<size_t>(u), dist[u], settled.data(), dist.data(), predecessors.data(), nullptr);
+    }
+
+    template <typename G>
+    void relaxUnsettled(const G& g, int u, const myVector<uint64_t>& settled, myVector<D>& dist, myVector<int>& predecessors) const {
+        g.forEachNeighbor(static_cast<size_t>(u), [&](size_t v, W weight) {
+            if ((settled[v >> 6] >> (v & 63)) & 1) return;
+            const D candidate = addDistance(dist[u], weight);
+            if (candidate < dist[v]) {
+                dist[v] = candidate;
+                predecessors[v] = u;
+            }
+        });
+    }
+
+    template <typename G>
+    void processDenseScan(const G& g, myVector<D>& dist, myVector<bool>& visited, myVector<int>& predecessors, int target) const {
+        const size_t n = g.getNumVertices();
+        myVector<uint64_t> settled((n + 63) / 64, 0);
+        for (;;) {
+            const int u = denseScan.selectMin(dist.data(), settled.data(), n);
+            if (u < 0) break;
+            settled[u >> 6] |= static_cast<uint64_t>(1) << (u & 63);
+            visited[u] = true;
+            if (u == target) break;
+            relaxUnsettled(g, u, settled, dist, predecessors);
+        }
+    }
+
+    // Adjacency-matrix rows are relaxed by the vector kernel, and only the vertices it lowered are pushed.
     template <typename Heap>
-    void processQueueWithPredecessors(Heap& pq, myVector<int>& dist, myVector<bool>& visited, myVector<int>& predecessors) {
+    void processQueueWithPredecessors(const BasicGraph<W>& g, Heap& pq, myVector<D>& dist, myVector<bool>& visited, myVector<int>& predecessors, int target) {
+        const size_t words = (g.getNumVertices() + 63) / 64;
+        myVector<uint64_t> settled(words, 0);
+        myVector<uint64_t> improved(words, 0);
+        while (!pq.empty()) {
+            Node current = pq.top();
+            pq.pop();
+            int u = current.vertex;
+
+            if (visited[u]) continue;
+            visited[u] = true;
+            settled[u >> 6] |= static_cast<uint64_t>(1) << (u & 63);
+            if (u == target) break;
+
+            denseScan.relaxRow(g, static_cast<size_t>(u), dist[u], settled.data(), dist.data(), predecessors.data(), improved.data());
+            forEachSetBit(improved.data(), words, [&](size_t v) { pq.push({ static_cast<int>(v), dist[v] }); });
+        }
+    }
+
+    template <typename Heap, typename G>
+    void processQueueWithPredecessors(const G& g, Heap& pq, myVector<D>& dist, myVector<bool>& visited, myVector<int>& predecessors, int target) {
         while (!pq.empty()) {
-            HeapNode current = pq.top();
+            Node current = pq.top();
             pq.pop();
             int u = current.vertex;
 
             if (visited[u]) continue;
             visited[u] = true;
+            if (u == target) break;
 
-            for (int v = 0; v < graph.getNumVertices(); ++v) {
-                int weight = graph.getAdjacencyMatrix()[u][v];
-                if (weight != -1 && !visited[v]) {
-                    if (dist[v] == -1 || dist[u] + weight < dist[v]) {
-                        dist[v] = dist[u] + weight;
+            g.forEachNeighbor(u, [&](size_t neighbor, W weight) {
+                int v = static_cast<int>(neighbor);
+                if (!visited[v]) {
+                    const D candidate = addDistance(dist[u], weight);
+                    if (candidate < dist[v]) {
+                        dist[v] = candidate;
                         predecessors[v] = u;
-                        pq.push({ v, dist[v] });
+                        pq.push({ v, candidate });
                     }
                 }
-            }
+            });
         }
     }
-};
\ No newline at end of file
+};
+
+typedef BasicDijkstra<int, int> Dijkstra;
@@ -0,0 +1,45 @@
+#pragma once
+#include "contractionHierarchy.h"
+
+// Many-to-many distances over a contraction hierarchy by the bucket method: an upward search over down arcs
+// from every target leaves (target, distance) entries in the buckets of the vertices it settles, then an
+// upward search from every source scans the buckets of the vertices it settles, so each cell of the table is
+// the best meeting of two small searches instead of a full one-to-all run. Both phases run in parallel, one
+// search per target or source, with a search state per thread.
+template <typename W, typename D = W>
+class BasicDistanceTable {
+public:
+    explicit BasicDistanceTable(const BasicContractionHierarchy<W, D>& hierarchy, size_t threads = 0);
+
+    BasicDistanceTable(const BasicDistanceTable&) = delete;
+    BasicDistanceTable& operator=(const BasicDistanceTable&) = delete;
+
+    // Writes the row-major sources.size() x targets.size() table to table, which must hold that many
+    // values; WeightTraits<D>::unreachable() marks pairs with no path. One call at a time per object.
+    void compute(const myVector<int>& sources, const myVector<int>& targets, D* table);
+    myVector<D> compute(const myVector<int>& sources, const myVector<int>& targets);
+
+    size_t getThreadCount() const { return threads; }
+    // Bucket entries left by the targets of the last call, the memory the method needs besides the table.
+    size_t getLastBucketEntries() const { return lastEntries; }
+
+private:
+    struct Entry {
+        uint32_t vertex;
+        uint32_t target;
+        D distance;
+
+        bool operator<(const Entry& other) const {
+            return vertex != other.vertex ? vertex < other.vertex : target < other.target;
+        }
+    };
+
+    const BasicContractionHierarchy<W, D>& hierarchy;
+    size_t threads;
+    // Range of the sorted entries held by each vertex; empty except during a call.
+    myVector<uint64_t> bucketBegin;
+    myVector<uint64_t> bucketEnd;
+    size_t lastEntries;
+};
+
+typedef BasicDistanceTable<int, int> DistanceTable;
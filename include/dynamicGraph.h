@@ -0,0 +1,160 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "csrGraph.h"
+
+template <typename W>
+struct BasicEdgeUpdate {
+    enum Kind { INSERT, REMOVE, REWEIGHT };
+
+    Kind kind;
+    size_t u;
+    size_t v;
+    W weight;
+};
+
+typedef BasicEdgeUpdate<int> EdgeUpdate;
+
+// Per-vertex arcs that override the base CSR rows, sorted by vertex and then by target.
+// A removed arc stays as a tombstone so that it hides the base arc with the same target.
+template <typename W>
+struct BasicDeltaOverlay {
+    struct Arc {
+        uint32_t target;
+        W weight;
+        bool removed;
+    };
+
+    myVector<uint32_t> vertices;
+    myVector<uint64_t> offsets;
+    myVector<Arc> arcs;
+
+    BasicDeltaOverlay() : offsets(1, 0) {}
+
+    size_t find(size_t u, const Arc*& first) const {
+        const uint32_t* begin = vertices.data();
+        const uint32_t* end = begin + vertices.size();
+        const uint32_t* it = std::lower_bound(begin, end, static_cast<uint32_t>(u));
+        if (it == end || *it != u) return 0;
+        const size_t index = static_cast<size_t>(it - begin);
+        first = arcs.data() + offsets[index];
+        return static_cast<size_t>(offsets[index + 1] - offsets[index]);
+    }
+};
+
+// An immutable view of a dynamic graph at one point in time. Queries keep reading the
+// snapshot they started on while new batches and compactions publish later ones.
+template <typename W>
+class BasicGraphSnapshot {
+private:
+    typedef BasicDeltaOverlay<W> Overlay;
+
+    std::shared_ptr<const BasicCsrGraph<W>> base;
+    std::shared_ptr<const Overlay> forward;
+    std::shared_ptr<const Overlay> backward;
+
+    friend class BasicDynamicGraph<W>;
+
+    BasicGraphSnapshot(std::shared_ptr<const BasicCsrGraph<W>> base, std::shared_ptr<const Overlay> forward,
+        std::shared_ptr<const Overlay> backward)
+        : base(std::move(base)), forward(std::move(forward)), backward(std::move(backward)) {
+    }
+
+    // Merges a sorted base row with its sorted overlay arcs, so rows stay sorted by target.
+    template <typename F>
+    static void forEachMerged(const uint64_t* offsets, const uint32_t* targets, const W* weights,
+        const Overlay& overlay, size_t u, F& f) {
+        const typename Overlay::Arc* arc = nullptr;
+        const size_t count = overlay.find(u, arc);
+        uint64_t i = offsets[u];
+        const uint64_t end = offsets[u + 1];
+        if (count == 0) {
+            for (; i < end; ++i) f(static_cast<size_t>(targets[i]), weights[i]);
+            return;
+        }
+        const typename Overlay::Arc* last = arc + count;
+        while (i < end || arc != last) {
+            if (arc == last || (i < end && targets[i] < arc->target)) {
+                f(static_cast<size_t>(targets[i]), weights[i]);
+                ++i;
+                continue;
+            }
+            if (i < end && targets[i] == arc->target) ++i;
+            if (!arc->removed) f(static_cast<size_t>(arc->target), arc->weight);
+            ++arc;
+        }
+    }
+
+public:
+    typedef W WeightType;
+
+    size_t getNumVertices() const { return base->getNumVertices(); }
+    bool isDirected() const { return base->isDirected(); }
+    const BasicCsrGraph<W>& getBase() const { return *base; }
+    size_t getOverlaySize() const { return forward->arcs.size() + (isDirected() ? backward->arcs.size() : 0); }
+    W getEdgeWeight(size_t u, size_t v) const;
+
+    template <typename F>
+    void forEachNeighbor(size_t u, F&& f) const {
+        forEachMerged(base->getOffsets(), base->getTargets(), base->getWeights(), *forward, u, f);
+    }
+
+    template <typename F>
+    void forEachInNeighbor(size_t v, F&& f) const {
+        forEachMerged(base->getReverseOffsets(), base->getReverseTargets(), base->getReverseWeights(), *backward, v, f);
+    }
+};
+
+typedef BasicGraphSnapshot<int> GraphSnapshot;
+
+// A CSR graph that accepts batches of edge insertions, removals and reweights.
+// Batches land in a delta overlay; once it grows past the compaction threshold a background
+// thread folds it into a fresh CSR base while updates and queries keep going.
+template <typename W>
+class BasicDynamicGraph {
+public:
+    typedef BasicEdgeUpdate<W> Update;
+    typedef BasicGraphSnapshot<W> Snapshot;
+
+    // A threshold of 0 picks an eighth of the base arcs, but no less than 4096 overlay arcs.
+    explicit BasicDynamicGraph(const BasicCsrGraph<W>& base, size_t compactionThreshold = 0);
+    ~BasicDynamicGraph();
+
+    BasicDynamicGraph(const BasicDynamicGraph&) = delete;
+    BasicDynamicGraph& operator=(const BasicDynamicGraph&) = delete;
+
+    // The whole batch is validated before any of it becomes visible; a failing batch changes nothing.
+    void applyBatch(const myVector<Update>& updates);
+    Snapshot snapshot() const;
+
+    size_t getNumVertices() const { return numVertices; }
+    bool isDirected() const { return directed; }
+    size_t getOverlaySize() const { return snapshot().getOverlaySize(); }
+    bool isCompacting() const;
+
+    void compact();
+    void waitForCompaction();
+
+private:
+    typedef BasicDeltaOverlay<W> Overlay;
+
+    size_t numVertices;
+    bool directed;
+    size_t threshold;
+    mutable std::mutex stateMutex;
+    mutable std::mutex writeMutex;
+    Snapshot current;
+    bool compacting;
+    myVector<myVector<Update>> pending;
+    std::thread worker;
+
+    static Snapshot withBatch(const Snapshot& state, const myVector<Update>& updates);
+    static Snapshot rebuilt(const Snapshot& state);
+    void publish(const Snapshot& next);
+    void compactionTask(Snapshot source);
+};
+
+typedef BasicDynamicGraph<int> DynamicGraph;
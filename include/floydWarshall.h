@@ -0,0 +1,38 @@
+#pragma once
+#include "graph.h"
+#include "cpuFeatures.h"
+
+// All-pairs shortest paths on dense graphs by blocked Floyd-Warshall. The matrix is cut into square tiles;
+// round k first closes the diagonal tile k, then the tiles in row and column k against it, then every other
+// tile against those, each phase spread over the threads since its tiles are independent. The inner loop is a
+// min-plus update of one row segment, run with AVX-512, AVX2 or scalar code as the processor allows.
+template <typename W, typename D = W>
+class BasicFloydWarshall {
+    static_assert(DistanceCompatible<D, W>::value, "Distance type must be able to hold any edge weight");
+
+public:
+    // threads = 0 uses every hardware thread; simd is lowered to what the processor supports.
+    explicit BasicFloydWarshall(size_t threads = 0, SimdLevel simd = SIMD_AVX512, size_t tileSize = 64);
+
+    // Fills distances, and predecessors when given, as V x V matrices: distances[u][v] is the shortest
+    // distance or WeightTraits<D>::unreachable(), predecessors[u][v] the vertex before v on such a path
+    // (-1 when v == u or v is out of reach), so row u works as the predecessor array of a search from u.
+    void run(const BasicGraph<W>& graph, AlignedMatrix<D>& distances, AlignedMatrix<int>* predecessors = nullptr) const;
+
+    // Same on a square matrix of arc lengths, WeightTraits<D>::unreachable() for missing arcs, replaced by
+    // the distances. The diagonal is taken as zero.
+    void runInPlace(AlignedMatrix<D>& distances, AlignedMatrix<int>* predecessors = nullptr) const;
+
+    SimdLevel getSimdLevel() const { return simd; }
+    size_t getThreadCount() const { return threads; }
+    size_t getTileSize() const { return tileSize; }
+
+private:
+    size_t threads;
+    SimdLevel simd;
+    size_t tileSize;
+
+    void solve(AlignedMatrix<D>& distances, AlignedMatrix<int>* predecessors, D maxArc) const;
+};
+
+typedef BasicFloydWarshall<int, int> FloydWarshall;
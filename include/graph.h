@@ -1,20 +1,74 @@
 #pragma once
 #include "stack.h"
+#include "alignedMatrix.h"
+#include "bitOps.h"
+#include "weightTraits.h"
 
-class Graph {
+myVector<int> reconstructPath(int start, int end, const myVector<int>& predecessors);
+
+template <typename W>
+class BasicGraph {
 private:
     size_t numVertices;
-    myVector<myVector<int>> adjacencyMatrix;
+    bool directed;
+    AlignedMatrix<W> adjacencyMatrix;
+    // One bit per arc, so edge discovery reads V/64 words per row instead of V weights.
+    // Directed graphs also keep the transposed bits for in-neighbor scans.
+    AlignedMatrix<uint64_t> edgeBits;
+    AlignedMatrix<uint64_t> inEdgeBits;
+    size_t numArcs;
+    // Bumped by every change to the arcs, so engines holding a reference can tell when facts they cached are stale.
+    uint64_t version;
+
+    void setArc(size_t u, size_t v, bool present) {
+        const uint64_t mask = static_cast<uint64_t>(1) << (v & 63);
+        if (present) ++numArcs;
+        else --numArcs;
+        if (present) edgeBits[u][v >> 6] |= mask;
+        else edgeBits[u][v >> 6] &= ~mask;
+        if (directed) {
+            const uint64_t inMask = static_cast<uint64_t>(1) << (u & 63);
+            if (present) inEdgeBits[v][u >> 6] |= inMask;
+            else inEdgeBits[v][u >> 6] &= ~inMask;
+        }
+    }
 
 public:
-    explicit Graph(size_t vertices);
+    typedef W WeightType;
+
+    explicit BasicGraph(size_t vertices, bool directed = false);
 
-    void addEdge(size_t u, size_t v, int weight);
+    void addEdge(size_t u, size_t v, W weight);
+    void removeEdge(size_t u, size_t v);
+    void updateEdgeWeight(size_t u, size_t v, W weight);
     bool isConnected() const;
     void printGraph() const;
 
     size_t getNumVertices() const { return numVertices; }
-    int getEdgeWeight(size_t u, size_t v) const;
-    const myVector<myVector<int>>& getAdjacencyMatrix() const { return adjacencyMatrix; }
+    bool isDirected() const { return directed; }
+    // Arcs in both directions for undirected graphs, as in BasicCsrGraph.
+    size_t getNumArcs() const { return numArcs; }
+    uint64_t getVersion() const { return version; }
+    W getEdgeWeight(size_t u, size_t v) const;
+    const AlignedMatrix<W>& getAdjacencyMatrix() const { return adjacencyMatrix; }
+    const AlignedMatrix<uint64_t>& getEdgeBits() const { return edgeBits; }
+    bool hasEdge(size_t u, size_t v) const { return (edgeBits[u][v >> 6] >> (v & 63)) & 1; }
     myVector<int> getPath(int start, int end, const myVector<int>& predecessors) const;
-};
\ No newline at end of file
+
+    template <typename F>
+    void forEachNeighbor(size_t u, F&& f) const {
+        const W* row = adjacencyMatrix[u];
+        forEachSetBit(edgeBits[u], edgeBits.cols(), [&](size_t v) { f(v, row[v]); });
+    }
+
+    template <typename F>
+    void forEachInNeighbor(size_t v, F&& f) const {
+        if (!directed) {
+            forEachNeighbor(v, f);
+            return;
+        }
+        forEachSetBit(inEdgeBits[v], inEdgeBits.cols(), [&](size_t u) { f(u, adjacencyMatrix[u][v]); });
+    }
+};
+
+typedef BasicGraph<int> Graph;
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include "csrGraph.h"
+
+// On-disk layout: this header, then 64-byte aligned sections in native byte order:
+// offsets, targets, weights and, for directed graphs, their reverse counterparts.
+struct GraphFileHeader {
+    static const uint32_t currentVersion = 1;
+    static const uint32_t endianTag = 0x01020304;
+    static const uint32_t directedFlag = 1;
+    // Bits 8-15 of flags hold the WeightKind of the weight sections.
+    static const uint32_t weightKindShift = 8;
+    static const uint32_t weightKindMask = 0xFF00;
+    enum WeightKind { SIGNED_INTEGER, UNSIGNED_INTEGER, FLOATING_POINT };
+    static const size_t sectionAlignment = 64;
+
+    enum Section { OFFSETS, TARGETS, WEIGHTS, REVERSE_OFFSETS, REVERSE_TARGETS, REVERSE_WEIGHTS, SECTION_COUNT };
+
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+    uint32_t flags;
+    uint32_t weightSize;
+    uint64_t numVertices;
+    uint64_t numArcs;
+    uint64_t numReverseArcs;
+    uint64_t sectionOffsets[SECTION_COUNT];
+};
+
+template <typename W>
+void saveGraphFile(const BasicCsrGraph<W>& graph, const std::string& path);
+
+// The weight type must match the one the file was written with.
+template <typename W>
+BasicCsrGraph<W> loadGraphFile(const std::string& path);
+
+// The helpers below are shared by every mapped format (graph, hub label and landmark files), which reuse the
+// flag layout and section alignment of GraphFileHeader.
+
+// WeightKind code of a weight or distance type, stored in bits 8-15 of the flags.
+template <typename T>
+uint32_t weightKind() {
+    if (std::is_floating_point<T>::value) return GraphFileHeader::FLOATING_POINT;
+    return std::is_signed<T>::value ? GraphFileHeader::SIGNED_INTEGER : GraphFileHeader::UNSIGNED_INTEGER;
+}
+
+// One section of a file: count elements of elementBytes bytes each, at data once written or mapped.
+struct FileSection {
+    const void* data;
+    uint64_t count;
+    uint64_t elementBytes;
+};
+
+// Writes the header, then each non-empty section at the next multiple of sectionAlignment. sectionOffsets
+// points into the header and receives the position of each section (0 for empty ones) before it is written.
+void writeSectionedFile(const std::string& path, const void* header, size_t headerSize, uint64_t* sectionOffsets,
+    const FileSection* sections, int count);
+
+// Sets data for every section with a non-zero count; false when one is misaligned or runs past the file.
+// Counts are bounded before any multiplication, so a forged header cannot wrap a section size.
+bool mapSections(const unsigned char* data, uint64_t size, const uint64_t* sectionOffsets, FileSection* sections, int count);
+
+// Whether mapped rows can be trusted: offsets rise from 0 to numEntries and every id names one of numVertices
+// vertices. Loaders check their sections with it, since queries trust these values without bounds checks.
+bool isValidAdjacency(const uint64_t* offsets, const uint32_t* ids, uint64_t numVertices, uint64_t numEntries);
@@ -0,0 +1,23 @@
+#pragma once
+#include <string>
+#include "csrGraph.h"
+#include "coordinates.h"
+
+// Importers parse the file in parallel line-aligned chunks (threads == 0 uses every hardware thread)
+// and feed the edges straight into a CsrGraphBuilder, dropping self-loops. Malformed input throws std::runtime_error.
+
+// DIMACS 9th challenge shortest path format: "p sp n m" header and 1-based "a u v w" arcs.
+template <typename W = int>
+BasicCsrGraph<W> importDimacs(const std::string& path, bool directed = true, size_t threads = 0);
+
+// SNAP edge list: 0-based "u v" or "u v w" lines, '#' comments; unweighted edges get weight 1.
+template <typename W = int>
+BasicCsrGraph<W> importSnapEdgeList(const std::string& path, bool directed = false, size_t threads = 0);
+
+// Matrix Market coordinate matrices; "symmetric" matrices become undirected graphs,
+// real values are rounded for integer weight types and "pattern" entries get weight 1.
+template <typename W = int>
+BasicCsrGraph<W> importMatrixMarket(const std::string& path, size_t threads = 0);
+
+// DIMACS coordinate files that accompany the graphs: "p aux sp co n" header and 1-based "v id x y" lines.
+VertexCoordinates importDimacsCoordinates(const std::string& path);
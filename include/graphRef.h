@@ -0,0 +1,52 @@
+#pragma once
+#include "graph.h"
+#include "csrGraph.h"
+#include "dynamicGraph.h"
+#include "compressedGraph.h"
+#include "reorder.h"
+
+// Non-owning handle to any graph backend. Search engines store one and dispatch once per query
+// through visit(), so the relaxation loops are compiled against the concrete graph type.
+// The constructors are implicit so that every engine accepts every backend.
+template <typename W>
+class BasicGraphRef {
+private:
+    // Exactly one backend pointer is set; reordered additionally maps ids for the CSR backend.
+    const BasicGraph<W>* denseGraph = nullptr;
+    const BasicCsrGraph<W>* csrGraph = nullptr;
+    const BasicGraphSnapshot<W>* snapshotGraph = nullptr;
+    const BasicCompressedGraph<W>* compressedGraph = nullptr;
+    const BasicReorderedGraph<W>* reordered = nullptr;
+
+public:
+    BasicGraphRef(const BasicGraph<W>& graph) : denseGraph(&graph) {}
+    BasicGraphRef(const BasicCsrGraph<W>& graph) : csrGraph(&graph) {}
+    // The snapshot must outlive the engine; later batches on the dynamic graph do not affect it.
+    BasicGraphRef(const BasicGraphSnapshot<W>& graph) : snapshotGraph(&graph) {}
+    BasicGraphRef(const BasicCompressedGraph<W>& graph) : compressedGraph(&graph) {}
+    // Searches run on the relabeled graph; vertex ids in arguments and results stay the original ones.
+    BasicGraphRef(const BasicReorderedGraph<W>& graph) : csrGraph(&graph.getGraph()), reordered(&graph) {}
+
+    template <typename F>
+    auto visit(F&& f) const {
+        if (csrGraph) return f(*csrGraph);
+        if (snapshotGraph) return f(*snapshotGraph);
+        if (compressedGraph) return f(*compressedGraph);
+        return f(*denseGraph);
+    }
+
+    size_t getNumVertices() const {
+        return visit([](const auto& g) { return g.getNumVertices(); });
+    }
+
+    bool isDirected() const {
+        return visit([](const auto& g) { return g.isDirected(); });
+    }
+
+    // Changes whenever the arcs do. Only the adjacency-matrix backend can be edited; the others stay at 0.
+    uint64_t getVersion() const { return denseGraph ? denseGraph->getVersion() : 0; }
+
+    const BasicReorderedGraph<W>* getReordering() const { return reordered; }
+    int toInternal(int vertex) const { return reordered ? reordered->toInternal(vertex) : vertex; }
+    int toOriginal(int vertex) const { return reordered ? reordered->toOriginal(vertex) : vertex; }
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <memory>
+#include <string>
+#include "contractionHierarchy.h"
+
+// Hub labels derived from a contraction hierarchy: the forward label of v lists the hubs reachable upward
+// from v with their distances, the backward label the hubs that reach v downward (on undirected graphs the
+// two coincide and are stored once). A hub is dropped from a label when the labels built so far already
+// give a shorter path to it. Labels are flat arrays sorted by hub, so a query is a single merge of two runs.
+template <typename W, typename D = W>
+class BasicHubLabels {
+public:
+    struct Stats {
+        uint64_t forwardEntries;
+        uint64_t backwardEntries;
+        double averageLabelSize;
+        size_t maxLabelSize;
+        uint64_t memoryBytes;
+    };
+
+    // Labels are built level by level from the top of the hierarchy, each level on the given number of threads (0 = all).
+    explicit BasicHubLabels(const BasicContractionHierarchy<W, D>& hierarchy, size_t threads = 0);
+
+    size_t getNumVertices() const { return numVertices; }
+    bool isDirected() const { return directed; }
+
+    // Thread-safe; WeightTraits<D>::unreachable() when target cannot be reached.
+    D distance(int source, int target) const;
+
+    size_t getForwardLabelSize(size_t v) const { return static_cast<size_t>(forwardOffsets[v + 1] - forwardOffsets[v]); }
+    size_t getBackwardLabelSize(size_t v) const { return static_cast<size_t>(backwardOffsets[v + 1] - backwardOffsets[v]); }
+    Stats getStats() const;
+
+    void save(const std::string& path) const;
+    // Maps the file and answers queries straight from the mapped pages. The distance type must match
+    // the one the labels were written with.
+    static BasicHubLabels load(const std::string& path);
+
+private:
+    struct Storage {
+        myVector<uint64_t> forwardOffsets;
+        myVector<uint32_t> forwardHubs;
+        myVector<D> forwardDistances;
+        myVector<uint64_t> backwardOffsets;
+        myVector<uint32_t> backwardHubs;
+        myVector<D> backwardDistances;
+    };
+
+    size_t numVertices;
+    bool directed;
+    const uint64_t* forwardOffsets;
+    const uint32_t* forwardHubs;
+    const D* forwardDistances;
+    const uint64_t* backwardOffsets;
+    const uint32_t* backwardHubs;
+    const D* backwardDistances;
+    std::shared_ptr<const void> owner;
+
+    BasicHubLabels() : numVertices(0), directed(false), forwardOffsets(nullptr), forwardHubs(nullptr), forwardDistances(nullptr),
+        backwardOffsets(nullptr), backwardHubs(nullptr), backwardDistances(nullptr) {
+    }
+};
+
+typedef BasicHubLabels<int, int> HubLabels;
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+class MappedFile {
+private:
+    unsigned char* data_;
+    size_t size_;
+    bool writable;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fd;
+#endif
+
+public:
+    explicit MappedFile(const std::string& path);
+    // Creates the file, or truncates an existing one, at the given size and maps it for writing.
+    MappedFile(const std::string& path, size_t size);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return data_; }
+    unsigned char* writableData() {
+        if (!writable) throw std::logic_error("File is mapped read-only");
+        return data_;
+    }
+    size_t size() const { return size_; }
+};
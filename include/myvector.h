@@ -57,6 +57,9 @@ public:
     T& operator[](size_t index) { return data_[index]; }
     const T& operator[](size_t index) const { return data_[index]; }
 
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
     T& back() {
         if (size_ == 0) throw std::out_of_range("Vector is empty");
         return data_[size_ - 1];
@@ -74,6 +77,13 @@ public:
         data_[size_++] = value;
     }
 
+    void push_back(T&& value) {
+        if (size_ >= capacity_) {
+            reserve(capacity_ ? capacity_ * 2 : 1);
+        }
+        data_[size_++] = std::move(value);
+    }
+
     void pop_back() {
         if (size_ == 0) throw std::out_of_range("Vector is empty");
         --size_;
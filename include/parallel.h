@@ -0,0 +1,175 @@
+#pragma once
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "myvector.h"
+
+inline size_t hardwareThreads() {
+    const unsigned count = std::thread::hardware_concurrency();
+    return count ? count : 1;
+}
+
+// Splits [0, count) into one contiguous block per thread and runs body(i) for every index.
+// The calling thread processes the first block; the first exception thrown is rethrown after all joins.
+template <typename F>
+void parallelFor(size_t count, size_t threads, F&& body) {
+    if (threads == 0) threads = hardwareThreads();
+    if (threads > count) threads = count;
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) body(i);
+        return;
+    }
+
+    myVector<std::exception_ptr> errors(threads);
+    auto runBlock = [&](size_t block) {
+        try {
+            const size_t begin = count * block / threads;
+            const size_t end = count * (block + 1) / threads;
+            for (size_t i = begin; i < end; ++i) body(i);
+        }
+        catch (...) {
+            errors[block] = std::current_exception();
+        }
+    };
+
+    myVector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t block = 1; block < threads; ++block) {
+        workers.push_back(std::thread(runBlock, block));
+    }
+    runBlock(0);
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    for (size_t block = 0; block < threads; ++block) {
+        if (errors[block]) std::rethrow_exception(errors[block]);
+    }
+}
+
+// For loops whose iterations differ widely in cost. Each of min(threads, count) workers starts on its own
+// contiguous block and, when it runs dry, steals the back half of the largest block left, so no worker idles
+// while another still holds a long tail. body(i, worker) gets the worker index for per-thread scratch state.
+template <typename F>
+void parallelForDynamic(size_t count, size_t threads, F&& body) {
+    if (threads == 0) threads = hardwareThreads();
+    if (threads > count) threads = count;
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) body(i, 0);
+        return;
+    }
+
+    struct Range {
+        std::mutex mutex;
+        size_t next;
+        size_t end;
+    };
+    std::unique_ptr<Range[]> ranges(new Range[threads]);
+    for (size_t t = 0; t < threads; ++t) {
+        ranges[t].next = count * t / threads;
+        ranges[t].end = count * (t + 1) / threads;
+    }
+
+    auto take = [&](size_t worker, size_t& index) {
+        {
+            std::lock_guard<std::mutex> lock(ranges[worker].mutex);
+            if (ranges[worker].next < ranges[worker].end) {
+                index = ranges[worker].next++;
+                return true;
+            }
+        }
+        while (true) {
+            size_t victim = threads;
+            size_t largest = 0;
+            for (size_t t = 0; t < threads; ++t) {
+                std::lock_guard<std::mutex> lock(ranges[t].mutex);
+                if (ranges[t].end - ranges[t].next > largest) {
+                    largest = ranges[t].end - ranges[t].next;
+                    victim = t;
+                }
+            }
+            if (victim == threads) return false;
+
+            size_t begin;
+            size_t end;
+            {
+                std::lock_guard<std::mutex> lock(ranges[victim].mutex);
+                Range& range = ranges[victim];
+                // Someone got there first; look again.
+                if (range.next >= range.end) continue;
+                // With one index left the thief takes it whole.
+                end = range.end;
+                begin = range.next + (range.end - range.next) / 2;
+                range.end = begin;
+            }
+            index = begin;
+            std::lock_guard<std::mutex> lock(ranges[worker].mutex);
+            ranges[worker].next = begin + 1;
+            ranges[worker].end = end;
+            return true;
+        }
+    };
+
+    myVector<std::exception_ptr> errors(threads);
+    auto runWorker = [&](size_t worker) {
+        try {
+            size_t index;
+            while (take(worker, index)) body(index, worker);
+        }
+        catch (...) {
+            errors[worker] = std::current_exception();
+        }
+    };
+
+    myVector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t worker = 1; worker < threads; ++worker) {
+        workers.push_back(std::thread(runWorker, worker));
+    }
+    runWorker(0);
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    for (size_t worker = 0; worker < threads; ++worker) {
+        if (errors[worker]) std::rethrow_exception(errors[worker]);
+    }
+}
+
+// Reusable barrier for a fixed group of threads, such as the workers of one parallelFor(threads, threads, ...).
+class Barrier {
+private:
+    std::mutex mutex;
+    std::condition_variable released;
+    size_t parties;
+    size_t waiting;
+    size_t generation;
+
+public:
+    explicit Barrier(size_t parties) : parties(parties), waiting(0), generation(0) {}
+
+    Barrier(const Barrier&) = delete;
+    Barrier& operator=(const Barrier&) = delete;
+
+    void wait() {
+        wait([] {});
+    }
+
+    // The last thread to arrive runs completion before any thread is released, so state it publishes
+    // is seen identically by all of them.
+    template <typename F>
+    void wait(F&& completion) {
+        std::unique_lock<std::mutex> lock(mutex);
+        const size_t current = generation;
+        if (++waiting == parties) {
+            completion();
+            waiting = 0;
+            ++generation;
+            released.notify_all();
+            return;
+        }
+        released.wait(lock, [&] { return generation != current; });
+    }
+};
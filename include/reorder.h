@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include "csrGraph.h"
+
+// Every ordering is returned as a permutation with permutation[oldId] == newId.
+// Directed graphs are ordered by their underlying undirected structure.
+
+template <typename W>
+myVector<uint32_t> reverseCuthillMcKeeOrder(const BasicCsrGraph<W>& graph);
+
+template <typename W>
+myVector<uint32_t> bfsOrder(const BasicCsrGraph<W>& graph);
+
+template <typename W>
+myVector<uint32_t> degreeOrder(const BasicCsrGraph<W>& graph);
+
+myVector<uint32_t> hilbertOrder(const myVector<double>& x, const myVector<double>& y);
+
+template <typename W>
+BasicCsrGraph<W> relabelGraph(const BasicCsrGraph<W>& graph, const myVector<uint32_t>& permutation);
+
+template <typename W>
+class BasicReorderedGraph {
+private:
+    BasicCsrGraph<W> graph;
+    myVector<uint32_t> permutation;
+    myVector<uint32_t> inverse;
+
+public:
+    BasicReorderedGraph(const BasicCsrGraph<W>& original, const myVector<uint32_t>& permutation);
+
+    const BasicCsrGraph<W>& getGraph() const { return graph; }
+    size_t getNumVertices() const { return graph.getNumVertices(); }
+    int toInternal(int vertex) const { return static_cast<int>(permutation[vertex]); }
+    int toOriginal(int vertex) const { return static_cast<int>(inverse[vertex]); }
+
+    template <typename T>
+    myVector<T> valuesToOriginal(const myVector<T>& internal) const {
+        myVector<T> result(internal.size());
+        for (size_t v = 0; v < internal.size(); ++v) {
+            result[v] = internal[permutation[v]];
+        }
+        return result;
+    }
+
+    // For per-vertex arrays whose entries are vertex ids themselves (predecessors, successors), -1 kept.
+    myVector<int> verticesToOriginal(const myVector<int>& internal) const {
+        myVector<int> result(internal.size());
+        for (size_t v = 0; v < internal.size(); ++v) {
+            const int value = internal[permutation[v]];
+            result[v] = value == -1 ? -1 : toOriginal(value);
+        }
+        return result;
+    }
+};
+
+typedef BasicReorderedGraph<int> ReorderedGraph;
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+
+template <typename G>
+class ReverseView {
+private:
+    const G& graph;
+
+public:
+    explicit ReverseView(const G& graph) : graph(graph) {}
+
+    size_t getNumVertices() const { return graph.getNumVertices(); }
+    bool isDirected() const { return graph.isDirected(); }
+
+    template <typename F>
+    void forEachNeighbor(size_t u, F&& f) const { graph.forEachInNeighbor(u, f); }
+
+    template <typename F>
+    void forEachInNeighbor(size_t v, F&& f) const { graph.forEachNeighbor(v, f); }
+};
@@ -0,0 +1,13 @@
+#pragma once
+#include "cpuFeatures.h"
+#if SIMD_X86
+#include <immintrin.h>
+
+// Helpers shared by the vector kernels. Each carries the target of the kernels calling it, so it inlines there.
+
+// Low 32 bits of each 64-bit mask lane, the mask for four int predecessors.
+SIMD_TARGET_AVX2 inline __m128i narrowMask(__m256i mask) {
+    return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(mask, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)));
+}
+
+#endif
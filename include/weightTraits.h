@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// Graph and search classes are instantiated for uint16_t, uint32_t, int, int64_t, float and double weights.
+// Signed types mark a missing edge or an unreachable vertex with -1, unsigned types with their maximum value.
+template <typename T>
+struct WeightTraits {
+    static_assert(std::is_arithmetic<T>::value, "Weights and distances must be arithmetic types");
+
+    static T noEdge() {
+        return std::is_signed<T>::value ? static_cast<T>(-1) : std::numeric_limits<T>::max();
+    }
+
+    static T unreachable() { return noEdge(); }
+
+    static T infinity() {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    }
+
+    static bool isValidWeight(T weight) {
+        return weight > static_cast<T>(0) && weight != noEdge() && weight < infinity();
+    }
+};
+
+template <typename D, typename W>
+struct DistanceCompatible {
+    static const bool value = std::is_floating_point<D>::value ||
+        (std::is_integral<W>::value && std::numeric_limits<D>::digits >= std::numeric_limits<W>::digits);
+};
+
+template <typename D, typename W>
+typename std::enable_if<std::is_integral<D>::value, D>::type addDistance(D distance, W weight) {
+    const D step = static_cast<D>(weight);
+    if (step >= std::numeric_limits<D>::max() - distance) {
+        throw std::overflow_error("Path length overflows the distance type");
+    }
+    return distance + step;
+}
+
+template <typename D, typename W>
+typename std::enable_if<std::is_floating_point<D>::value, D>::type addDistance(D distance, W weight) {
+    return distance + static_cast<D>(weight);
+}
@@ -227,8 +227,8 @@ int main() {
         }
 
         case 6: {
-            if (distances.empty()) {
-                cout << "  !" << endl;
+            if (startVertex == -1) {
+                cout << "   !" << endl;
                 break;
             }
 
@@ -238,30 +238,23 @@ int main() {
 
             if (target < 0 || target >= graph.getNumVertices()) {
                 cout << " !" << endl;
+                break;
             }
-            else if (distances[target] == -1) {
+
+            Dijkstra::PathResult result = dijkstra->shortestPath(startVertex, target, Dijkstra::D_HEAP, 2);
+            if (result.path.empty()) {
                 cout << "!" << endl;
             }
             else {
-                cout << ": " << distances[target] << endl;
-
-                myVector<int> predecessors;
-                dijkstra->shortestPathsWithPredecessors(startVertex, Dijkstra::D_HEAP, predecessors, 2);
-                myVector<int> path = graph.getPath(startVertex, target, predecessors);
-
-                if (path.empty()) {
-                    cout << "  !" << endl;
-                }
-                else {
-                    cout << ": ";
-                    for (size_t i = 0; i < path.size(); ++i) {
-                        cout << path[i];
-                        if (i != path.size() - 1) {
-                            cout << " -> ";
-                        }
+                cout << ": " << result.distance << endl;
+                cout << ": ";
+                for (size_t i = 0; i < result.path.size(); ++i) {
+                    cout << result.path[i];
+                    if (i != result.path.size() - 1) {
+                        cout << " -> ";
                     }
-                    cout << endl;
                 }
+                cout << endl;
             }
             break;
         }
@@ -0,0 +1,54 @@
+#include "allPairs.h"
+#include "mappedFile.h"
+#include "parallel.h"
+#include <memory>
+
+template <typename W, typename D>
+BasicAllPairs<W, D>::BasicAllPairs(BasicGraphRef<W> graph, size_t threads, int d)
+    : engine(graph), numVertices(graph.getNumVertices()), threads(threads ? threads : hardwareThreads()), d(d) {
+}
+
+template <typename W, typename D>
+void BasicAllPairs<W, D>::computeRows(int firstSource, int lastSource, D* matrix) const {
+    const int n = static_cast<int>(numVertices);
+    if (firstSource < 0 || lastSource > n || firstSource > lastSource) {
+        throw std::out_of_range("Source range out of range");
+    }
+    const size_t rows = static_cast<size_t>(lastSource - firstSource);
+    const size_t workers = threads < rows ? threads : rows;
+    std::unique_ptr<std::unique_ptr<BasicDijkstraWorkspace<D>>[]> workspaces(new std::unique_ptr<BasicDijkstraWorkspace<D>>[workers]);
+    for (size_t t = 0; t < workers; ++t) {
+        workspaces[t].reset(new BasicDijkstraWorkspace<D>(numVertices, d));
+    }
+    parallelForDynamic(rows, workers, [&](size_t row, size_t worker) {
+        engine.distancesInto(firstSource + static_cast<int>(row), *workspaces[worker], matrix + row * numVertices);
+    });
+}
+
+template <typename W, typename D>
+myVector<D> BasicAllPairs<W, D>::compute() const {
+    myVector<D> matrix(numVertices * numVertices);
+    computeRows(0, static_cast<int>(numVertices), matrix.data());
+    return matrix;
+}
+
+template <typename W, typename D>
+void BasicAllPairs<W, D>::computeToFile(const std::string& path, int firstSource, int lastSource) const {
+    if (firstSource < 0 || lastSource > static_cast<int>(numVertices) || firstSource > lastSource) {
+        throw std::out_of_range("Source range out of range");
+    }
+    const size_t rows = static_cast<size_t>(lastSource - firstSource);
+    MappedFile file(path, rows * numVertices * sizeof(D));
+    computeRows(firstSource, lastSource, reinterpret_cast<D*>(file.writableData()));
+}
+
+template class BasicAllPairs<uint16_t, uint32_t>;
+template class BasicAllPairs<uint16_t, uint64_t>;
+template class BasicAllPairs<uint32_t, uint32_t>;
+template class BasicAllPairs<uint32_t, uint64_t>;
+template class BasicAllPairs<int, int>;
+template class BasicAllPairs<int, int64_t>;
+template class BasicAllPairs<int64_t, int64_t>;
+template class BasicAllPairs<float, float>;
+template class BasicAllPairs<float, double>;
+template class BasicAllPairs<double, double>;
@@ -0,0 +1,338 @@
+#include "alt.h"
+#include "graphFile.h"
+#include "mappedFile.h"
+#include "parallel.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+namespace {
+
+const char landmarkFileMagic[8] = { 'L', 'A', 'N', 'D', 'M', 'A', 'R', 'K' };
+const uint32_t landmarkFileVersion = 1;
+
+// Same flag layout as GraphFileHeader: bit 0 directed, bits 8-15 the kind of the distance type.
+struct LandmarkFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+    uint32_t flags;
+    uint32_t distanceSize;
+    uint64_t numVertices;
+    uint64_t numLandmarks;
+};
+
+// Dijkstra reports unreachable vertices as WeightTraits<D>::unreachable(); selection and tables want infinity.
+template <typename W, typename D>
+myVector<D> distancesFrom(BasicDijkstra<W, D>& engine, size_t source, myVector<int>& predecessors) {
+    myVector<D> dist = engine.shortestPathsWithPredecessors(static_cast<int>(source), BasicDijkstra<W, D>::D_HEAP, predecessors, 4);
+    for (size_t v = 0; v < dist.size(); ++v) {
+        if (dist[v] == WeightTraits<D>::unreachable()) dist[v] = WeightTraits<D>::infinity();
+    }
+    return dist;
+}
+
+template <typename D>
+size_t farthestVertex(const myVector<D>& dist, const myVector<bool>& chosen) {
+    size_t best = dist.size();
+    for (size_t v = 0; v < dist.size(); ++v) {
+        if (!chosen[v] && (best == dist.size() || dist[v] > dist[best])) best = v;
+    }
+    return best;
+}
+
+// Adds landmarks until there are count of them, each time taking the vertex farthest from its nearest landmark.
+// Vertices unreachable from every landmark count as infinitely far, so every component gets covered.
+template <typename W, typename D>
+void extendFarthest(BasicDijkstra<W, D>& engine, size_t n, size_t count, size_t start, myVector<uint32_t>& landmarks) {
+    if (landmarks.size() >= count) return;
+    myVector<bool> chosen(n, false);
+    myVector<D> nearest(n, WeightTraits<D>::infinity());
+    myVector<int> predecessors;
+    for (size_t i = 0; i < landmarks.size(); ++i) {
+        chosen[landmarks[i]] = true;
+        const myVector<D> dist = distancesFrom(engine, landmarks[i], predecessors);
+        for (size_t v = 0; v < n; ++v) nearest[v] = std::min(nearest[v], dist[v]);
+    }
+    if (landmarks.empty()) {
+        nearest = distancesFrom(engine, start, predecessors);
+    }
+    while (landmarks.size() < count) {
+        const size_t next = farthestVertex(nearest, chosen);
+        landmarks.push_back(static_cast<uint32_t>(next));
+        chosen[next] = true;
+        const myVector<D> dist = distancesFrom(engine, next, predecessors);
+        for (size_t v = 0; v < n; ++v) nearest[v] = std::min(nearest[v], dist[v]);
+    }
+}
+
+template <typename W, typename D>
+void selectAvoid(BasicDijkstra<W, D>& engine, size_t n, size_t count, std::mt19937& random, myVector<uint32_t>& landmarks) {
+    const D infinity = WeightTraits<D>::infinity();
+    extendFarthest(engine, n, 1, random() % n, landmarks);
+
+    myVector<int> predecessors;
+    myVector<myVector<D>> tables;
+    tables.push_back(distancesFrom(engine, landmarks[0], predecessors));
+    myVector<bool> chosen(n, false);
+    chosen[landmarks[0]] = true;
+
+    while (landmarks.size() < count) {
+        const size_t root = random() % n;
+        const myVector<D> dist = distancesFrom(engine, root, predecessors);
+
+        // How badly the current landmarks bound dist(root, v), summed over landmark-free subtrees.
+        myVector<double> size(n, 0.0);
+        myVector<bool> covered(n, false);
+        myVector<uint32_t> order;
+        for (size_t v = 0; v < n; ++v) {
+            if (dist[v] == infinity) continue;
+            order.push_back(static_cast<uint32_t>(v));
+            D bound = D();
+            for (size_t l = 0; l < tables.size(); ++l) {
+                const D* table = tables[l].data();
+                if (table[v] != infinity && table[root] != infinity && table[v] > table[root]) {
+                    bound = std::max(bound, static_cast<D>(table[v] - table[root]));
+                }
+            }
+            size[v] = static_cast<double>(dist[v]) - static_cast<double>(bound);
+            covered[v] = chosen[v];
+        }
+        std::sort(order.data(), order.data() + order.size(), [&](uint32_t a, uint32_t b) { return dist[a] > dist[b]; });
+        for (size_t i = 0; i < order.size(); ++i) {
+            const uint32_t v = order[i];
+            if (covered[v]) size[v] = 0.0;
+            const int parent = predecessors[v];
+            if (parent == -1) continue;
+            size[parent] += size[v];
+            covered[parent] = covered[parent] || covered[v];
+        }
+
+        myVector<uint32_t> childOffsets(n + 1, 0);
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (predecessors[order[i]] != -1) ++childOffsets[predecessors[order[i]] + 1];
+        }
+        for (size_t v = 0; v < n; ++v) childOffsets[v + 1] += childOffsets[v];
+        myVector<uint32_t> children(childOffsets[n]);
+        myVector<uint32_t> fill(childOffsets);
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (predecessors[order[i]] != -1) children[fill[predecessors[order[i]]]++] = order[i];
+        }
+
+        size_t best = root;
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (size[order[i]] > size[best]) best = order[i];
+        }
+        // Descend to a leaf through the child with the largest size.
+        for (;;) {
+            size_t child = n;
+            for (uint32_t i = childOffsets[best]; i < childOffsets[best + 1]; ++i) {
+                if (child == n || size[children[i]] > size[child]) child = children[i];
+            }
+            if (child == n || size[child] <= 0.0) break;
+            best = child;
+        }
+
+        if (chosen[best] || size[best] <= 0.0) {
+            extendFarthest(engine, n, landmarks.size() + 1, root, landmarks);
+            best = landmarks.back();
+            landmarks.pop_back();
+        }
+        landmarks.push_back(static_cast<uint32_t>(best));
+        chosen[best] = true;
+        tables.push_back(distancesFrom(engine, best, predecessors));
+    }
+}
+
+template <typename W, typename D>
+void selectPlanar(BasicDijkstra<W, D>& engine, size_t n, size_t count, const VertexCoordinates& coordinates,
+    myVector<uint32_t>& landmarks) {
+    const double pi = 3.14159265358979323846;
+    double cx = 0.0;
+    double cy = 0.0;
+    for (size_t v = 0; v < n; ++v) {
+        cx += coordinates.getX(v);
+        cy += coordinates.getY(v);
+    }
+    cx /= static_cast<double>(n);
+    cy /= static_cast<double>(n);
+
+    size_t center = 0;
+    double closest = -1.0;
+    for (size_t v = 0; v < n; ++v) {
+        const double dx = coordinates.getX(v) - cx;
+        const double dy = coordinates.getY(v) - cy;
+        if (closest < 0.0 || dx * dx + dy * dy < closest) {
+            closest = dx * dx + dy * dy;
+            center = v;
+        }
+    }
+
+    myVector<int> predecessors;
+    const myVector<D> dist = distancesFrom(engine, center, predecessors);
+    myVector<size_t> best(count, n);
+    for (size_t v = 0; v < n; ++v) {
+        if (v == center || dist[v] == WeightTraits<D>::infinity()) continue;
+        const double angle = std::atan2(coordinates.getY(v) - cy, coordinates.getX(v) - cx) + pi;
+        size_t sector = static_cast<size_t>(angle / (2 * pi) * static_cast<double>(count));
+        if (sector >= count) sector = count - 1;
+        if (best[sector] == n || dist[v] > dist[best[sector]]) best[sector] = v;
+    }
+    for (size_t s = 0; s < count; ++s) {
+        if (best[s] != n) landmarks.push_back(static_cast<uint32_t>(best[s]));
+    }
+    // Empty sectors are made up for with farthest-first picks.
+    extendFarthest(engine, n, count, center, landmarks);
+}
+
+}
+
+template <typename W, typename D>
+myVector<uint32_t> BasicLandmarks<W, D>::selectLandmarks(BasicGraphRef<W> graph, size_t count, Strategy strategy,
+    const VertexCoordinates* coordinates, uint32_t seed) {
+    const size_t n = graph.getNumVertices();
+    if (count == 0 || count > n) {
+        throw std::invalid_argument("Landmark count must be between 1 and the number of vertices");
+    }
+    if (strategy == PLANAR && (!coordinates || coordinates->size() != n)) {
+        throw std::invalid_argument("Planar landmark selection needs coordinates for every vertex");
+    }
+
+    BasicDijkstra<W, D> engine(graph);
+    std::mt19937 random(seed);
+    myVector<uint32_t> landmarks;
+    if (strategy == AVOID) {
+        selectAvoid(engine, n, count, random, landmarks);
+    }
+    else if (strategy == PLANAR) {
+        selectPlanar(engine, n, count, *coordinates, landmarks);
+    }
+    else {
+        extendFarthest(engine, n, count, random() % n, landmarks);
+    }
+    return landmarks;
+}
+
+template <typename W, typename D>
+BasicLandmarks<W, D>::BasicLandmarks(BasicGraphRef<W> graph, const myVector<uint32_t>& landmarks, size_t threads)
+    : numVertices(graph.getNumVertices()), directed(graph.isDirected()), landmarks(landmarks) {
+    const size_t k = landmarks.size();
+    if (k == 0) {
+        throw std::invalid_argument("At least one landmark is required");
+    }
+    for (size_t i = 0; i < k; ++i) {
+        if (landmarks[i] >= numVertices) {
+            throw std::out_of_range("Landmark vertex out of range");
+        }
+    }
+
+    fromTable.resize(numVertices * k);
+    if (directed) toTable.resize(numVertices * k);
+    parallelFor(k, threads, [&](size_t i) {
+        BasicDijkstra<W, D> engine(graph);
+        myVector<int> links;
+        const myVector<D> from = distancesFrom(engine, landmarks[i], links);
+        for (size_t v = 0; v < numVertices; ++v) fromTable[v * k + i] = from[v];
+        if (directed) {
+            myVector<D> to = engine.shortestPathsToTarget(static_cast<int>(landmarks[i]), BasicDijkstra<W, D>::D_HEAP, links, 4);
+            for (size_t v = 0; v < numVertices; ++v) {
+                toTable[v * k + i] = to[v] == WeightTraits<D>::unreachable() ? WeightTraits<D>::infinity() : to[v];
+            }
+        }
+    });
+}
+
+template <typename W, typename D>
+void BasicLandmarks<W, D>::save(const std::string& path) const {
+    LandmarkFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, landmarkFileMagic, sizeof(header.magic));
+    header.version = landmarkFileVersion;
+    header.endian = GraphFileHeader::endianTag;
+    header.flags = (directed ? GraphFileHeader::directedFlag : 0) | (weightKind<D>() << GraphFileHeader::weightKindShift);
+    header.distanceSize = sizeof(D);
+    header.numVertices = numVertices;
+    header.numLandmarks = landmarks.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot create file: " + path);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(landmarks.data()), static_cast<std::streamsize>(landmarks.size() * sizeof(uint32_t)));
+    out.write(reinterpret_cast<const char*>(fromTable.data()), static_cast<std::streamsize>(fromTable.size() * sizeof(D)));
+    if (directed) {
+        out.write(reinterpret_cast<const char*>(toTable.data()), static_cast<std::streamsize>(toTable.size() * sizeof(D)));
+    }
+    if (!out) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+}
+
+template <typename W, typename D>
+BasicLandmarks<W, D> BasicLandmarks<W, D>::load(const std::string& path) {
+    MappedFile file(path);
+    LandmarkFileHeader header;
+    if (file.size() < sizeof(header)) {
+        throw std::runtime_error("Not a landmark file: " + path);
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, landmarkFileMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a landmark file: " + path);
+    }
+    if (header.version != landmarkFileVersion) {
+        throw std::runtime_error("Unsupported landmark file version: " + path);
+    }
+    if (header.endian != GraphFileHeader::endianTag) {
+        throw std::runtime_error("Landmark file was written on an incompatible platform: " + path);
+    }
+    const uint32_t kind = (header.flags & GraphFileHeader::weightKindMask) >> GraphFileHeader::weightKindShift;
+    if (header.distanceSize != sizeof(D) || kind != weightKind<D>()) {
+        throw std::runtime_error("Landmark file distance type does not match: " + path);
+    }
+
+    BasicLandmarks result;
+    result.numVertices = static_cast<size_t>(header.numVertices);
+    result.directed = (header.flags & GraphFileHeader::directedFlag) != 0;
+    // Bound the counts by the file size before multiplying, so a forged header cannot wrap the expected size.
+    const uint64_t tables = result.directed ? 2 : 1;
+    if (header.numVertices == 0 || header.numLandmarks == 0 || header.numLandmarks > file.size() / sizeof(uint32_t) ||
+        header.numVertices > file.size() / sizeof(D) / tables / header.numLandmarks) {
+        throw std::runtime_error("Corrupted landmark file: " + path);
+    }
+    const uint64_t cells = header.numVertices * header.numLandmarks;
+    const uint64_t expected = sizeof(header) + header.numLandmarks * sizeof(uint32_t) + cells * sizeof(D) * tables;
+    if (file.size() != expected) {
+        throw std::runtime_error("Corrupted landmark file: " + path);
+    }
+
+    const unsigned char* p = file.data() + sizeof(header);
+    result.landmarks.resize(static_cast<size_t>(header.numLandmarks));
+    std::memcpy(result.landmarks.data(), p, result.landmarks.size() * sizeof(uint32_t));
+    p += result.landmarks.size() * sizeof(uint32_t);
+    for (size_t i = 0; i < result.landmarks.size(); ++i) {
+        if (result.landmarks[i] >= result.numVertices) {
+            throw std::runtime_error("Corrupted landmark file: " + path);
+        }
+    }
+    result.fromTable.resize(static_cast<size_t>(cells));
+    std::memcpy(result.fromTable.data(), p, static_cast<size_t>(cells) * sizeof(D));
+    p += cells * sizeof(D);
+    if (result.directed) {
+        result.toTable.resize(static_cast<size_t>(cells));
+        std::memcpy(result.toTable.data(), p, static_cast<size_t>(cells) * sizeof(D));
+    }
+    return result;
+}
+
+template class BasicLandmarks<uint16_t, uint32_t>;
+template class BasicLandmarks<uint16_t, uint64_t>;
+template class BasicLandmarks<uint32_t, uint32_t>;
+template class BasicLandmarks<uint32_t, uint64_t>;
+template class BasicLandmarks<int, int>;
+template class BasicLandmarks<int, int64_t>;
+template class BasicLandmarks<int64_t, int64_t>;
+template class BasicLandmarks<float, float>;
+template class BasicLandmarks<float, double>;
+template class BasicLandmarks<double, double>;
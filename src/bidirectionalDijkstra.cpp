@@ -0,0 +1,120 @@
+#include "bidirectionalDijkstra.h"
+
+template <typename W, typename D>
+typename BasicBidirectionalDijkstra<W, D>::PathResult BasicBidirectionalDijkstra<W, D>::shortestPath(int source, int target, HeapType heapType, int d) {
+    const int n = static_cast<int>(graph.getNumVertices());
+    if (source < 0 || source >= n) {
+        throw std::out_of_range("Start vertex out of range");
+    }
+    if (target < 0 || target >= n) {
+        throw std::out_of_range("Target vertex out of range");
+    }
+    const int from = graph.toInternal(source);
+    const int to = graph.toInternal(target);
+
+    PathResult result = graph.visit([&](const auto& g) {
+        if (heapType == D_HEAP) {
+            DHeap<Node> forwardQueue(d);
+            DHeap<Node> backwardQueue(d);
+            return search(g, from, to, forwardQueue, backwardQueue);
+        }
+        BinomialHeap<Node> forwardQueue;
+        BinomialHeap<Node> backwardQueue;
+        return search(g, from, to, forwardQueue, backwardQueue);
+    });
+
+    for (size_t i = 0; i < result.path.size(); ++i) {
+        result.path[i] = graph.toOriginal(result.path[i]);
+    }
+    return result;
+}
+
+template <typename W, typename D>
+template <typename Heap, typename G>
+typename BasicBidirectionalDijkstra<W, D>::PathResult BasicBidirectionalDijkstra<W, D>::search(const G& g, int source, int target,
+    Heap& forwardQueue, Heap& backwardQueue) {
+    lastSettled = 0;
+    PathResult result;
+    if (source == target) {
+        result.distance = 0;
+        result.path.push_back(source);
+        return result;
+    }
+
+    const size_t n = g.getNumVertices();
+    const D infinity = WeightTraits<D>::infinity();
+    Side forward(n);
+    Side backward(n);
+    forward.dist[source] = 0;
+    backward.dist[target] = 0;
+    forwardQueue.push({ source, 0 });
+    backwardQueue.push({ target, 0 });
+
+    D best = infinity;
+    int meeting = -1;
+    const ReverseView<G> reverse(g);
+    while (!forwardQueue.empty() && !backwardQueue.empty()) {
+        const D forwardMin = forwardQueue.top().distance;
+        const D backwardMin = backwardQueue.top().distance;
+        if (best != infinity && (backwardMin >= best || forwardMin >= best - backwardMin)) break;
+
+        if (forwardQueue.size() <= backwardQueue.size()) {
+            settleNext(g, forwardQueue, forward, backward, best, meeting);
+        }
+        else {
+            settleNext(reverse, backwardQueue, backward, forward, best, meeting);
+        }
+    }
+
+    if (meeting == -1) {
+        result.distance = WeightTraits<D>::unreachable();
+        return result;
+    }
+    result.distance = best;
+    result.path = reconstructPath(source, meeting, forward.links);
+    for (int v = backward.links[meeting]; v != -1; v = backward.links[v]) {
+        result.path.push_back(v);
+    }
+    return result;
+}
+
+// Every relaxed arc that reaches a vertex labelled by the other side is a candidate meeting point.
+template <typename W, typename D>
+template <typename Heap, typename G>
+void BasicBidirectionalDijkstra<W, D>::settleNext(const G& g, Heap& queue, Side& side, const Side& other, D& best, int& meeting) {
+    const int u = queue.top().vertex;
+    queue.pop();
+    if (side.settled[u]) return;
+    side.settled[u] = true;
+    ++lastSettled;
+
+    const D infinity = WeightTraits<D>::infinity();
+    g.forEachNeighbor(u, [&](size_t neighbor, W weight) {
+        const int v = static_cast<int>(neighbor);
+        if (side.settled[v]) return;
+        const D candidate = addDistance(side.dist[u], weight);
+        if (candidate < side.dist[v]) {
+            side.dist[v] = candidate;
+            side.links[v] = u;
+            queue.push({ v, candidate });
+        }
+        if (other.dist[v] != infinity) {
+            const D total = addDistance(side.dist[v], other.dist[v]);
+            if (total < best) {
+                best = total;
+                meeting = v;
+            }
+        }
+    });
+}
+
+template class BasicBidirectionalDijkstra<uint16_t, uint32_t>;
+template class BasicBidirectionalDijkstra<uint16_t, uint64_t>;
+template class BasicBidirectionalDijkstra<uint32_t, uint32_t>;
+template class BasicBidirectionalDijkstra<uint32_t, uint64_t>;
+template class BasicBidirectionalDijkstra<int, int>;
+template class BasicBidirectionalDijkstra<int, int64_t>;
+template class BasicBidirectionalDijkstra<int64_t, int64_t>;
+template class BasicBidirectionalDijkstra<float, float>;
+template class BasicBidirectionalDijkstra<float, double>;
+template class BasicBidirectionalDijkstra<double, double>;
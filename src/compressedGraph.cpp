@@ -0,0 +1,177 @@
+#include "compressedGraph.h"
+#include "parallel.h"
+#include <limits>
+
+namespace {
+
+size_t varintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+void writeVarint(uint8_t*& out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+}
+
+uint64_t zigzag(int64_t value) {
+    return value < 0 ? (static_cast<uint64_t>(-(value + 1)) << 1) | 1 : static_cast<uint64_t>(value) << 1;
+}
+
+template <typename W>
+void storeWeight(uint8_t* out, W weight, W, size_t, std::true_type) {
+    std::memcpy(out, &weight, sizeof(W));
+}
+
+template <typename W>
+void storeWeight(uint8_t* out, W weight, W minWeight, size_t width, std::false_type) {
+    const uint64_t value = static_cast<uint64_t>(weight) - static_cast<uint64_t>(minWeight);
+    for (size_t i = 0; i < width; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+template <typename W>
+size_t widthFor(W, W, std::true_type) {
+    return sizeof(W);
+}
+
+template <typename W>
+size_t widthFor(W minWeight, W maxWeight, std::false_type) {
+    const uint64_t range = static_cast<uint64_t>(maxWeight) - static_cast<uint64_t>(minWeight);
+    size_t width = 1;
+    while (width < sizeof(W) && (range >> (8 * width)) != 0) {
+        width *= 2;
+    }
+    return width;
+}
+
+// Returns the encoded size of row u; writes it when out is not null.
+template <typename W>
+size_t encodeRow(const uint32_t* targets, const W* weights, size_t degree, size_t u, W minWeight, size_t width, uint8_t* out) {
+    size_t size = varintSize(degree) + degree * width;
+    for (size_t i = 0; i < degree; ++i) {
+        size += i == 0 ? varintSize(zigzag(static_cast<int64_t>(targets[0]) - static_cast<int64_t>(u)))
+                       : varintSize(targets[i] - targets[i - 1] - 1);
+    }
+    if (!out) return size;
+
+    writeVarint(out, degree);
+    for (size_t i = 0; i < degree; ++i) {
+        storeWeight(out, weights[i], minWeight, width, std::is_floating_point<W>());
+        out += width;
+    }
+    for (size_t i = 0; i < degree; ++i) {
+        writeVarint(out, i == 0 ? zigzag(static_cast<int64_t>(targets[0]) - static_cast<int64_t>(u))
+                                : targets[i] - targets[i - 1] - 1);
+    }
+    return size;
+}
+
+}
+
+template <typename W>
+BasicCompressedGraph<W>::BasicCompressedGraph(const BasicCsrGraph<W>& graph, size_t threads)
+    : numVertices(graph.getNumVertices()), directed(graph.isDirected()), numArcs(graph.getNumArcs()),
+      minWeight(0), weightWidth(1) {
+    const W* weights = graph.getWeights();
+    if (numArcs > 0) {
+        W lowest = weights[0];
+        W highest = weights[0];
+        for (size_t i = 1; i < numArcs; ++i) {
+            if (weights[i] < lowest) lowest = weights[i];
+            if (weights[i] > highest) highest = weights[i];
+        }
+        minWeight = std::is_floating_point<W>::value ? W() : lowest;
+        weightWidth = widthFor(lowest, highest, std::is_floating_point<W>());
+    }
+    else if (std::is_floating_point<W>::value) {
+        weightWidth = sizeof(W);
+    }
+
+    compress(graph.getOffsets(), graph.getTargets(), weights, threads, forward);
+    if (directed) {
+        compress(graph.getReverseOffsets(), graph.getReverseTargets(), graph.getReverseWeights(), threads, backward);
+    }
+}
+
+// Two passes over blocks of 64 rows: sizes first, then every block encodes into its own slice.
+template <typename W>
+void BasicCompressedGraph<W>::compress(const uint64_t* offsets, const uint32_t* targets, const W* weights, size_t threads, Adjacency& out) {
+    const size_t blockSize = static_cast<size_t>(1) << BLOCK_SHIFT;
+    const size_t blocks = (numVertices + blockSize - 1) >> BLOCK_SHIFT;
+    out.rowOffsets.resize(numVertices, 0);
+    out.blockOffsets.resize(blocks + 1, 0);
+
+    parallelFor(blocks, threads, [&](size_t block) {
+        const size_t end = std::min(numVertices, (block + 1) << BLOCK_SHIFT);
+        uint64_t size = 0;
+        for (size_t u = block << BLOCK_SHIFT; u < end; ++u) {
+            if (size > std::numeric_limits<uint32_t>::max()) {
+                throw std::length_error("Compressed block exceeds 4 GiB");
+            }
+            out.rowOffsets[u] = static_cast<uint32_t>(size);
+            size += encodeRow(targets + offsets[u], weights + offsets[u], static_cast<size_t>(offsets[u + 1] - offsets[u]),
+                u, minWeight, weightWidth, static_cast<uint8_t*>(nullptr));
+        }
+        out.blockOffsets[block + 1] = size;
+    });
+    for (size_t block = 0; block < blocks; ++block) {
+        out.blockOffsets[block + 1] += out.blockOffsets[block];
+    }
+
+    out.bytes.resize(static_cast<size_t>(out.blockOffsets[blocks]));
+    parallelFor(blocks, threads, [&](size_t block) {
+        const size_t end = std::min(numVertices, (block + 1) << BLOCK_SHIFT);
+        for (size_t u = block << BLOCK_SHIFT; u < end; ++u) {
+            uint8_t* row = out.bytes.data() + out.blockOffsets[block] + out.rowOffsets[u];
+            encodeRow(targets + offsets[u], weights + offsets[u], static_cast<size_t>(offsets[u + 1] - offsets[u]),
+                u, minWeight, weightWidth, row);
+        }
+    });
+}
+
+template <typename W>
+size_t BasicCompressedGraph<W>::getDegree(size_t u) const {
+    const uint8_t* p = rowStart(forward, u);
+    return static_cast<size_t>(readVarint(p));
+}
+
+template <typename W>
+W BasicCompressedGraph<W>::getEdgeWeight(size_t u, size_t v) const {
+    if (u >= numVertices || v >= numVertices) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (u == v) {
+        return 0;
+    }
+    W result = WeightTraits<W>::noEdge();
+    forEachNeighbor(u, [&](size_t target, W weight) {
+        if (target == v) result = weight;
+    });
+    return result;
+}
+
+template <typename W>
+size_t BasicCompressedGraph<W>::getMemoryBytes() const {
+    size_t bytes = 0;
+    const Adjacency* parts[] = { &forward, &backward };
+    for (const Adjacency* part : parts) {
+        bytes += part->bytes.size() + part->rowOffsets.size() * sizeof(uint32_t) + part->blockOffsets.size() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+template class BasicCompressedGraph<uint16_t>;
+template class BasicCompressedGraph<uint32_t>;
+template class BasicCompressedGraph<int>;
+template class BasicCompressedGraph<int64_t>;
+template class BasicCompressedGraph<float>;
+template class BasicCompressedGraph<double>;
@@ -0,0 +1,548 @@
+#include "contractionHierarchy.h"
+#include "parallel.h"
+
+namespace {
+
+enum VertexState : uint8_t { ACTIVE, CONTRACTING, CONTRACTED };
+
+template <typename D>
+struct WorkArc {
+    uint32_t vertex;
+    D weight;
+    int32_t middle;
+};
+
+template <typename D>
+struct Shortcut {
+    uint32_t from;
+    uint32_t to;
+    D weight;
+};
+
+// Local Dijkstra from one in-neighbour of the vertex being contracted. It never enters that vertex
+// or any other vertex contracted in the same round, so every witness it finds survives the round.
+template <typename D>
+class WitnessSearch {
+private:
+    typedef BasicHeapNode<D> Node;
+
+    myVector<D> dist;
+    myVector<uint32_t> hops;
+    myVector<uint32_t> targetStamp;
+    myVector<uint32_t> touched;
+    DHeap<Node> queue;
+    uint32_t stamp;
+    size_t pendingTargets;
+
+public:
+    WitnessSearch() : queue(4), stamp(0), pendingTargets(0) {}
+
+    void init(size_t n) {
+        dist.resize(n, WeightTraits<D>::infinity());
+        hops.resize(n, 0);
+        targetStamp.resize(n, 0);
+    }
+
+    D distance(size_t v) const { return dist[v]; }
+
+    // Targets of the next run; it stops as soon as all of them are settled.
+    void setTargets(const myVector<WorkArc<D>>& arcs, uint32_t except) {
+        ++stamp;
+        pendingTargets = 0;
+        for (size_t i = 0; i < arcs.size(); ++i) {
+            if (arcs[i].vertex == except || targetStamp[arcs[i].vertex] == stamp) continue;
+            targetStamp[arcs[i].vertex] = stamp;
+            ++pendingTargets;
+        }
+    }
+
+    void run(const myVector<myVector<WorkArc<D>>>& out, const myVector<uint8_t>& state, uint32_t source, uint32_t skip,
+        D limit, size_t settleLimit, size_t hopLimit) {
+        for (size_t i = 0; i < touched.size(); ++i) {
+            dist[touched[i]] = WeightTraits<D>::infinity();
+        }
+        touched.clear();
+        queue.clear();
+
+        dist[source] = 0;
+        hops[source] = 0;
+        touched.push_back(source);
+        queue.push({ static_cast<int>(source), 0 });
+        size_t settled = 0;
+        while (!queue.empty()) {
+            const Node current = queue.top();
+            queue.pop();
+            const uint32_t u = static_cast<uint32_t>(current.vertex);
+            if (current.distance != dist[u]) continue;
+            if (current.distance > limit || ++settled > settleLimit) break;
+            if (targetStamp[u] == stamp && --pendingTargets == 0) break;
+            if (hops[u] >= hopLimit) continue;
+
+            const myVector<WorkArc<D>>& arcs = out[u];
+            for (size_t i = 0; i < arcs.size(); ++i) {
+                const uint32_t v = arcs[i].vertex;
+                if (v == skip || state[v] == CONTRACTING) continue;
+                const D candidate = addDistance(dist[u], arcs[i].weight);
+                if (candidate < dist[v]) {
+                    if (dist[v] == WeightTraits<D>::infinity()) touched.push_back(v);
+                    dist[v] = candidate;
+                    hops[v] = hops[u] + 1;
+                    queue.push({ static_cast<int>(v), candidate });
+                }
+            }
+        }
+    }
+};
+
+// Working graph of the preprocessing: the remaining vertices with their original arcs and shortcuts.
+// Once a vertex is contracted its lists stop changing and hold exactly its up and down arcs.
+template <typename D>
+class Contractor {
+public:
+    myVector<myVector<WorkArc<D>>> out;
+    myVector<myVector<WorkArc<D>>> in;
+    myVector<uint8_t> state;
+    myVector<int64_t> priority;
+    myVector<uint32_t> contractedNeighbors;
+    myVector<uint32_t> level;
+    myVector<uint32_t> seen;
+    size_t settleLimit;
+    size_t hopLimit;
+
+    Contractor(size_t n, size_t settleLimit, size_t hopLimit)
+        : out(n), in(n), state(n, ACTIVE), priority(n, 0), contractedNeighbors(n, 0), level(n, 0), seen(n, 0),
+          settleLimit(settleLimit), hopLimit(hopLimit) {
+    }
+
+    // Counts the shortcuts contracting v needs now, and collects them when shortcuts is given.
+    size_t findShortcuts(uint32_t v, WitnessSearch<D>& search, myVector<Shortcut<D>>* shortcuts) const {
+        const myVector<WorkArc<D>>& outgoing = out[v];
+        const myVector<WorkArc<D>>& incoming = in[v];
+        size_t count = 0;
+        for (size_t i = 0; i < incoming.size(); ++i) {
+            const uint32_t u = incoming[i].vertex;
+            bool anyTarget = false;
+            D longest = D();
+            for (size_t j = 0; j < outgoing.size(); ++j) {
+                if (outgoing[j].vertex == u) continue;
+                if (!anyTarget || outgoing[j].weight > longest) longest = outgoing[j].weight;
+                anyTarget = true;
+            }
+            if (!anyTarget) continue;
+
+            search.setTargets(outgoing, u);
+            search.run(out, state, u, v, addDistance(incoming[i].weight, longest), settleLimit, hopLimit);
+            for (size_t j = 0; j < outgoing.size(); ++j) {
+                const uint32_t w = outgoing[j].vertex;
+                if (w == u) continue;
+                const D via = addDistance(incoming[i].weight, outgoing[j].weight);
+                if (search.distance(w) > via) {
+                    ++count;
+                    if (shortcuts) shortcuts->push_back({ u, w, via });
+                }
+            }
+        }
+        return count;
+    }
+
+    // Twice the edge difference plus the number of already contracted neighbours and the depth in the
+    // hierarchy so far; the last two spread contraction evenly over the graph instead of eating into one region.
+    int64_t computePriority(uint32_t v, WitnessSearch<D>& search) const {
+        const int64_t added = static_cast<int64_t>(findShortcuts(v, search, nullptr));
+        const int64_t removed = static_cast<int64_t>(in[v].size() + out[v].size());
+        return 2 * (added - removed) + contractedNeighbors[v] + level[v];
+    }
+
+    // Ties are broken by a scrambled id so equal-priority vertices in a row do not block each other.
+    bool before(uint32_t a, uint32_t b) const {
+        if (priority[a] != priority[b]) return priority[a] < priority[b];
+        return a * 2654435761u < b * 2654435761u;
+    }
+
+    // Minimum over the two-hop neighbourhood. One hop would already make each round an independent set,
+    // but contracting all one-hop minima at once lets shortcuts pile up; two hops keep close to the
+    // order a sequential contraction would pick.
+    bool isLocalMinimum(uint32_t v) const {
+        for (int direction = 0; direction < 2; ++direction) {
+            const myVector<WorkArc<D>>& arcs = direction ? in[v] : out[v];
+            for (size_t i = 0; i < arcs.size(); ++i) {
+                const uint32_t x = arcs[i].vertex;
+                if (before(x, v) || !precedesNeighbors(v, out[x]) || !precedesNeighbors(v, in[x])) return false;
+            }
+        }
+        return true;
+    }
+
+    bool precedesNeighbors(uint32_t v, const myVector<WorkArc<D>>& arcs) const {
+        for (size_t i = 0; i < arcs.size(); ++i) {
+            if (arcs[i].vertex != v && before(arcs[i].vertex, v)) return false;
+        }
+        return true;
+    }
+
+    // Detaches v from its neighbours, adds its shortcuts and lists every neighbour not yet in changed.
+    void contract(uint32_t v, const myVector<Shortcut<D>>& shortcuts, myVector<uint8_t>& queued, myVector<uint32_t>& changed) {
+        for (size_t i = 0; i < out[v].size(); ++i) {
+            detach(in[out[v][i].vertex], v);
+            touchNeighbor(v, out[v][i].vertex, queued, changed);
+        }
+        for (size_t i = 0; i < in[v].size(); ++i) {
+            detach(out[in[v][i].vertex], v);
+            touchNeighbor(v, in[v][i].vertex, queued, changed);
+        }
+        for (size_t i = 0; i < shortcuts.size(); ++i) {
+            addArc(shortcuts[i].from, shortcuts[i].to, shortcuts[i].weight, static_cast<int32_t>(v));
+        }
+        state[v] = CONTRACTED;
+    }
+
+private:
+    static void detach(myVector<WorkArc<D>>& arcs, uint32_t v) {
+        for (size_t i = 0; i < arcs.size(); ++i) {
+            if (arcs[i].vertex == v) {
+                arcs[i] = arcs.back();
+                arcs.pop_back();
+                return;
+            }
+        }
+    }
+
+    void touchNeighbor(uint32_t v, uint32_t neighbor, myVector<uint8_t>& queued, myVector<uint32_t>& changed) {
+        if (seen[neighbor] == v + 1) return;
+        seen[neighbor] = v + 1;
+        ++contractedNeighbors[neighbor];
+        if (level[neighbor] < level[v] + 1) level[neighbor] = level[v] + 1;
+        if (!queued[neighbor]) {
+            queued[neighbor] = 1;
+            changed.push_back(neighbor);
+        }
+    }
+
+    // Keeps a single arc per vertex pair, the shorter one.
+    void addArc(uint32_t from, uint32_t to, D weight, int32_t middle) {
+        myVector<WorkArc<D>>& outgoing = out[from];
+        for (size_t i = 0; i < outgoing.size(); ++i) {
+            if (outgoing[i].vertex != to) continue;
+            if (weight < outgoing[i].weight) {
+                outgoing[i].weight = weight;
+                outgoing[i].middle = middle;
+                myVector<WorkArc<D>>& incoming = in[to];
+                for (size_t j = 0; j < incoming.size(); ++j) {
+                    if (incoming[j].vertex == from) {
+                        incoming[j].weight = weight;
+                        incoming[j].middle = middle;
+                        break;
+                    }
+                }
+            }
+            return;
+        }
+        outgoing.push_back({ to, weight, middle });
+        in[to].push_back({ from, weight, middle });
+    }
+};
+
+// Runs body(i, search) for i in [0, count) with one witness search per thread.
+template <typename D, typename F>
+void forEachWithSearch(size_t count, size_t threads, myVector<WitnessSearch<D>>& searches, F&& body) {
+    const size_t blocks = threads < count ? threads : count;
+    parallelFor(blocks, blocks, [&](size_t block) {
+        const size_t begin = count * block / blocks;
+        const size_t end = count * (block + 1) / blocks;
+        for (size_t i = begin; i < end; ++i) body(i, searches[block]);
+    });
+}
+
+}
+
+template <typename W, typename D>
+BasicContractionHierarchy<W, D>::BasicContractionHierarchy(BasicGraphRef<W> graph, size_t threads, size_t settleLimit, size_t hopLimit)
+    : directed(graph.isDirected()), numShortcuts(0) {
+    const size_t n = graph.getNumVertices();
+    if (n == 0) {
+        throw std::invalid_argument("Graph cannot be empty");
+    }
+    if (threads == 0) threads = hardwareThreads();
+
+    Contractor<D> contractor(n, settleLimit, hopLimit);
+    graph.visit([&](const auto& g) {
+        for (size_t u = 0; u < n; ++u) {
+            const uint32_t from = static_cast<uint32_t>(graph.toOriginal(static_cast<int>(u)));
+            g.forEachNeighbor(u, [&](size_t v, W weight) {
+                const uint32_t to = static_cast<uint32_t>(graph.toOriginal(static_cast<int>(v)));
+                if (to == from) return;
+                contractor.out[from].push_back({ to, static_cast<D>(weight), -1 });
+                contractor.in[to].push_back({ from, static_cast<D>(weight), -1 });
+            });
+        }
+    });
+
+    myVector<WitnessSearch<D>> searches(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        searches[t].init(n);
+    }
+    forEachWithSearch(n, threads, searches, [&](size_t v, WitnessSearch<D>& search) {
+        contractor.priority[v] = contractor.computePriority(static_cast<uint32_t>(v), search);
+    });
+
+    rank.resize(n);
+    myVector<uint32_t> remaining(n);
+    for (size_t v = 0; v < n; ++v) {
+        remaining[v] = static_cast<uint32_t>(v);
+    }
+    myVector<uint8_t> queued(n, 0);
+    uint32_t nextRank = 0;
+    while (!remaining.empty()) {
+        myVector<uint8_t> minimum(remaining.size(), 0);
+        parallelFor(remaining.size(), threads, [&](size_t i) {
+            minimum[i] = contractor.isLocalMinimum(remaining[i]) ? 1 : 0;
+        });
+        myVector<uint32_t> round;
+        myVector<uint32_t> rest;
+        for (size_t i = 0; i < remaining.size(); ++i) {
+            (minimum[i] ? round : rest).push_back(remaining[i]);
+        }
+        for (size_t i = 0; i < round.size(); ++i) {
+            contractor.state[round[i]] = CONTRACTING;
+        }
+
+        myVector<myVector<Shortcut<D>>> shortcuts(round.size());
+        forEachWithSearch(round.size(), threads, searches, [&](size_t i, WitnessSearch<D>& search) {
+            contractor.findShortcuts(round[i], search, &shortcuts[i]);
+        });
+
+        myVector<uint32_t> changed;
+        for (size_t i = 0; i < round.size(); ++i) {
+            rank[round[i]] = nextRank++;
+            contractor.contract(round[i], shortcuts[i], queued, changed);
+        }
+        forEachWithSearch(changed.size(), threads, searches, [&](size_t i, WitnessSearch<D>& search) {
+            contractor.priority[changed[i]] = contractor.computePriority(changed[i], search);
+        });
+        for (size_t i = 0; i < changed.size(); ++i) {
+            queued[changed[i]] = 0;
+        }
+        remaining.swap(rest);
+    }
+
+    auto flatten = [&](ArcList& arcs, myVector<myVector<WorkArc<D>>>& lists) {
+        arcs.offsets.resize(n + 1);
+        arcs.offsets[0] = 0;
+        for (size_t v = 0; v < n; ++v) {
+            arcs.offsets[v + 1] = arcs.offsets[v] + lists[v].size();
+        }
+        const size_t total = static_cast<size_t>(arcs.offsets[n]);
+        arcs.targets.resize(total);
+        arcs.weights.resize(total);
+        arcs.middles.resize(total);
+        for (size_t v = 0; v < n; ++v) {
+            myVector<WorkArc<D>>& row = lists[v];
+            std::sort(row.data(), row.data() + row.size(),
+                [](const WorkArc<D>& a, const WorkArc<D>& b) { return a.vertex < b.vertex; });
+            for (size_t i = 0; i < row.size(); ++i) {
+                const size_t at = static_cast<size_t>(arcs.offsets[v]) + i;
+                arcs.targets[at] = row[i].vertex;
+                arcs.weights[at] = row[i].weight;
+                arcs.middles[at] = row[i].middle;
+                if (row[i].middle != -1) ++numShortcuts;
+            }
+            myVector<WorkArc<D>>().swap(row);
+        }
+    };
+    flatten(up, contractor.out);
+    flatten(down, contractor.in);
+}
+
+template <typename W, typename D>
+uint64_t BasicContractionHierarchy<W, D>::findArc(const ArcList& arcs, size_t v, size_t target) {
+    const uint32_t* begin = arcs.targets.data() + arcs.offsets[v];
+    const uint32_t* end = arcs.targets.data() + arcs.offsets[v + 1];
+    const uint32_t* found = std::lower_bound(begin, end, static_cast<uint32_t>(target));
+    if (found == end || *found != target) {
+        throw std::logic_error("Edge does not exist");
+    }
+    return static_cast<uint64_t>(found - arcs.targets.data());
+}
+
+// Shortcuts are expanded with an explicit stack, left half first, so deep hierarchies cannot overflow the call stack.
+template <typename W, typename D>
+void BasicContractionHierarchy<W, D>::unpackArc(size_t u, size_t v, myVector<int>& path) const {
+    myVector<uint32_t> pending;
+    pending.push_back(static_cast<uint32_t>(v));
+    pending.push_back(static_cast<uint32_t>(u));
+    while (!pending.empty()) {
+        const uint32_t from = pending.back();
+        pending.pop_back();
+        const uint32_t to = pending.back();
+        pending.pop_back();
+        const int32_t middle = rank[from] < rank[to] ? up.middles[findArc(up, from, to)] : down.middles[findArc(down, to, from)];
+        if (middle == -1) {
+            path.push_back(static_cast<int>(to));
+            continue;
+        }
+        pending.push_back(to);
+        pending.push_back(static_cast<uint32_t>(middle));
+        pending.push_back(static_cast<uint32_t>(middle));
+        pending.push_back(from);
+    }
+}
+
+template <typename W, typename D>
+BasicChQuery<W, D>::BasicChQuery(const BasicContractionHierarchy<W, D>& hierarchy, int d)
+    : hierarchy(hierarchy), forwardQueue(d), backwardQueue(d),
+      forwardDist(hierarchy.getNumVertices(), WeightTraits<D>::infinity()),
+      backwardDist(hierarchy.getNumVertices(), WeightTraits<D>::infinity()),
+      forwardParent(hierarchy.getNumVertices(), -1), backwardParent(hierarchy.getNumVertices(), -1), lastSettled(0) {
+}
+
+template <typename W, typename D>
+void BasicChQuery<W, D>::checkVertices(int source, int target) const {
+    const int n = static_cast<int>(hierarchy.getNumVertices());
+    if (source < 0 || source >= n) {
+        throw std::out_of_range("Start vertex out of range");
+    }
+    if (target < 0 || target >= n) {
+        throw std::out_of_range("Target vertex out of range");
+    }
+}
+
+template <typename W, typename D>
+void BasicChQuery<W, D>::reset() {
+    for (size_t i = 0; i < touched.size(); ++i) {
+        const uint32_t v = touched[i];
+        forwardDist[v] = WeightTraits<D>::infinity();
+        backwardDist[v] = WeightTraits<D>::infinity();
+        forwardParent[v] = -1;
+        backwardParent[v] = -1;
+    }
+    touched.clear();
+    forwardQueue.clear();
+    backwardQueue.clear();
+}
+
+// The directions alternate; each stops once its queue minimum reaches the best meeting distance.
+template <typename W, typename D>
+int BasicChQuery<W, D>::search(int source, int target, D& best) {
+    reset();
+    lastSettled = 0;
+    const D infinity = WeightTraits<D>::infinity();
+    forwardDist[source] = 0;
+    backwardDist[target] = 0;
+    touched.push_back(static_cast<uint32_t>(source));
+    touched.push_back(static_cast<uint32_t>(target));
+    forwardQueue.push({ source, 0 });
+    backwardQueue.push({ target, 0 });
+
+    best = infinity;
+    int meeting = -1;
+    bool forwardTurn = true;
+    while (true) {
+        const bool forwardLive = !forwardQueue.empty() && forwardQueue.top().distance < best;
+        const bool backwardLive = !backwardQueue.empty() && backwardQueue.top().distance < best;
+        if (!forwardLive && !backwardLive) break;
+        const bool forward = forwardLive && (forwardTurn || !backwardLive);
+        forwardTurn = !forwardTurn;
+
+        DHeap<Node>& queue = forward ? forwardQueue : backwardQueue;
+        myVector<D>& dist = forward ? forwardDist : backwardDist;
+        myVector<int>& parent = forward ? forwardParent : backwardParent;
+        const myVector<D>& other = forward ? backwardDist : forwardDist;
+
+        const Node current = queue.top();
+        queue.pop();
+        const int u = current.vertex;
+        if (current.distance != dist[u]) continue;
+        ++lastSettled;
+        if (other[u] != infinity) {
+            const D total = addDistance(dist[u], other[u]);
+            if (total < best) {
+                best = total;
+                meeting = u;
+            }
+        }
+
+        bool stalled = false;
+        auto stall = [&](size_t x, D weight) {
+            if (!stalled && dist[x] != infinity && addDistance(dist[x], weight) < dist[u]) stalled = true;
+        };
+        if (forward) {
+            hierarchy.forEachDownArc(static_cast<size_t>(u), stall);
+        }
+        else {
+            hierarchy.forEachUpArc(static_cast<size_t>(u), stall);
+        }
+        if (stalled) continue;
+
+        auto relax = [&](size_t x, D weight) {
+            const D candidate = addDistance(dist[u], weight);
+            if (candidate < dist[x]) {
+                if (forwardDist[x] == infinity && backwardDist[x] == infinity) touched.push_back(static_cast<uint32_t>(x));
+                dist[x] = candidate;
+                parent[x] = u;
+                queue.push({ static_cast<int>(x), candidate });
+            }
+        };
+        if (forward) {
+            hierarchy.forEachUpArc(static_cast<size_t>(u), relax);
+        }
+        else {
+            hierarchy.forEachDownArc(static_cast<size_t>(u), relax);
+        }
+    }
+    return meeting;
+}
+
+template <typename W, typename D>
+typename BasicChQuery<W, D>::PathResult BasicChQuery<W, D>::shortestPath(int source, int target) {
+    checkVertices(source, target);
+    D best;
+    const int meeting = search(source, target, best);
+    PathResult result;
+    if (meeting == -1) {
+        result.distance = WeightTraits<D>::unreachable();
+        return result;
+    }
+    result.distance = best;
+
+    myVector<int> upward;
+    for (int v = meeting; v != -1; v = forwardParent[v]) {
+        upward.push_back(v);
+    }
+    result.path.push_back(source);
+    for (size_t i = upward.size() - 1; i > 0; --i) {
+        hierarchy.unpackArc(static_cast<size_t>(upward[i]), static_cast<size_t>(upward[i - 1]), result.path);
+    }
+    for (int v = meeting; backwardParent[v] != -1; v = backwardParent[v]) {
+        hierarchy.unpackArc(static_cast<size_t>(v), static_cast<size_t>(backwardParent[v]), result.path);
+    }
+    return result;
+}
+
+template <typename W, typename D>
+D BasicChQuery<W, D>::distance(int source, int target) {
+    checkVertices(source, target);
+    D best;
+    return search(source, target, best) == -1 ? WeightTraits<D>::unreachable() : best;
+}
+
+template class BasicContractionHierarchy<uint16_t, uint32_t>;
+template class BasicContractionHierarchy<uint16_t, uint64_t>;
+template class BasicContractionHierarchy<uint32_t, uint32_t>;
+template class BasicContractionHierarchy<uint32_t, uint64_t>;
+template class BasicContractionHierarchy<int, int>;
+template class BasicContractionHierarchy<int, int64_t>;
+template class BasicContractionHierarchy<int64_t, int64_t>;
+template class BasicContractionHierarchy<float, float>;
+template class BasicContractionHierarchy<float, double>;
+template class BasicContractionHierarchy<double, double>;
+
+template class BasicChQuery<uint16_t, uint32_t>;
+template class BasicChQuery<uint16_t, uint64_t>;
+template class BasicChQuery<uint32_t, uint32_t>;
+template class BasicChQuery<uint32_t, uint64_t>;
+template class BasicChQuery<int, int>;
+template class BasicChQuery<int, int64_t>;
+template class BasicChQuery<int64_t, int64_t>;
+template class BasicChQuery<float, float>;
+template class BasicChQuery<float, double>;
+template class BasicChQuery<double, double>;
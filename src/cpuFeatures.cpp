@@ -0,0 +1,40 @@
+#include "cpuFeatures.h"
+#if defined(_MSC_VER) && SIMD_X86
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace {
+
+SimdLevel probe() {
+#if SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    return SIMD_SCALAR;
+#elif SIMD_X86
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (maxLeaf < 7 || !osxsave || !avx) return SIMD_SCALAR;
+    // The operating system must save the YMM (and for AVX-512 the opmask and ZMM) state.
+    const unsigned long long xcr0 = _xgetbv(0);
+    if ((xcr0 & 0x6) != 0x6) return SIMD_SCALAR;
+    __cpuidex(info, 7, 0);
+    if ((info[1] & (1 << 16)) && (xcr0 & 0xE6) == 0xE6) return SIMD_AVX512;
+    if (info[1] & (1 << 5)) return SIMD_AVX2;
+    return SIMD_SCALAR;
+#else
+    return SIMD_SCALAR;
+#endif
+}
+
+}
+
+SimdLevel detectSimdLevel() {
+    static const SimdLevel level = probe();
+    return level;
+}
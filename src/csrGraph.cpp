@@ -0,0 +1,210 @@
+﻿#include "csrGraph.h"
+#include "parallel.h"
+#include <iostream>
+#include <limits>
+
+template <typename W>
+BasicCsrGraph<W>::BasicCsrGraph(size_t vertices, bool directed, std::shared_ptr<const Storage> storage)
+    : numVertices(vertices), directed(directed), numArcs(storage->targets.size()),
+      offsets(storage->offsets.data()), targets(storage->targets.data()), weights(storage->weights.data()),
+      reverseOffsets(storage->reverseOffsets.data()), reverseTargets(storage->reverseTargets.data()),
+      reverseWeights(storage->reverseWeights.data()), owner(std::move(storage)) {
+}
+
+template <typename W>
+BasicCsrGraph<W>::BasicCsrGraph(size_t vertices, bool directed, size_t arcs, std::shared_ptr<const void> owner)
+    : numVertices(vertices), directed(directed), numArcs(arcs), offsets(nullptr), targets(nullptr), weights(nullptr),
+      reverseOffsets(nullptr), reverseTargets(nullptr), reverseWeights(nullptr), owner(std::move(owner)) {
+}
+
+template <typename W>
+BasicCsrGraph<W>::BasicCsrGraph(const BasicGraph<W>& dense)
+    : BasicCsrGraph(dense.getNumVertices(), dense.isDirected(), storageFrom(dense)) {
+}
+
+template <typename W>
+bool BasicCsrGraph<W>::isConnected() const {
+    myVector<bool> visited(numVertices, false);
+    Stack<size_t> stack;
+    stack.push(0);
+    visited[0] = true;
+    size_t count = 1;
+
+    auto visit = [&](size_t neighbor, W) {
+        if (!visited[neighbor]) {
+            visited[neighbor] = true;
+            stack.push(neighbor);
+            count++;
+        }
+    };
+
+    while (!stack.empty()) {
+        size_t current = stack.top();
+        stack.pop();
+
+        forEachNeighbor(current, visit);
+        if (directed) {
+            forEachInNeighbor(current, visit);
+        }
+    }
+
+    return count == numVertices;
+}
+
+template <typename W>
+void BasicCsrGraph<W>::printGraph() const {
+    std::cout << "Список смежности (" << numVertices << " вершин):\n";
+    for (size_t u = 0; u < numVertices; ++u) {
+        std::cout << u << ":";
+        forEachNeighbor(u, [](size_t v, W weight) {
+            std::cout << " " << v << "(" << weight << ")";
+        });
+        std::cout << "\n";
+    }
+}
+
+template <typename W>
+W BasicCsrGraph<W>::getEdgeWeight(size_t u, size_t v) const {
+    if (u >= numVertices || v >= numVertices) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (u == v) {
+        return 0;
+    }
+
+    uint64_t left = offsets[u];
+    uint64_t right = offsets[u + 1];
+    while (left < right) {
+        uint64_t mid = left + (right - left) / 2;
+        if (targets[mid] < v) {
+            left = mid + 1;
+        }
+        else {
+            right = mid;
+        }
+    }
+
+    if (left < offsets[u + 1] && targets[left] == v) {
+        return weights[left];
+    }
+    return WeightTraits<W>::noEdge();
+}
+
+template <typename W>
+size_t BasicCsrGraph<W>::getInDegree(size_t v) const {
+    if (!directed) {
+        return getDegree(v);
+    }
+    return static_cast<size_t>(reverseOffsets[v + 1] - reverseOffsets[v]);
+}
+
+template <typename W>
+myVector<int> BasicCsrGraph<W>::getPath(int start, int end, const myVector<int>& predecessors) const {
+    return reconstructPath(start, end, predecessors);
+}
+
+template <typename W>
+BasicCsrGraphBuilder<W>::BasicCsrGraphBuilder(size_t vertices, bool directed) : numVertices(vertices), directed(directed) {
+    if (vertices == 0) {
+        throw std::invalid_argument("Number of vertices must be positive");
+    }
+    if (vertices > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("Number of vertices exceeds 32-bit vertex ids");
+    }
+}
+
+template <typename W>
+void BasicCsrGraphBuilder<W>::addEdge(size_t u, size_t v, W weight) {
+    if (!WeightTraits<W>::isValidWeight(weight)) {
+        throw std::invalid_argument("Edge weight must be positive");
+    }
+    if (u >= numVertices || v >= numVertices) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (u == v) {
+        throw std::invalid_argument("Self-loops are not supported");
+    }
+    edges.push_back({ static_cast<uint32_t>(u), static_cast<uint32_t>(v), weight });
+}
+
+template <typename W>
+void BasicCsrGraphBuilder<W>::buildAdjacency(bool forward, bool backward, size_t threads, myVector<uint64_t>& offsets,
+    myVector<uint32_t>& targets, myVector<W>& weights) const {
+    struct Arc {
+        uint32_t target;
+        W weight;
+    };
+
+    offsets = myVector<uint64_t>(numVertices + 1, 0);
+    for (size_t i = 0; i < edges.size(); ++i) {
+        if (forward) offsets[edges[i].u + 1]++;
+        if (backward) offsets[edges[i].v + 1]++;
+    }
+    for (size_t u = 0; u < numVertices; ++u) {
+        offsets[u + 1] += offsets[u];
+    }
+
+    myVector<Arc> arcs(static_cast<size_t>(offsets[numVertices]));
+    myVector<uint64_t> cursor(offsets);
+    for (size_t i = 0; i < edges.size(); ++i) {
+        const Edge& e = edges[i];
+        if (forward) arcs[cursor[e.u]++] = { e.v, e.weight };
+        if (backward) arcs[cursor[e.v]++] = { e.u, e.weight };
+    }
+
+    parallelFor(numVertices, threads, [&](size_t u) {
+        std::sort(arcs.data() + offsets[u], arcs.data() + offsets[u + 1], [](const Arc& a, const Arc& b) {
+            return a.target < b.target || (a.target == b.target && a.weight < b.weight);
+        });
+    });
+
+    uint64_t write = 0;
+    for (size_t u = 0; u < numVertices; ++u) {
+        const uint64_t begin = offsets[u];
+        const uint64_t end = offsets[u + 1];
+        offsets[u] = write;
+
+        for (uint64_t i = begin; i < end; ++i) {
+            if (write > offsets[u] && arcs[write - 1].target == arcs[i].target) {
+                continue;
+            }
+            arcs[write++] = arcs[i];
+        }
+    }
+    offsets[numVertices] = write;
+
+    targets = myVector<uint32_t>(static_cast<size_t>(write));
+    weights = myVector<W>(static_cast<size_t>(write));
+    for (uint64_t i = 0; i < write; ++i) {
+        targets[i] = arcs[i].target;
+        weights[i] = arcs[i].weight;
+    }
+}
+
+template <typename W>
+BasicCsrGraph<W> BasicCsrGraphBuilder<W>::build(size_t threads) {
+    auto storage = std::make_shared<typename BasicCsrGraph<W>::Storage>();
+    if (directed) {
+        buildAdjacency(true, false, threads, storage->offsets, storage->targets, storage->weights);
+        buildAdjacency(false, true, threads, storage->reverseOffsets, storage->reverseTargets, storage->reverseWeights);
+    }
+    else {
+        buildAdjacency(true, true, threads, storage->offsets, storage->targets, storage->weights);
+    }
+    edges = myVector<Edge>();
+    return BasicCsrGraph<W>(numVertices, directed, std::move(storage));
+}
+
+template class BasicCsrGraph<uint16_t>;
+template class BasicCsrGraph<uint32_t>;
+template class BasicCsrGraph<int>;
+template class BasicCsrGraph<int64_t>;
+template class BasicCsrGraph<float>;
+template class BasicCsrGraph<double>;
+
+template class BasicCsrGraphBuilder<uint16_t>;
+template class BasicCsrGraphBuilder<uint32_t>;
+template class BasicCsrGraphBuilder<int>;
+template class BasicCsrGraphBuilder<int64_t>;
+template class BasicCsrGraphBuilder<float>;
+template class BasicCsrGraphBuilder<double>;
@@ -0,0 +1,237 @@
+#include "deltaStepping.h"
+#include "parallel.h"
+#include <atomic>
+#include <limits>
+
+namespace {
+
+template <typename D>
+struct Relaxation {
+    uint32_t target;
+    uint32_t from;
+    D distance;
+};
+
+template <typename D>
+struct Worker {
+    // Cyclic: every live distance lies within the largest arc weight of the current bucket.
+    myVector<myVector<uint32_t>> buckets;
+    myVector<uint32_t> frontier;
+    // Vertices taken out of the current bucket, whose heavy arcs are relaxed once it stays empty.
+    myVector<uint32_t> removed;
+    // Relaxations for the vertices of each owner, drained by that owner.
+    myVector<myVector<Relaxation<D>>> outbox;
+    uint64_t nextBucket;
+    bool pending;
+};
+
+const uint64_t noBucket = std::numeric_limits<uint64_t>::max();
+const uint64_t maxBuckets = uint64_t(1) << 24;
+
+template <typename D>
+uint64_t bucketIndex(D distance, D delta) {
+    return static_cast<uint64_t>(distance / delta);
+}
+
+}
+
+template <typename W, typename D>
+BasicDeltaStepping<W, D>::BasicDeltaStepping(BasicGraphRef<W> graph, size_t threads)
+    : graph(graph), threads(threads ? threads : hardwareThreads()), maxWeight(W()), defaultDelta(D()), weightVersion(0) {
+    if (graph.getNumVertices() == 0) {
+        throw std::invalid_argument("Graph cannot be empty");
+    }
+    scanWeights();
+}
+
+template <typename W, typename D>
+void BasicDeltaStepping<W, D>::scanWeights() const {
+    const size_t n = graph.getNumVertices();
+    maxWeight = W();
+    size_t arcs = 0;
+    graph.visit([&](const auto& g) {
+        for (size_t u = 0; u < n; ++u) {
+            g.forEachNeighbor(u, [&](size_t, W weight) {
+                if (weight > maxWeight) maxWeight = weight;
+                ++arcs;
+            });
+        }
+    });
+    const double averageDegree = arcs > n ? static_cast<double>(arcs) / n : 1.0;
+    defaultDelta = static_cast<D>(static_cast<double>(maxWeight) / averageDegree);
+    if (!(defaultDelta > 0)) defaultDelta = static_cast<D>(maxWeight > 0 ? maxWeight : 1);
+    weightVersion = graph.getVersion();
+}
+
+template <typename W, typename D>
+myVector<D> BasicDeltaStepping<W, D>::shortestPathsWithPredecessors(int start, myVector<int>& predecessors, D delta) {
+    const int n = static_cast<int>(graph.getNumVertices());
+    if (start < 0 || start >= n) {
+        throw std::out_of_range("Start vertex out of range");
+    }
+    refreshWeights();
+    if (delta == D()) {
+        delta = defaultDelta;
+    }
+    else if (!WeightTraits<D>::isValidWeight(delta)) {
+        throw std::invalid_argument("Delta must be positive");
+    }
+    if (bucketIndex(static_cast<D>(maxWeight), delta) >= maxBuckets) {
+        throw std::invalid_argument("Delta is too small for the largest edge weight");
+    }
+
+    myVector<D> dist(n, WeightTraits<D>::infinity());
+    myVector<int> links(n, -1);
+    graph.visit([&](const auto& g) { run(g, graph.toInternal(start), delta, dist, links); });
+
+    for (int v = 0; v < n; ++v) {
+        if (dist[v] == WeightTraits<D>::infinity()) dist[v] = WeightTraits<D>::unreachable();
+    }
+    const BasicReorderedGraph<W>* reordered = graph.getReordering();
+    if (!reordered) {
+        predecessors = links;
+        return dist;
+    }
+    predecessors = reordered->verticesToOriginal(links);
+    return reordered->valuesToOriginal(dist);
+}
+
+// Every step between two barriers touches only the calling thread's vertices and buffers. A step that
+// throws (distance overflow) raises a flag; the last thread at each barrier copies it into stop, so all
+// threads read the same value and leave at the same barrier.
+template <typename W, typename D>
+template <typename G>
+void BasicDeltaStepping<W, D>::run(const G& g, int start, D delta, myVector<D>& dist, myVector<int>& predecessors) const {
+    const size_t n = g.getNumVertices();
+    const size_t count = threads < n ? threads : n;
+    const uint64_t slots = bucketIndex(static_cast<D>(maxWeight), delta) + 3;
+    // Blocks of 64 consecutive vertices per owner keep the slices cache-friendly on reordered graphs.
+    auto owner = [count](size_t v) { return (v >> 6) % count; };
+
+    myVector<Worker<D>> workers(count);
+    for (size_t t = 0; t < count; ++t) {
+        workers[t].buckets.resize(static_cast<size_t>(slots));
+        workers[t].outbox.resize(count);
+    }
+    myVector<D> relaxedAt(n, WeightTraits<D>::infinity());
+    myVector<uint64_t> removedFrom(n, noBucket);
+    dist[start] = 0;
+    workers[owner(start)].buckets[0].push_back(static_cast<uint32_t>(start));
+
+    Barrier barrier(count);
+    std::atomic<bool> failed(false);
+    bool stop = false;
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    parallelFor(count, count, [&](size_t t) {
+        Worker<D>& self = workers[t];
+        auto guarded = [&](auto&& step) {
+            if (failed.load()) return;
+            try {
+                step();
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+                failed.store(true);
+            }
+        };
+        auto sync = [&]() {
+            barrier.wait([&] { stop = failed.load(); });
+            return !stop;
+        };
+        auto relax = [&](uint32_t v, bool light) {
+            g.forEachNeighbor(v, [&](size_t w, W weight) {
+                if ((static_cast<D>(weight) <= delta) != light) return;
+                self.outbox[owner(w)].push_back({ static_cast<uint32_t>(w), v, addDistance(dist[v], weight) });
+            });
+        };
+        auto apply = [&]() {
+            for (size_t s = 0; s < count; ++s) {
+                myVector<Relaxation<D>>& inbox = workers[s].outbox[t];
+                for (size_t i = 0; i < inbox.size(); ++i) {
+                    const Relaxation<D>& r = inbox[i];
+                    if (r.distance < dist[r.target]) {
+                        dist[r.target] = r.distance;
+                        predecessors[r.target] = static_cast<int>(r.from);
+                        self.buckets[static_cast<size_t>(bucketIndex(r.distance, delta) % slots)].push_back(r.target);
+                    }
+                }
+                inbox.clear();
+            }
+        };
+
+        uint64_t current = 0;
+        while (true) {
+            guarded([&]() {
+                self.nextBucket = noBucket;
+                for (uint64_t i = 0; i < slots; ++i) {
+                    if (!self.buckets[static_cast<size_t>((current + i) % slots)].empty()) {
+                        self.nextBucket = current + i;
+                        break;
+                    }
+                }
+            });
+            if (!sync()) return;
+            current = noBucket;
+            for (size_t s = 0; s < count; ++s) {
+                if (workers[s].nextBucket < current) current = workers[s].nextBucket;
+            }
+            if (current == noBucket) return;
+
+            self.removed.clear();
+            while (true) {
+                guarded([&]() {
+                    myVector<uint32_t>& bucket = self.buckets[static_cast<size_t>(current % slots)];
+                    self.frontier.clear();
+                    self.frontier.swap(bucket);
+                    for (size_t i = 0; i < self.frontier.size(); ++i) {
+                        const uint32_t v = self.frontier[i];
+                        // Entries left behind by a later improvement, or already relaxed at this distance, are stale.
+                        if (bucketIndex(dist[v], delta) != current || relaxedAt[v] == dist[v]) continue;
+                        relaxedAt[v] = dist[v];
+                        if (removedFrom[v] != current) {
+                            removedFrom[v] = current;
+                            self.removed.push_back(v);
+                        }
+                        relax(v, true);
+                    }
+                });
+                if (!sync()) return;
+                guarded([&]() {
+                    apply();
+                    self.pending = !self.buckets[static_cast<size_t>(current % slots)].empty();
+                });
+                if (!sync()) return;
+                bool pending = false;
+                for (size_t s = 0; s < count; ++s) {
+                    pending = pending || workers[s].pending;
+                }
+                if (!pending) break;
+            }
+
+            guarded([&]() {
+                for (size_t i = 0; i < self.removed.size(); ++i) {
+                    relax(self.removed[i], false);
+                }
+            });
+            if (!sync()) return;
+            guarded(apply);
+            if (!sync()) return;
+        }
+    });
+
+    if (error) std::rethrow_exception(error);
+}
+
+template class BasicDeltaStepping<uint16_t, uint32_t>;
+template class BasicDeltaStepping<uint16_t, uint64_t>;
+template class BasicDeltaStepping<uint32_t, uint32_t>;
+template class BasicDeltaStepping<uint32_t, uint64_t>;
+template class BasicDeltaStepping<int, int>;
+template class BasicDeltaStepping<int, int64_t>;
+template class BasicDeltaStepping<int64_t, int64_t>;
+template class BasicDeltaStepping<float, float>;
+template class BasicDeltaStepping<float, double>;
+template class BasicDeltaStepping<double, double>;
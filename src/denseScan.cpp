@@ -0,0 +1,397 @@
+#include "denseScan.h"
+#include "simdOps.h"
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+template <typename T>
+struct VectorLane : std::integral_constant<bool, std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value ||
+    std::is_same<T, float>::value || std::is_same<T, double>::value> {
+};
+
+// Lowers best to the least unsettled entry of dist[begin, end), index following its first position.
+template <typename D>
+void scanScalar(const D* dist, const uint64_t* settled, size_t begin, size_t end, D& best, int& index) {
+    for (size_t v = begin; v < end; ++v) {
+        if ((settled[v >> 6] >> (v & 63)) & 1) continue;
+        if (dist[v] < best) {
+            best = dist[v];
+            index = static_cast<int>(v);
+        }
+    }
+}
+
+template <typename D>
+int selectMinScalar(const D* dist, const uint64_t* settled, size_t n) {
+    D best = WeightTraits<D>::infinity();
+    int index = -1;
+    scanScalar(dist, settled, 0, n, best, index);
+    return index;
+}
+
+// Relaxes the arcs of one row to the unsettled vertices of [begin, end).
+template <typename W, typename D>
+void relaxScalar(const W* weights, const uint64_t* arcs, const uint64_t* settled, D* dist, int* predecessors,
+    size_t begin, size_t end, int u, D du, uint64_t* improved) {
+    for (size_t w = begin >> 6; w < (end + 63) >> 6; ++w) {
+        uint64_t open = arcs[w] & ~settled[w];
+        if (w == begin >> 6) open &= ~uint64_t(0) << (begin & 63);
+        if (end - w * 64 < 64) open &= (uint64_t(1) << (end - w * 64)) - 1;
+        while (open) {
+            const size_t v = w * 64 + countTrailingZeros(open);
+            const D candidate = addDistance(du, weights[v]);
+            if (candidate < dist[v]) {
+                dist[v] = candidate;
+                predecessors[v] = u;
+                if (improved) improved[w] |= uint64_t(1) << (v & 63);
+            }
+            open &= open - 1;
+        }
+    }
+}
+
+#if SIMD_X86
+
+// Per-type operations of the vector kernels below. M is the lane mask: a register of all-ones lanes for AVX2,
+// an opmask for AVX-512; lanes() builds one from the low bits of a bitset word and bits() goes back.
+template <typename T>
+struct Avx2Ops;
+
+SIMD_TARGET_AVX2 inline __m256i eightLanes(uint64_t bits) {
+    const __m256i select = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits & 0xFF)), select), select);
+}
+
+SIMD_TARGET_AVX2 inline __m256i fourLanes(uint64_t bits) {
+    const __m256i select = _mm256_setr_epi64x(1, 2, 4, 8);
+    return _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(static_cast<long long>(bits & 0xF)), select), select);
+}
+
+// AVX2 masked stores are slow on several processors, so the masked lanes are blended into a full store.
+template <typename T>
+SIMD_TARGET_AVX2 inline void blendInto(T* p, __m256i mask, __m256i v) {
+    __m256i* at = reinterpret_cast<__m256i*>(p);
+    _mm256_storeu_si256(at, _mm256_blendv_epi8(_mm256_loadu_si256(at), v, mask));
+}
+
+// Four int predecessors under a mask of 64-bit lanes.
+SIMD_TARGET_AVX2 inline void blendFour(int* p, __m256i mask, int u) {
+    __m128i* at = reinterpret_cast<__m128i*>(p);
+    _mm_storeu_si128(at, _mm_blendv_epi8(_mm_loadu_si128(at), _mm_set1_epi32(u), narrowMask(mask)));
+}
+
+template <typename T, typename V>
+SIMD_TARGET_AVX2 T horizontalMin(V v) {
+    T values[sizeof(V) / sizeof(T)];
+    std::memcpy(values, &v, sizeof(V));
+    T best = values[0];
+    for (size_t i = 1; i < sizeof(V) / sizeof(T); ++i) {
+        if (values[i] < best) best = values[i];
+    }
+    return best;
+}
+
+template <>
+struct Avx2Ops<int32_t> {
+    typedef __m256i V;
+    typedef __m256i M;
+    static const size_t width = 8;
+    SIMD_TARGET_AVX2 static M lanes(uint64_t bits) { return eightLanes(bits); }
+    SIMD_TARGET_AVX2 static uint64_t bits(M m) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(m))); }
+    SIMD_TARGET_AVX2 static V load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    SIMD_TARGET_AVX2 static V set1(int32_t x) { return _mm256_set1_epi32(x); }
+    SIMD_TARGET_AVX2 static V add(V a, V b) { return _mm256_add_epi32(a, b); }
+    SIMD_TARGET_AVX2 static M less(M m, V a, V b) { return _mm256_and_si256(m, _mm256_cmpgt_epi32(b, a)); }
+    SIMD_TARGET_AVX2 static M equal(M m, V a, V b) { return _mm256_and_si256(m, _mm256_cmpeq_epi32(a, b)); }
+    SIMD_TARGET_AVX2 static V minOf(V acc, M m, V x) { return _mm256_min_epi32(acc, _mm256_blendv_epi8(acc, x, m)); }
+    SIMD_TARGET_AVX2 static int32_t reduceMin(V v) { return horizontalMin<int32_t>(v); }
+    SIMD_TARGET_AVX2 static void store(int32_t* p, M m, V v) { blendInto(p, m, v); }
+    SIMD_TARGET_AVX2 static void storeVertex(int* p, M m, int u) { blendInto(p, m, _mm256_set1_epi32(u)); }
+    // Sums that wrapped or reached infinity, the ones addDistance rejects.
+    SIMD_TARGET_AVX2 static M overflow(M m, V sum, V base, V infinity) {
+        return _mm256_or_si256(less(m, sum, base), equal(m, sum, infinity));
+    }
+};
+
+template <>
+struct Avx2Ops<int64_t> {
+    typedef __m256i V;
+    typedef __m256i M;
+    static const size_t width = 4;
+    SIMD_TARGET_AVX2 static M lanes(uint64_t bits) { return fourLanes(bits); }
+    SIMD_TARGET_AVX2 static uint64_t bits(M m) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(m))); }
+    SIMD_TARGET_AVX2 static V load(const int64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    SIMD_TARGET_AVX2 static V set1(int64_t x) { return _mm256_set1_epi64x(x); }
+    SIMD_TARGET_AVX2 static V add(V a, V b) { return _mm256_add_epi64(a, b); }
+    SIMD_TARGET_AVX2 static M less(M m, V a, V b) { return _mm256_and_si256(m, _mm256_cmpgt_epi64(b, a)); }
+    SIMD_TARGET_AVX2 static M equal(M m, V a, V b) { return _mm256_and_si256(m, _mm256_cmpeq_epi64(a, b)); }
+    SIMD_TARGET_AVX2 static V minOf(V acc, M m, V x) { return _mm256_blendv_epi8(acc, x, less(m, x, acc)); }
+    SIMD_TARGET_AVX2 static int64_t reduceMin(V v) { return horizontalMin<int64_t>(v); }
+    SIMD_TARGET_AVX2 static void store(int64_t* p, M m, V v) { blendInto(p, m, v); }
+    SIMD_TARGET_AVX2 static void storeVertex(int* p, M m, int u) { blendFour(p, m, u); }
+    SIMD_TARGET_AVX2 static M overflow(M m, V sum, V base, V infinity) {
+        return _mm256_or_si256(less(m, sum, base), equal(m, sum, infinity));
+    }
+};
+
+template <>
+struct Avx2Ops<float> {
+    typedef __m256 V;
+    typedef __m256 M;
+    static const size_t width = 8;
+    SIMD_TARGET_AVX2 static M lanes(uint64_t bits) { return _mm256_castsi256_ps(eightLanes(bits)); }
+    SIMD_TARGET_AVX2 static uint64_t bits(M m) { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+    SIMD_TARGET_AVX2 static V load(const float* p) { return _mm256_loadu_ps(p); }
+    SIMD_TARGET_AVX2 static V set1(float x) { return _mm256_set1_ps(x); }
+    SIMD_TARGET_AVX2 static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    SIMD_TARGET_AVX2 static M less(M m, V a, V b) { return _mm256_and_ps(m, _mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+    SIMD_TARGET_AVX2 static M equal(M m, V a, V b) { return _mm256_and_ps(m, _mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+    SIMD_TARGET_AVX2 static V minOf(V acc, M m, V x) { return _mm256_min_ps(acc, _mm256_blendv_ps(acc, x, m)); }
+    SIMD_TARGET_AVX2 static float reduceMin(V v) { return horizontalMin<float>(v); }
+    SIMD_TARGET_AVX2 static void store(float* p, M m, V v) { _mm256_storeu_ps(p, _mm256_blendv_ps(_mm256_loadu_ps(p), v, m)); }
+    SIMD_TARGET_AVX2 static void storeVertex(int* p, M m, int u) { blendInto(p, _mm256_castps_si256(m), _mm256_set1_epi32(u)); }
+    SIMD_TARGET_AVX2 static M overflow(M, V, V, V) { return _mm256_setzero_ps(); }
+};
+
+template <>
+struct Avx2Ops<double> {
+    typedef __m256d V;
+    typedef __m256d M;
+    static const size_t width = 4;
+    SIMD_TARGET_AVX2 static M lanes(uint64_t bits) { return _mm256_castsi256_pd(fourLanes(bits)); }
+    SIMD_TARGET_AVX2 static uint64_t bits(M m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+    SIMD_TARGET_AVX2 static V load(const double* p) { return _mm256_loadu_pd(p); }
+    SIMD_TARGET_AVX2 static V set1(double x) { return _mm256_set1_pd(x); }
+    SIMD_TARGET_AVX2 static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    SIMD_TARGET_AVX2 static M less(M m, V a, V b) { return _mm256_and_pd(m, _mm256_cmp_pd(a, b, _CMP_LT_OQ)); }
+    SIMD_TARGET_AVX2 static M equal(M m, V a, V b) { return _mm256_and_pd(m, _mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+    SIMD_TARGET_AVX2 static V minOf(V acc, M m, V x) { return _mm256_min_pd(acc, _mm256_blendv_pd(acc, x, m)); }
+    SIMD_TARGET_AVX2 static double reduceMin(V v) { return horizontalMin<double>(v); }
+    SIMD_TARGET_AVX2 static void store(double* p, M m, V v) { _mm256_storeu_pd(p, _mm256_blendv_pd(_mm256_loadu_pd(p), v, m)); }
+    SIMD_TARGET_AVX2 static void storeVertex(int* p, M m, int u) { blendFour(p, _mm256_castpd_si256(m), u); }
+    SIMD_TARGET_AVX2 static M overflow(M, V, V, V) { return _mm256_setzero_pd(); }
+};
+
+template <typename T>
+struct Avx512Ops;
+
+template <>
+struct Avx512Ops<int32_t> {
+    typedef __m512i V;
+    typedef __mmask16 M;
+    static const size_t width = 16;
+    SIMD_TARGET_AVX512 static M lanes(uint64_t bits) { return static_cast<M>(bits); }
+    SIMD_TARGET_AVX512 static uint64_t bits(M m) { return m; }
+    SIMD_TARGET_AVX512 static V load(const int32_t* p) { return _mm512_loadu_si512(p); }
+    SIMD_TARGET_AVX512 static V set1(int32_t x) { return _mm512_set1_epi32(x); }
+    SIMD_TARGET_AVX512 static V add(V a, V b) { return _mm512_add_epi32(a, b); }
+    SIMD_TARGET_AVX512 static M less(M m, V a, V b) { return _mm512_mask_cmplt_epi32_mask(m, a, b); }
+    SIMD_TARGET_AVX512 static M equal(M m, V a, V b) { return _mm512_mask_cmpeq_epi32_mask(m, a, b); }
+    SIMD_TARGET_AVX512 static V minOf(V acc, M m, V x) { return _mm512_mask_min_epi32(acc, m, acc, x); }
+    SIMD_TARGET_AVX512 static int32_t reduceMin(V v) { return _mm512_reduce_min_epi32(v); }
+    SIMD_TARGET_AVX512 static void store(int32_t* p, M m, V v) { _mm512_mask_storeu_epi32(p, m, v); }
+    SIMD_TARGET_AVX512 static void storeVertex(int* p, M m, int u) { _mm512_mask_storeu_epi32(p, m, _mm512_set1_epi32(u)); }
+    SIMD_TARGET_AVX512 static M overflow(M m, V sum, V base, V infinity) {
+        return static_cast<M>(less(m, sum, base) | equal(m, sum, infinity));
+    }
+};
+
+template <>
+struct Avx512Ops<int64_t> {
+    typedef __m512i V;
+    typedef __mmask8 M;
+    static const size_t width = 8;
+    SIMD_TARGET_AVX512 static M lanes(uint64_t bits) { return static_cast<M>(bits); }
+    SIMD_TARGET_AVX512 static uint64_t bits(M m) { return m; }
+    SIMD_TARGET_AVX512 static V load(const int64_t* p) { return _mm512_loadu_si512(p); }
+    SIMD_TARGET_AVX512 static V set1(int64_t x) { return _mm512_set1_epi64(x); }
+    SIMD_TARGET_AVX512 static V add(V a, V b) { return _mm512_add_epi64(a, b); }
+    SIMD_TARGET_AVX512 static M less(M m, V a, V b) { return _mm512_mask_cmplt_epi64_mask(m, a, b); }
+    SIMD_TARGET_AVX512 static M equal(M m, V a, V b) { return _mm512_mask_cmpeq_epi64_mask(m, a, b); }
+    SIMD_TARGET_AVX512 static V minOf(V acc, M m, V x) { return _mm512_mask_min_epi64(acc, m, acc, x); }
+    SIMD_TARGET_AVX512 static int64_t reduceMin(V v) { return _mm512_reduce_min_epi64(v); }
+    SIMD_TARGET_AVX512 static void store(int64_t* p, M m, V v) { _mm512_mask_storeu_epi64(p, m, v); }
+    SIMD_TARGET_AVX512 static void storeVertex(int* p, M m, int u) { _mm512_mask_cvtepi64_storeu_epi32(p, m, _mm512_set1_epi64(u)); }
+    SIMD_TARGET_AVX512 static M overflow(M m, V sum, V base, V infinity) {
+        return static_cast<M>(less(m, sum, base) | equal(m, sum, infinity));
+    }
+};
+
+template <>
+struct Avx512Ops<float> {
+    typedef __m512 V;
+    typedef __mmask16 M;
+    static const size_t width = 16;
+    SIMD_TARGET_AVX512 static M lanes(uint64_t bits) { return static_cast<M>(bits); }
+    SIMD_TARGET_AVX512 static uint64_t bits(M m) { return m; }
+    SIMD_TARGET_AVX512 static V load(const float* p) { return _mm512_loadu_ps(p); }
+    SIMD_TARGET_AVX512 static V set1(float x) { return _mm512_set1_ps(x); }
+    SIMD_TARGET_AVX512 static V add(V a, V b) { return _mm512_add_ps(a, b); }
+    SIMD_TARGET_AVX512 static M less(M m, V a, V b) { return _mm512_mask_cmp_ps_mask(m, a, b, _CMP_LT_OQ); }
+    SIMD_TARGET_AVX512 static M equal(M m, V a, V b) { return _mm512_mask_cmp_ps_mask(m, a, b, _CMP_EQ_OQ); }
+    SIMD_TARGET_AVX512 static V minOf(V acc, M m, V x) { return _mm512_mask_min_ps(acc, m, acc, x); }
+    SIMD_TARGET_AVX512 static float reduceMin(V v) { return _mm512_reduce_min_ps(v); }
+    SIMD_TARGET_AVX512 static void store(float* p, M m, V v) { _mm512_mask_storeu_ps(p, m, v); }
+    SIMD_TARGET_AVX512 static void storeVertex(int* p, M m, int u) { _mm512_mask_storeu_epi32(p, m, _mm512_set1_epi32(u)); }
+    SIMD_TARGET_AVX512 static M overflow(M, V, V, V) { return 0; }
+};
+
+template <>
+struct Avx512Ops<double> {
+    typedef __m512d V;
+    typedef __mmask8 M;
+    static const size_t width = 8;
+    SIMD_TARGET_AVX512 static M lanes(uint64_t bits) { return static_cast<M>(bits); }
+    SIMD_TARGET_AVX512 static uint64_t bits(M m) { return m; }
+    SIMD_TARGET_AVX512 static V load(const double* p) { return _mm512_loadu_pd(p); }
+    SIMD_TARGET_AVX512 static V set1(double x) { return _mm512_set1_pd(x); }
+    SIMD_TARGET_AVX512 static V add(V a, V b) { return _mm512_add_pd(a, b); }
+    SIMD_TARGET_AVX512 static M less(M m, V a, V b) { return _mm512_mask_cmp_pd_mask(m, a, b, _CMP_LT_OQ); }
+    SIMD_TARGET_AVX512 static M equal(M m, V a, V b) { return _mm512_mask_cmp_pd_mask(m, a, b, _CMP_EQ_OQ); }
+    SIMD_TARGET_AVX512 static V minOf(V acc, M m, V x) { return _mm512_mask_min_pd(acc, m, acc, x); }
+    SIMD_TARGET_AVX512 static double reduceMin(V v) { return _mm512_reduce_min_pd(v); }
+    SIMD_TARGET_AVX512 static void store(double* p, M m, V v) { _mm512_mask_storeu_pd(p, m, v); }
+    SIMD_TARGET_AVX512 static void storeVertex(int* p, M m, int u) { _mm512_mask_cvtepi64_storeu_epi32(p, m, _mm512_set1_epi64(u)); }
+    SIMD_TARGET_AVX512 static M overflow(M, V, V, V) { return 0; }
+};
+
+// The AVX2 and AVX-512 kernels share their bodies and differ only in the target they are compiled for; a function
+// built for one instruction set does not inline into another, so the macro below stamps out one copy per target.
+// Selection takes two passes: the least distance over whole vectors, then its first position. Relaxation compares
+// the lanes of arcs to unsettled vertices and stores the shorter ones under the mask, so only vectors holding such
+// an arc cost more than a bit test; overflow is checked once per row, as the lanes stored meanwhile do not matter
+// once the search fails.
+#define DENSE_SCAN_KERNELS(SUFFIX, TARGET) \
+template <typename Ops, typename T> \
+TARGET int selectMin##SUFFIX(const T* dist, const uint64_t* settled, size_t n) { \
+    const T infinity = WeightTraits<T>::infinity(); \
+    const size_t chunks = n - n % Ops::width; \
+    typename Ops::V least = Ops::set1(infinity); \
+    for (size_t j = 0; j < chunks; j += Ops::width) { \
+        least = Ops::minOf(least, Ops::lanes(~settled[j >> 6] >> (j & 63)), Ops::load(dist + j)); \
+    } \
+    T best = infinity; \
+    int index = -1; \
+    scanScalar(dist, settled, chunks, n, best, index); \
+    const T chunkBest = Ops::reduceMin(least); \
+    if (!(chunkBest < infinity) || best < chunkBest) return index; \
+    const typename Ops::V wanted = Ops::set1(chunkBest); \
+    for (size_t j = 0; j < chunks; j += Ops::width) { \
+        const uint64_t hit = Ops::bits(Ops::equal(Ops::lanes(~settled[j >> 6] >> (j & 63)), Ops::load(dist + j), wanted)); \
+        if (hit) return static_cast<int>(j + countTrailingZeros(hit)); \
+    } \
+    return index; \
+} \
+\
+template <typename Ops, typename T> \
+TARGET void relaxRow##SUFFIX(const T* weights, const uint64_t* arcs, const uint64_t* settled, T* dist, int* predecessors, \
+    size_t n, int u, T du, uint64_t* improved) { \
+    const uint64_t laneBits = (uint64_t(1) << Ops::width) - 1; \
+    const size_t chunks = n - n % Ops::width; \
+    const typename Ops::V base = Ops::set1(du); \
+    const typename Ops::V infinity = Ops::set1(WeightTraits<T>::infinity()); \
+    uint64_t overflow = 0; \
+    for (size_t j = 0; j < chunks; j += Ops::width) { \
+        const uint64_t open = (arcs[j >> 6] & ~settled[j >> 6]) >> (j & 63); \
+        if (!(open & laneBits)) continue; \
+        const typename Ops::M mask = Ops::lanes(open); \
+        const typename Ops::V candidate = Ops::add(base, Ops::load(weights + j)); \
+        overflow |= Ops::bits(Ops::overflow(mask, candidate, base, infinity)); \
+        const typename Ops::M better = Ops::less(mask, candidate, Ops::load(dist + j)); \
+        Ops::store(dist + j, better, candidate); \
+        Ops::storeVertex(predecessors + j, better, u); \
+        if (improved) improved[j >> 6] |= Ops::bits(better) << (j & 63); \
+    } \
+    if (overflow) throw std::overflow_error("Path length overflows the distance type"); \
+    relaxScalar(weights, arcs, settled, dist, predecessors, chunks, n, u, du, improved); \
+}
+
+DENSE_SCAN_KERNELS(Avx2, SIMD_TARGET_AVX2)
+DENSE_SCAN_KERNELS(Avx512, SIMD_TARGET_AVX512)
+
+#undef DENSE_SCAN_KERNELS
+
+#endif
+
+template <typename D, bool = VectorLane<D>::value>
+struct SelectKernel {
+    static int run(SimdLevel, const D* dist, const uint64_t* settled, size_t n) {
+        return selectMinScalar(dist, settled, n);
+    }
+};
+
+template <typename D>
+struct SelectKernel<D, true> {
+    static int run(SimdLevel level, const D* dist, const uint64_t* settled, size_t n) {
+#if SIMD_X86
+        if (level == SIMD_AVX512) return selectMinAvx512<Avx512Ops<D>>(dist, settled, n);
+        if (level == SIMD_AVX2) return selectMinAvx2<Avx2Ops<D>>(dist, settled, n);
+#else
+        (void)level;
+#endif
+        return selectMinScalar(dist, settled, n);
+    }
+};
+
+template <typename W, typename D, bool = std::is_same<W, D>::value && VectorLane<D>::value>
+struct RelaxKernel {
+    static void run(SimdLevel, const W* weights, const uint64_t* arcs, const uint64_t* settled, D* dist, int* predecessors,
+        size_t n, int u, D du, uint64_t* improved) {
+        relaxScalar(weights, arcs, settled, dist, predecessors, 0, n, u, du, improved);
+    }
+};
+
+template <typename T>
+struct RelaxKernel<T, T, true> {
+    static void run(SimdLevel level, const T* weights, const uint64_t* arcs, const uint64_t* settled, T* dist, int* predecessors,
+        size_t n, int u, T du, uint64_t* improved) {
+#if SIMD_X86
+        if (level == SIMD_AVX512) {
+            relaxRowAvx512<Avx512Ops<T>>(weights, arcs, settled, dist, predecessors, n, u, du, improved);
+            return;
+        }
+        if (level == SIMD_AVX2) {
+            relaxRowAvx2<Avx2Ops<T>>(weights, arcs, settled, dist, predecessors, n, u, du, improved);
+            return;
+        }
+#else
+        (void)level;
+#endif
+        relaxScalar(weights, arcs, settled, dist, predecessors, 0, n, u, du, improved);
+    }
+};
+
+}
+
+template <typename W, typename D>
+BasicDenseScan<W, D>::BasicDenseScan(SimdLevel simd) : simd(VectorLane<D>::value ? supportedSimdLevel(simd) : SIMD_SCALAR) {
+}
+
+template <typename W, typename D>
+int BasicDenseScan<W, D>::selectMin(const D* dist, const uint64_t* settled, size_t n) const {
+    return SelectKernel<D>::run(simd, dist, settled, n);
+}
+
+template <typename W, typename D>
+void BasicDenseScan<W, D>::relaxRow(const BasicGraph<W>& graph, size_t u, D du, const uint64_t* settled, D* dist,
+    int* predecessors, uint64_t* improved) const {
+    const size_t n = graph.getNumVertices();
+    if (improved) {
+        for (size_t w = 0; w < (n + 63) / 64; ++w) improved[w] = 0;
+    }
+    RelaxKernel<W, D>::run(simd, graph.getAdjacencyMatrix()[u], graph.getEdgeBits()[u], settled, dist, predecessors, n,
+        static_cast<int>(u), du, improved);
+}
+
+template class BasicDenseScan<uint16_t, uint32_t>;
+template class BasicDenseScan<uint16_t, uint64_t>;
+template class BasicDenseScan<uint32_t, uint32_t>;
+template class BasicDenseScan<uint32_t, uint64_t>;
+template class BasicDenseScan<int, int>;
+template class BasicDenseScan<int, int64_t>;
+template class BasicDenseScan<int64_t, int64_t>;
+template class BasicDenseScan<float, float>;
+template class BasicDenseScan<float, double>;
+template class BasicDenseScan<double, double>;
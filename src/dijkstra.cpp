@@ -1,43 +1,302 @@
 ﻿#include "dijkstra.h"
+#include <algorithm>
 #include <iostream>
+#include <limits>
 
-myVector<int> Dijkstra::shortestPathsWithPredecessors(int start, HeapType heapType, myVector<int>& predecessors, int d) {
-    const int numVertices = static_cast<int>(graph.getNumVertices());
-    predecessors.resize(numVertices, -1);
+template <typename W, typename D>
+myVector<D> BasicDijkstra<W, D>::shortestPathsWithPredecessors(int start, HeapType heapType, myVector<int>& predecessors, int d) {
+    return inOriginalIds(start, predecessors, [&](int source, myVector<int>& links) {
+        return visitGraph([&](const auto& g) { return run(g, source, heapType, links, d); });
+    });
+}
+
+template <typename W, typename D>
+myVector<D> BasicDijkstra<W, D>::shortestPathsToTarget(int target, HeapType heapType, myVector<int>& successors, int d) {
+    return inOriginalIds(target, successors, [&](int sink, myVector<int>& links) {
+        return visitGraph([&](const auto& g) {
+            using GraphType = typename std::decay<decltype(g)>::type;
+            return run(ReverseView<GraphType>(g), sink, heapType, links, d);
+        });
+    });
+}
 
-    if (start < 0 || start >= numVertices) {
+template <typename W, typename D>
+typename BasicDijkstra<W, D>::PathResult BasicDijkstra<W, D>::shortestPath(int source, int target, HeapType heapType, int d) {
+    const int n = static_cast<int>(graph.getNumVertices());
+    if (source < 0 || source >= n) {
         throw std::out_of_range("Start vertex out of range");
     }
+    if (target < 0 || target >= n) {
+        throw std::out_of_range("Target vertex out of range");
+    }
+    const int from = graph.toInternal(source);
+    const int to = graph.toInternal(target);
+
+    myVector<int> predecessors;
+    const myVector<D> dist = visitGraph([&](const auto& g) { return run(g, from, heapType, predecessors, d, to); });
+
+    PathResult result;
+    result.distance = dist[to];
+    if (dist[to] != WeightTraits<D>::unreachable()) {
+        result.path = reconstructPath(from, to, predecessors);
+        for (size_t i = 0; i < result.path.size(); ++i) {
+            result.path[i] = graph.toOriginal(result.path[i]);
+        }
+    }
+    return result;
+}
+
+template <typename W, typename D>
+typename BasicDijkstra<W, D>::PathResult BasicDijkstra<W, D>::shortestPath(int source, int target, Workspace& workspace) {
+    checkQuery(source, target, workspace);
+    const int from = graph.toInternal(source);
+    const int to = graph.toInternal(target);
+    visitGraph([&](const auto& g) { runInWorkspace(g, from, to, workspace); });
+
+    PathResult result;
+    result.distance = WeightTraits<D>::unreachable();
+    if (workspace.isSettled(to)) {
+        result.distance = workspace.dist[to];
+        result.path = reconstructPath(from, to, workspace.predecessors);
+        for (size_t i = 0; i < result.path.size(); ++i) {
+            result.path[i] = graph.toOriginal(result.path[i]);
+        }
+    }
+    return result;
+}
 
-    myVector<int> dist(numVertices, std::numeric_limits<int>::max());
-    myVector<bool> visited(numVertices, false);
+template <typename W, typename D>
+D BasicDijkstra<W, D>::distance(int source, int target, Workspace& workspace) {
+    checkQuery(source, target, workspace);
+    const int to = graph.toInternal(target);
+    visitGraph([&](const auto& g) { runInWorkspace(g, graph.toInternal(source), to, workspace); });
+    return workspace.isSettled(to) ? workspace.dist[to] : WeightTraits<D>::unreachable();
+}
+
+template <typename W, typename D>
+void BasicDijkstra<W, D>::distancesInto(int source, Workspace& workspace, D* distances) const {
+    checkQuery(source, source, workspace);
+    visitGraph([&](const auto& g) { runInWorkspace(g, graph.toInternal(source), -1, workspace); });
+    const int n = static_cast<int>(graph.getNumVertices());
+    for (int v = 0; v < n; ++v) {
+        distances[graph.toOriginal(v)] = workspace.isSettled(v) ? workspace.dist[v] : WeightTraits<D>::unreachable();
+    }
+}
+
+template <typename W, typename D>
+void BasicDijkstra<W, D>::checkQuery(int source, int target, const Workspace& workspace) const {
+    const int n = static_cast<int>(graph.getNumVertices());
+    if (source < 0 || source >= n) {
+        throw std::out_of_range("Start vertex out of range");
+    }
+    if (target < 0 || target >= n) {
+        throw std::out_of_range("Target vertex out of range");
+    }
+    if (workspace.getNumVertices() != graph.getNumVertices()) {
+        throw std::invalid_argument("Workspace size does not match the graph");
+    }
+}
+
+template <typename W, typename D>
+template <typename G>
+void BasicDijkstra<W, D>::runInWorkspace(const G& g, int start, int target, Workspace& workspace) const {
+    workspace.reset();
+    const uint32_t reached = workspace.epoch;
+    const uint32_t settled = workspace.epoch + 1;
+    myVector<D>& dist = workspace.dist;
+    myVector<int>& predecessors = workspace.predecessors;
+    myVector<uint32_t>& stamps = workspace.stamps;
+    DHeap<Node>& pq = workspace.heap;
 
     dist[start] = 0;
+    predecessors[start] = -1;
+    stamps[start] = reached;
+    pq.push({ start, 0 });
+    while (!pq.empty()) {
+        const Node current = pq.top();
+        pq.pop();
+        const int u = current.vertex;
+        if (stamps[u] == settled) continue;
+        stamps[u] = settled;
+        ++workspace.settledCount;
+        if (u == target) break;
+
+        g.forEachNeighbor(u, [&](size_t neighbor, W weight) {
+            const int v = static_cast<int>(neighbor);
+            if (stamps[v] == settled) return;
+            const D candidate = addDistance(dist[u], weight);
+            if (stamps[v] != reached || candidate < dist[v]) {
+                stamps[v] = reached;
+                dist[v] = candidate;
+                predecessors[v] = u;
+                pq.push({ v, candidate });
+            }
+        });
+    }
+}
+
+template <typename W, typename D>
+myVector<D> BasicDijkstra<W, D>::shortestPathsFromSources(const myVector<int>& sources, HeapType heapType, myVector<int>& owners,
+    myVector<int>& predecessors, int d) {
+    return shortestPathsFromSources(sources, myVector<D>(sources.size(), D()), heapType, owners, predecessors, d);
+}
+
+template <typename W, typename D>
+myVector<D> BasicDijkstra<W, D>::shortestPathsFromSources(const myVector<int>& sources, const myVector<D>& offsets, HeapType heapType,
+    myVector<int>& owners, myVector<int>& predecessors, int d) {
+    const int n = static_cast<int>(graph.getNumVertices());
+    if (sources.empty()) {
+        throw std::invalid_argument("Sources cannot be empty");
+    }
+    if (offsets.size() != sources.size()) {
+        throw std::invalid_argument("Offsets must match the sources");
+    }
+    myVector<Node> seeds;
+    seeds.reserve(sources.size());
+    // The source each seeded vertex belongs to: the first one with the smallest offset.
+    myVector<int> seedOwner(n, -1);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i] < 0 || sources[i] >= n) {
+            throw std::out_of_range("Start vertex out of range");
+        }
+        if (offsets[i] < D() || !(offsets[i] < WeightTraits<D>::infinity())) {
+            throw std::invalid_argument("Source offset must be non-negative");
+        }
+        const int v = graph.toInternal(sources[i]);
+        seeds.push_back({ v, offsets[i] });
+        if (seedOwner[v] == -1 || offsets[i] < offsets[seedOwner[v]]) {
+            seedOwner[v] = static_cast<int>(i);
+        }
+    }
+
+    myVector<int> links;
+    myVector<D> dist = visitGraph([&](const auto& g) { return runFromSeeds(g, seeds, heapType, links, d, -1); });
+
+    // Every reached vertex hangs below exactly one seed in the predecessor forest; walk up to it once per chain.
+    myVector<int> cell(n, -1);
+    myVector<int> chain;
+    for (int v = 0; v < n; ++v) {
+        if (cell[v] != -1 || dist[v] == WeightTraits<D>::unreachable()) continue;
+        int at = v;
+        while (cell[at] == -1 && links[at] != -1) {
+            chain.push_back(at);
+            at = links[at];
+        }
+        const int owner = cell[at] != -1 ? cell[at] : seedOwner[at];
+        cell[at] = owner;
+        for (size_t i = 0; i < chain.size(); ++i) {
+            cell[chain[i]] = owner;
+        }
+        chain.clear();
+    }
+
+    const BasicReorderedGraph<W>* reordered = graph.getReordering();
+    if (!reordered) {
+        owners = cell;
+        predecessors = links;
+        return dist;
+    }
+    owners = reordered->valuesToOriginal(cell);
+    predecessors = reordered->verticesToOriginal(links);
+    return reordered->valuesToOriginal(dist);
+}
+
+template <typename W, typename D>
+template <typename G>
+myVector<D> BasicDijkstra<W, D>::run(const G& g, int start, HeapType heapType, myVector<int>& predecessors, int d, int target) {
+    if (start < 0 || start >= static_cast<int>(g.getNumVertices())) {
+        throw std::out_of_range("Start vertex out of range");
+    }
+    return runFromSeeds(g, myVector<Node>(1, Node{ start, 0 }), heapType, predecessors, d, target);
+}
+
+template <typename W, typename D>
+template <typename G>
+myVector<D> BasicDijkstra<W, D>::runFromSeeds(const G& g, myVector<Node> seeds, HeapType heapType, myVector<int>& predecessors, int d, int target) {
+    const int numVertices = static_cast<int>(g.getNumVertices());
+    const D infinity = WeightTraits<D>::infinity();
+    myVector<D> dist;
+    myVector<bool> visited;
+
+    // Ascending starting distances let the bucket queue anchor its window at the smallest one.
+    std::sort(seeds.data(), seeds.data() + seeds.size());
+    auto reset = [&]() {
+        predecessors.clear();
+        predecessors.resize(numVertices, -1);
+        dist.clear();
+        dist.resize(numVertices, infinity);
+        visited.clear();
+        visited.resize(numVertices, false);
+        for (size_t i = 0; i < seeds.size(); ++i) {
+            if (seeds[i].distance < dist[seeds[i].vertex]) dist[seeds[i].vertex] = seeds[i].distance;
+        }
+    };
+    reset();
+    auto seed = [&](auto& pq) {
+        for (size_t i = 0; i < seeds.size(); ++i) {
+            pq.push(seeds[i]);
+        }
+    };
+
+    if (heapType == AUTO && prefersDenseScan(g)) {
+        heapType = DENSE_SCAN;
+    }
+    if (heapType == DENSE_SCAN) {
+        processDenseScan(g, dist, visited, predecessors, target);
+    }
+    else if (heapType == DIAL_BUCKETS || heapType == AUTO) {
+        const bool integral = std::is_integral<D>::value;
+        if (heapType == DIAL_BUCKETS && !integral) {
+            throw std::invalid_argument("Bucket queue needs integer distances");
+        }
+        if (graph.getVersion() != weightVersion) scanMaxWeight();
+        const uint64_t range = integral ? static_cast<uint64_t>(maxWeight) +
+            static_cast<uint64_t>(seeds[seeds.size() - 1].distance - seeds[0].distance) : 0;
+        if (heapType == DIAL_BUCKETS || (integral && range <= autoBucketLimit)) {
+            try {
+                BucketQueue<Node> pq(range);
+                seed(pq);
+                processQueueWithPredecessors(g, pq, dist, visited, predecessors, target);
+            }
+            catch (const std::out_of_range&) {
+                // A key outside the window the largest weight allows: the search starts over on the d-heap
+                // rather than failing, which also rethrows any error that was not the window's.
+                reset();
+                heapType = D_HEAP;
+            }
+        }
+        else {
+            heapType = D_HEAP;
+        }
+    }
 
     if (heapType == D_HEAP) {
-        DHeap<HeapNode> pq(d);
-        pq.push({ start, 0 });
-        processQueueWithPredecessors(pq, dist, visited, predecessors);
+        DHeap<Node> pq(d);
+        seed(pq);
+        processQueueWithPredecessors(g, pq, dist, visited, predecessors, target);
     }
-    else {
-        BinomialHeap<HeapNode> pq;
-        pq.push({ start, 0 });
-        processQueueWithPredecessors(pq, dist, visited, predecessors);
+    else if (heapType == BINOMIAL_HEAP) {
+        BinomialHeap<Node> pq;
+        seed(pq);
+        processQueueWithPredecessors(g, pq, dist, visited, predecessors, target);
     }
 
+    lastSettled = 0;
     for (int i = 0; i < numVertices; ++i) {
-        if (dist[i] == std::numeric_limits<int>::max()) {
-            dist[i] = -1;
+        if (visited[i]) ++lastSettled;
+        if (dist[i] == infinity) {
+            dist[i] = WeightTraits<D>::unreachable();
         }
     }
 
     return dist;
 }
 
-void Dijkstra::printResults(int start, const myVector<int>& dist) const {
+template <typename W, typename D>
+void BasicDijkstra<W, D>::printResults(int start, const myVector<D>& dist) const {
     std::cout << "Кратчайшие пути от вершины " << start << ":\n";
     for (int i = 0; i < dist.size(); ++i) {
-        if (dist[i] == -1) {
+        if (dist[i] == WeightTraits<D>::unreachable()) {
             std::cout << "  до " << i << ": недостижима\n";
         }
         else {
@@ -46,8 +305,13 @@ void Dijkstra::printResults(int start, const myVector<int>& dist) const {
     }
 }
 
-template void Dijkstra::processQueueWithPredecessors<DHeap<HeapNode>>(
-    DHeap<HeapNode>&, myVector<int>&, myVector<bool>&, myVector<int>&);
-
-template void Dijkstra::processQueueWithPredecessors<BinomialHeap<HeapNode>>(
-    BinomialHeap<HeapNode>&, myVector<int>&, myVector<bool>&, myVector<int>&);
\ No newline at end of file
+template class BasicDijkstra<uint16_t, uint32_t>;
+template class BasicDijkstra<uint16_t, uint64_t>;
+template class BasicDijkstra<uint32_t, uint32_t>;
+template class BasicDijkstra<uint32_t, uint64_t>;
+template class BasicDijkstra<int, int>;
+template class BasicDijkstra<int, int64_t>;
+template class BasicDijkstra<int64_t, int64_t>;
+template class BasicDijkstra<float, float>;
+template class BasicDijkstra<float, double>;
+template class BasicDijkstra<double, double>;
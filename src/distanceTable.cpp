@@ -0,0 +1,186 @@
+#include "distanceTable.h"
+#include "parallel.h"
+#include <algorithm>
+
+namespace {
+
+// Upward search from one vertex with stall-on-demand, over up arcs (forward) or down arcs (backward).
+// visit(v, distance) is called for every vertex settled without being stalled.
+template <typename W, typename D>
+class UpwardSearch {
+public:
+    explicit UpwardSearch(size_t numVertices) : dist(numVertices, WeightTraits<D>::infinity()), queue(4) {
+    }
+
+    template <typename F>
+    void run(const BasicContractionHierarchy<W, D>& hierarchy, int start, bool forward, F&& visit) {
+        const D infinity = WeightTraits<D>::infinity();
+        for (size_t i = 0; i < touched.size(); ++i) {
+            dist[touched[i]] = infinity;
+        }
+        touched.clear();
+        queue.clear();
+
+        dist[start] = 0;
+        touched.push_back(static_cast<uint32_t>(start));
+        queue.push({ start, 0 });
+        while (!queue.empty()) {
+            const BasicHeapNode<D> current = queue.top();
+            queue.pop();
+            const int u = current.vertex;
+            if (current.distance != dist[u]) continue;
+
+            bool stalled = false;
+            auto stall = [&](size_t x, D weight) {
+                if (!stalled && dist[x] != infinity && addDistance(dist[x], weight) < dist[u]) stalled = true;
+            };
+            if (forward) {
+                hierarchy.forEachDownArc(static_cast<size_t>(u), stall);
+            }
+            else {
+                hierarchy.forEachUpArc(static_cast<size_t>(u), stall);
+            }
+            if (stalled) continue;
+            visit(static_cast<size_t>(u), dist[u]);
+
+            auto relax = [&](size_t x, D weight) {
+                const D candidate = addDistance(dist[u], weight);
+                if (candidate < dist[x]) {
+                    if (dist[x] == infinity) touched.push_back(static_cast<uint32_t>(x));
+                    dist[x] = candidate;
+                    queue.push({ static_cast<int>(x), candidate });
+                }
+            };
+            if (forward) {
+                hierarchy.forEachUpArc(static_cast<size_t>(u), relax);
+            }
+            else {
+                hierarchy.forEachDownArc(static_cast<size_t>(u), relax);
+            }
+        }
+    }
+
+private:
+    myVector<D> dist;
+    myVector<uint32_t> touched;
+    DHeap<BasicHeapNode<D>> queue;
+};
+
+const uint64_t noEntry = ~uint64_t(0);
+
+}
+
+template <typename W, typename D>
+BasicDistanceTable<W, D>::BasicDistanceTable(const BasicContractionHierarchy<W, D>& hierarchy, size_t threads)
+    : hierarchy(hierarchy), threads(threads ? threads : hardwareThreads()),
+      bucketBegin(hierarchy.getNumVertices(), noEntry), bucketEnd(hierarchy.getNumVertices(), noEntry), lastEntries(0) {
+}
+
+template <typename W, typename D>
+myVector<D> BasicDistanceTable<W, D>::compute(const myVector<int>& sources, const myVector<int>& targets) {
+    myVector<D> table(sources.size() * targets.size());
+    compute(sources, targets, table.data());
+    return table;
+}
+
+template <typename W, typename D>
+void BasicDistanceTable<W, D>::compute(const myVector<int>& sources, const myVector<int>& targets, D* table) {
+    const int n = static_cast<int>(hierarchy.getNumVertices());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i] < 0 || sources[i] >= n) {
+            throw std::out_of_range("Start vertex out of range");
+        }
+    }
+    for (size_t j = 0; j < targets.size(); ++j) {
+        if (targets[j] < 0 || targets[j] >= n) {
+            throw std::out_of_range("Target vertex out of range");
+        }
+    }
+    lastEntries = 0;
+    if (sources.empty() || targets.empty()) return;
+
+    // Backward phase: every block of targets fills its own entry list, merged and sorted by vertex afterwards.
+    const size_t backwardBlocks = threads < targets.size() ? threads : targets.size();
+    myVector<myVector<Entry>> found(backwardBlocks);
+    parallelFor(backwardBlocks, backwardBlocks, [&](size_t block) {
+        UpwardSearch<W, D> search(static_cast<size_t>(n));
+        const size_t begin = targets.size() * block / backwardBlocks;
+        const size_t end = targets.size() * (block + 1) / backwardBlocks;
+        for (size_t j = begin; j < end; ++j) {
+            search.run(hierarchy, targets[j], false, [&](size_t v, D distance) {
+                found[block].push_back({ static_cast<uint32_t>(v), static_cast<uint32_t>(j), distance });
+            });
+        }
+    });
+
+    size_t total = 0;
+    for (size_t block = 0; block < backwardBlocks; ++block) {
+        total += found[block].size();
+    }
+    myVector<Entry> entries;
+    entries.reserve(total);
+    for (size_t block = 0; block < backwardBlocks; ++block) {
+        for (size_t i = 0; i < found[block].size(); ++i) {
+            entries.push_back(found[block][i]);
+        }
+        found[block] = myVector<Entry>();
+    }
+    std::sort(entries.data(), entries.data() + entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const uint32_t v = entries[i].vertex;
+        if (bucketBegin[v] == noEntry) bucketBegin[v] = i;
+        bucketEnd[v] = i + 1;
+    }
+    lastEntries = entries.size();
+
+    auto clearBuckets = [&]() {
+        for (size_t i = 0; i < entries.size(); ++i) {
+            bucketBegin[entries[i].vertex] = noEntry;
+            bucketEnd[entries[i].vertex] = noEntry;
+        }
+    };
+
+    // Forward phase: each source owns its row, so the blocks write disjoint parts of the table.
+    const size_t columns = targets.size();
+    const size_t forwardBlocks = threads < sources.size() ? threads : sources.size();
+    try {
+        parallelFor(forwardBlocks, forwardBlocks, [&](size_t block) {
+            UpwardSearch<W, D> search(static_cast<size_t>(n));
+            const size_t begin = sources.size() * block / forwardBlocks;
+            const size_t end = sources.size() * (block + 1) / forwardBlocks;
+            for (size_t i = begin; i < end; ++i) {
+                D* row = table + i * columns;
+                for (size_t j = 0; j < columns; ++j) {
+                    row[j] = WeightTraits<D>::infinity();
+                }
+                search.run(hierarchy, sources[i], true, [&](size_t v, D distance) {
+                    if (bucketBegin[v] == noEntry) return;
+                    for (uint64_t e = bucketBegin[v]; e < bucketEnd[v]; ++e) {
+                        const Entry& entry = entries[static_cast<size_t>(e)];
+                        const D candidate = addDistance(distance, entry.distance);
+                        if (candidate < row[entry.target]) row[entry.target] = candidate;
+                    }
+                });
+                for (size_t j = 0; j < columns; ++j) {
+                    if (row[j] == WeightTraits<D>::infinity()) row[j] = WeightTraits<D>::unreachable();
+                }
+            }
+        });
+    }
+    catch (...) {
+        clearBuckets();
+        throw;
+    }
+    clearBuckets();
+}
+
+template class BasicDistanceTable<uint16_t, uint32_t>;
+template class BasicDistanceTable<uint16_t, uint64_t>;
+template class BasicDistanceTable<uint32_t, uint32_t>;
+template class BasicDistanceTable<uint32_t, uint64_t>;
+template class BasicDistanceTable<int, int>;
+template class BasicDistanceTable<int, int64_t>;
+template class BasicDistanceTable<int64_t, int64_t>;
+template class BasicDistanceTable<float, float>;
+template class BasicDistanceTable<float, double>;
+template class BasicDistanceTable<double, double>;
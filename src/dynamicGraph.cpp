@@ -0,0 +1,258 @@
+#include "dynamicGraph.h"
+#include <algorithm>
+
+namespace {
+
+struct KeyedUpdate {
+    uint64_t key;
+    size_t index;
+};
+
+template <typename W>
+struct OverlayItem {
+    uint32_t vertex;
+    uint32_t target;
+    W weight;
+};
+
+template <typename W>
+bool itemLess(const OverlayItem<W>& a, const OverlayItem<W>& b) {
+    return a.vertex < b.vertex || (a.vertex == b.vertex && a.target < b.target);
+}
+
+// Merges the previous overlay with the final state of the edges touched by a batch; fresh items win.
+// Arcs that end up equal to the base arc (or absent from both) are dropped to keep the overlay small.
+template <typename W>
+std::shared_ptr<const BasicDeltaOverlay<W>> mergeOverlay(const BasicDeltaOverlay<W>& old, myVector<OverlayItem<W>>& fresh,
+    const BasicCsrGraph<W>& base, bool reversed) {
+    typedef BasicDeltaOverlay<W> Overlay;
+    const W noEdge = WeightTraits<W>::noEdge();
+    std::sort(fresh.data(), fresh.data() + fresh.size(), itemLess<W>);
+
+    auto overlay = std::make_shared<Overlay>();
+    overlay->offsets.clear();
+    overlay->arcs.reserve(old.arcs.size() + fresh.size());
+
+    auto append = [&](const OverlayItem<W>& item) {
+        const W baseWeight = reversed ? base.getEdgeWeight(item.target, item.vertex) : base.getEdgeWeight(item.vertex, item.target);
+        if (item.weight == baseWeight) return;
+        if (overlay->vertices.empty() || overlay->vertices.back() != item.vertex) {
+            overlay->vertices.push_back(item.vertex);
+            overlay->offsets.push_back(overlay->arcs.size());
+        }
+        overlay->arcs.push_back({ item.target, item.weight == noEdge ? W() : item.weight, item.weight == noEdge });
+    };
+
+    size_t row = 0;
+    uint64_t i = 0;
+    size_t j = 0;
+    while (i < old.arcs.size() || j < fresh.size()) {
+        while (row < old.vertices.size() && old.offsets[row + 1] <= i) ++row;
+        OverlayItem<W> previous = {};
+        if (i < old.arcs.size()) {
+            const typename Overlay::Arc& arc = old.arcs[i];
+            previous = { old.vertices[row], arc.target, arc.removed ? noEdge : arc.weight };
+        }
+        if (j == fresh.size() || (i < old.arcs.size() && itemLess(previous, fresh[j]))) {
+            append(previous);
+            ++i;
+            continue;
+        }
+        if (i < old.arcs.size() && !itemLess(fresh[j], previous)) ++i;
+        append(fresh[j++]);
+    }
+    overlay->offsets.push_back(overlay->arcs.size());
+    return overlay;
+}
+
+}
+
+template <typename W>
+W BasicGraphSnapshot<W>::getEdgeWeight(size_t u, size_t v) const {
+    if (u >= getNumVertices() || v >= getNumVertices()) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    const typename Overlay::Arc* arc = nullptr;
+    const size_t count = forward->find(u, arc);
+    const typename Overlay::Arc* it = std::lower_bound(arc, arc + count, v,
+        [](const typename Overlay::Arc& a, size_t target) { return a.target < target; });
+    if (it != arc + count && it->target == v) {
+        return it->removed ? WeightTraits<W>::noEdge() : it->weight;
+    }
+    return base->getEdgeWeight(u, v);
+}
+
+template <typename W>
+BasicDynamicGraph<W>::BasicDynamicGraph(const BasicCsrGraph<W>& base, size_t compactionThreshold)
+    : numVertices(base.getNumVertices()), directed(base.isDirected()),
+      threshold(compactionThreshold ? compactionThreshold : std::max<size_t>(4096, base.getNumArcs() / 8)),
+      current(std::make_shared<const BasicCsrGraph<W>>(base), std::make_shared<const Overlay>(),
+          std::make_shared<const Overlay>()),
+      compacting(false) {
+}
+
+template <typename W>
+BasicDynamicGraph<W>::~BasicDynamicGraph() {
+    waitForCompaction();
+}
+
+template <typename W>
+typename BasicDynamicGraph<W>::Snapshot BasicDynamicGraph<W>::snapshot() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return current;
+}
+
+template <typename W>
+void BasicDynamicGraph<W>::publish(const Snapshot& next) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    current = next;
+}
+
+template <typename W>
+bool BasicDynamicGraph<W>::isCompacting() const {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    return compacting;
+}
+
+// Updates to the same edge are grouped by a stable sort and replayed in batch order,
+// so a batch may insert an edge and reweight or remove it again.
+template <typename W>
+typename BasicDynamicGraph<W>::Snapshot BasicDynamicGraph<W>::withBatch(const Snapshot& state, const myVector<Update>& updates) {
+    const size_t n = state.getNumVertices();
+    const bool isDirected = state.isDirected();
+    const W noEdge = WeightTraits<W>::noEdge();
+
+    myVector<KeyedUpdate> order;
+    order.reserve(updates.size());
+    for (size_t i = 0; i < updates.size(); ++i) {
+        const Update& update = updates[i];
+        if (update.kind != Update::REMOVE && !WeightTraits<W>::isValidWeight(update.weight)) {
+            throw std::invalid_argument("Edge weight must be positive");
+        }
+        if (update.u >= n || update.v >= n) {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        if (update.u == update.v) {
+            throw std::invalid_argument("Self-loops are not supported");
+        }
+        size_t u = update.u;
+        size_t v = update.v;
+        if (!isDirected && u > v) std::swap(u, v);
+        order.push_back({ static_cast<uint64_t>(u) << 32 | v, i });
+    }
+    std::sort(order.data(), order.data() + order.size(), [](const KeyedUpdate& a, const KeyedUpdate& b) {
+        return a.key < b.key || (a.key == b.key && a.index < b.index);
+    });
+
+    myVector<OverlayItem<W>> forwardItems;
+    myVector<OverlayItem<W>> backwardItems;
+    for (size_t i = 0; i < order.size();) {
+        const uint64_t key = order[i].key;
+        const uint32_t u = static_cast<uint32_t>(key >> 32);
+        const uint32_t v = static_cast<uint32_t>(key);
+        W weight = state.getEdgeWeight(u, v);
+        for (; i < order.size() && order[i].key == key; ++i) {
+            const Update& update = updates[order[i].index];
+            if (update.kind == Update::INSERT) {
+                if (weight != noEdge) {
+                    throw std::logic_error("Edge already exists. Multiple edges are not supported.");
+                }
+                weight = update.weight;
+            }
+            else {
+                if (weight == noEdge) {
+                    throw std::logic_error("Edge does not exist");
+                }
+                weight = update.kind == Update::REMOVE ? noEdge : update.weight;
+            }
+        }
+        forwardItems.push_back({ u, v, weight });
+        if (isDirected) {
+            backwardItems.push_back({ v, u, weight });
+        }
+        else {
+            forwardItems.push_back({ v, u, weight });
+        }
+    }
+
+    auto forward = mergeOverlay(*state.forward, forwardItems, *state.base, false);
+    auto backward = isDirected ? mergeOverlay(*state.backward, backwardItems, *state.base, true) : forward;
+    return Snapshot(state.base, std::move(forward), std::move(backward));
+}
+
+template <typename W>
+typename BasicDynamicGraph<W>::Snapshot BasicDynamicGraph<W>::rebuilt(const Snapshot& state) {
+    auto base = std::make_shared<const BasicCsrGraph<W>>(BasicCsrGraph<W>(state.getNumVertices(), state.isDirected(),
+        BasicCsrGraph<W>::storageFrom(state)));
+    auto empty = std::make_shared<const Overlay>();
+    return Snapshot(std::move(base), empty, empty);
+}
+
+template <typename W>
+void BasicDynamicGraph<W>::applyBatch(const myVector<Update>& updates) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    const Snapshot next = withBatch(snapshot(), updates);
+    publish(next);
+    if (compacting) {
+        pending.push_back(updates);
+        return;
+    }
+    if (next.getOverlaySize() >= threshold) {
+        if (worker.joinable()) worker.join();
+        compacting = true;
+        worker = std::thread(&BasicDynamicGraph::compactionTask, this, next);
+    }
+}
+
+// Batches applied while the new base is being built are replayed on top of it before it is published.
+template <typename W>
+void BasicDynamicGraph<W>::compactionTask(Snapshot source) {
+    try {
+        Snapshot next = rebuilt(source);
+        std::lock_guard<std::mutex> lock(writeMutex);
+        for (size_t i = 0; i < pending.size(); ++i) {
+            next = withBatch(next, pending[i]);
+        }
+        publish(next);
+        pending = myVector<myVector<Update>>();
+        compacting = false;
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        pending = myVector<myVector<Update>>();
+        compacting = false;
+    }
+}
+
+template <typename W>
+void BasicDynamicGraph<W>::waitForCompaction() {
+    std::thread running;
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        running.swap(worker);
+    }
+    if (running.joinable()) running.join();
+}
+
+template <typename W>
+void BasicDynamicGraph<W>::compact() {
+    waitForCompaction();
+    std::lock_guard<std::mutex> lock(writeMutex);
+    const Snapshot state = snapshot();
+    if (state.getOverlaySize() == 0) return;
+    publish(rebuilt(state));
+}
+
+template class BasicGraphSnapshot<uint16_t>;
+template class BasicGraphSnapshot<uint32_t>;
+template class BasicGraphSnapshot<int>;
+template class BasicGraphSnapshot<int64_t>;
+template class BasicGraphSnapshot<float>;
+template class BasicGraphSnapshot<double>;
+
+template class BasicDynamicGraph<uint16_t>;
+template class BasicDynamicGraph<uint32_t>;
+template class BasicDynamicGraph<int>;
+template class BasicDynamicGraph<int64_t>;
+template class BasicDynamicGraph<float>;
+template class BasicDynamicGraph<double>;
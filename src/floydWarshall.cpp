@@ -0,0 +1,402 @@
+#include "floydWarshall.h"
+#include "parallel.h"
+#include "simdOps.h"
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+namespace {
+
+// Integer distances are held as signed lanes no larger than half their range, so the sum of any two stays
+// representable and signed vector compares work for the unsigned types too.
+template <typename D>
+struct Lane {
+    typedef typename std::conditional<std::is_floating_point<D>::value, D,
+        typename std::conditional<sizeof(D) == 8, int64_t, int32_t>::type>::type type;
+};
+
+template <typename L>
+L laneLimit() {
+    return std::numeric_limits<L>::has_infinity ? std::numeric_limits<L>::infinity() : std::numeric_limits<L>::max() / 2;
+}
+
+template <typename L>
+void relaxScalar(L* c, const L* b, L a, size_t n) {
+    for (size_t j = 0; j < n; ++j) {
+        const L candidate = a + b[j];
+        if (candidate < c[j]) c[j] = candidate;
+    }
+}
+
+template <typename L>
+void relaxScalarTracked(L* c, int* pc, const L* b, const int* pb, L a, size_t n) {
+    for (size_t j = 0; j < n; ++j) {
+        const L candidate = a + b[j];
+        if (candidate < c[j]) {
+            c[j] = candidate;
+            pc[j] = pb[j];
+        }
+    }
+}
+
+#if SIMD_X86
+
+SIMD_TARGET_AVX2 void relaxAvx2(int32_t* c, const int32_t* b, int32_t a, size_t n) {
+    const __m256i va = _mm256_set1_epi32(a);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        const __m256i candidate = _mm256_add_epi32(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j)));
+        const __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + j), _mm256_min_epi32(current, candidate));
+    }
+    relaxScalar(c + j, b + j, a, n - j);
+}
+
+SIMD_TARGET_AVX2 void relaxAvx2(int64_t* c, const int64_t* b, int64_t a, size_t n) {
+    const __m256i va = _mm256_set1_epi64x(a);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        const __m256i candidate = _mm256_add_epi64(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j)));
+        const __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + j));
+        const __m256i better = _mm256_cmpgt_epi64(current, candidate);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + j), _mm256_blendv_epi8(current, candidate, better));
+    }
+    relaxScalar(c + j, b + j, a, n - j);
+}
+
+SIMD_TARGET_AVX2 void relaxAvx2(float* c, const float* b, float a, size_t n) {
+    const __m256 va = _mm256_set1_ps(a);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        const __m256 candidate = _mm256_add_ps(va, _mm256_loadu_ps(b + j));
+        _mm256_storeu_ps(c + j, _mm256_min_ps(_mm256_loadu_ps(c + j), candidate));
+    }
+    relaxScalar(c + j, b + j, a, n - j);
+}
+
+SIMD_TARGET_AVX2 void relaxAvx2(double* c, const double* b, double a, size_t n) {
+    const __m256d va = _mm256_set1_pd(a);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        const __m256d candidate = _mm256_add_pd(va, _mm256_loadu_pd(b + j));
+        _mm256_storeu_pd(c + j, _mm256_min_pd(_mm256_loadu_pd(c + j), candidate));
+    }
+    relaxScalar(c + j, b + j, a, n - j);
+}
+
+SIMD_TARGET_AVX2 void relaxAvx2Tracked(int32_t* c, int* pc, const int32_t* b, const int* pb, int32_t a, size_t n) {
+    const __m256i va = _mm256_set1_epi32(a);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        const __m256i candidate = _mm256_add_epi32(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j)));
+        const __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + j));
+        const __m256i better = _mm256_cmpgt_epi32(current, candidate);
+        const __m256i links = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pc + j));
+        const __m256i through = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pb + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + j), _mm256_blendv_epi8(current, candidate, better));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pc + j), _mm256_blendv_epi8(links, through, better));
+    }
+    relaxScalarTracked(c + j, pc + j, b + j, pb + j, a, n - j);
+}
+
+SIMD_TARGET_AVX2 void relaxAvx2Tracked(int64_t* c, int* pc, const int64_t* b, const int* pb, int64_t a, size_t n) {
+    const __m256i va = _mm256_set1_epi64x(a);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        const __m256i candidate = _mm256_add_epi64(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j)));
+        const __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + j));
+        const __m256i better = _mm256_cmpgt_epi64(current, candidate);
+        const __m128i links = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc + j));
+        const __m128i through = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pb + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + j), _mm256_blendv_epi8(current, candidate, better));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pc + j), _mm_blendv_epi8(links, through, narrowMask(better)));
+    }
+    relaxScalarTracked(c + j, pc + j, b + j, pb + j, a, n - j);
+}
+
+SIMD_TARGET_AVX2 void relaxAvx2Tracked(float* c, int* pc, const float* b, const int* pb, float a, size_t n) {
+    const __m256 va = _mm256_set1_ps(a);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        const __m256 candidate = _mm256_add_ps(va, _mm256_loadu_ps(b + j));
+        const __m256 current = _mm256_loadu_ps(c + j);
+        const __m256 better = _mm256_cmp_ps(candidate, current, _CMP_LT_OQ);
+        const __m256i links = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pc + j));
+        const __m256i through = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pb + j));
+        _mm256_storeu_ps(c + j, _mm256_blendv_ps(current, candidate, better));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pc + j), _mm256_blendv_epi8(links, through, _mm256_castps_si256(better)));
+    }
+    relaxScalarTracked(c + j, pc + j, b + j, pb + j, a, n - j);
+}
+
+SIMD_TARGET_AVX2 void relaxAvx2Tracked(double* c, int* pc, const double* b, const int* pb, double a, size_t n) {
+    const __m256d va = _mm256_set1_pd(a);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        const __m256d candidate = _mm256_add_pd(va, _mm256_loadu_pd(b + j));
+        const __m256d current = _mm256_loadu_pd(c + j);
+        const __m256d better = _mm256_cmp_pd(candidate, current, _CMP_LT_OQ);
+        const __m128i links = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pc + j));
+        const __m128i through = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pb + j));
+        _mm256_storeu_pd(c + j, _mm256_blendv_pd(current, candidate, better));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pc + j), _mm_blendv_epi8(links, through, narrowMask(_mm256_castpd_si256(better))));
+    }
+    relaxScalarTracked(c + j, pc + j, b + j, pb + j, a, n - j);
+}
+
+SIMD_TARGET_AVX512 void relaxAvx512(int32_t* c, const int32_t* b, int32_t a, size_t n) {
+    const __m512i va = _mm512_set1_epi32(a);
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        const __m512i candidate = _mm512_add_epi32(va, _mm512_loadu_si512(b + j));
+        _mm512_storeu_si512(c + j, _mm512_min_epi32(_mm512_loadu_si512(c + j), candidate));
+    }
+    relaxScalar(c + j, b + j, a, n - j);
+}
+
+SIMD_TARGET_AVX512 void relaxAvx512(int64_t* c, const int64_t* b, int64_t a, size_t n) {
+    const __m512i va = _mm512_set1_epi64(a);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        const __m512i candidate = _mm512_add_epi64(va, _mm512_loadu_si512(b + j));
+        _mm512_storeu_si512(c + j, _mm512_min_epi64(_mm512_loadu_si512(c + j), candidate));
+    }
+    relaxScalar(c + j, b + j, a, n - j);
+}
+
+SIMD_TARGET_AVX512 void relaxAvx512(float* c, const float* b, float a, size_t n) {
+    const __m512 va = _mm512_set1_ps(a);
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        const __m512 candidate = _mm512_add_ps(va, _mm512_loadu_ps(b + j));
+        _mm512_storeu_ps(c + j, _mm512_min_ps(_mm512_loadu_ps(c + j), candidate));
+    }
+    relaxScalar(c + j, b + j, a, n - j);
+}
+
+SIMD_TARGET_AVX512 void relaxAvx512(double* c, const double* b, double a, size_t n) {
+    const __m512d va = _mm512_set1_pd(a);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        const __m512d candidate = _mm512_add_pd(va, _mm512_loadu_pd(b + j));
+        _mm512_storeu_pd(c + j, _mm512_min_pd(_mm512_loadu_pd(c + j), candidate));
+    }
+    relaxScalar(c + j, b + j, a, n - j);
+}
+
+// With opmasks the improved lanes are stored directly; predecessors of 64-bit lanes are narrowed on the store.
+SIMD_TARGET_AVX512 void relaxAvx512Tracked(int32_t* c, int* pc, const int32_t* b, const int* pb, int32_t a, size_t n) {
+    const __m512i va = _mm512_set1_epi32(a);
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        const __m512i candidate = _mm512_add_epi32(va, _mm512_loadu_si512(b + j));
+        const __mmask16 better = _mm512_cmplt_epi32_mask(candidate, _mm512_loadu_si512(c + j));
+        _mm512_mask_storeu_epi32(c + j, better, candidate);
+        _mm512_mask_storeu_epi32(pc + j, better, _mm512_loadu_si512(pb + j));
+    }
+    relaxScalarTracked(c + j, pc + j, b + j, pb + j, a, n - j);
+}
+
+SIMD_TARGET_AVX512 void relaxAvx512Tracked(int64_t* c, int* pc, const int64_t* b, const int* pb, int64_t a, size_t n) {
+    const __m512i va = _mm512_set1_epi64(a);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        const __m512i candidate = _mm512_add_epi64(va, _mm512_loadu_si512(b + j));
+        const __mmask8 better = _mm512_cmplt_epi64_mask(candidate, _mm512_loadu_si512(c + j));
+        _mm512_mask_storeu_epi64(c + j, better, candidate);
+        const __m512i through = _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pb + j)));
+        _mm512_mask_cvtepi64_storeu_epi32(pc + j, better, through);
+    }
+    relaxScalarTracked(c + j, pc + j, b + j, pb + j, a, n - j);
+}
+
+SIMD_TARGET_AVX512 void relaxAvx512Tracked(float* c, int* pc, const float* b, const int* pb, float a, size_t n) {
+    const __m512 va = _mm512_set1_ps(a);
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        const __m512 candidate = _mm512_add_ps(va, _mm512_loadu_ps(b + j));
+        const __mmask16 better = _mm512_cmp_ps_mask(candidate, _mm512_loadu_ps(c + j), _CMP_LT_OQ);
+        _mm512_mask_storeu_ps(c + j, better, candidate);
+        _mm512_mask_storeu_epi32(pc + j, better, _mm512_loadu_si512(pb + j));
+    }
+    relaxScalarTracked(c + j, pc + j, b + j, pb + j, a, n - j);
+}
+
+SIMD_TARGET_AVX512 void relaxAvx512Tracked(double* c, int* pc, const double* b, const int* pb, double a, size_t n) {
+    const __m512d va = _mm512_set1_pd(a);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        const __m512d candidate = _mm512_add_pd(va, _mm512_loadu_pd(b + j));
+        const __mmask8 better = _mm512_cmp_pd_mask(candidate, _mm512_loadu_pd(c + j), _CMP_LT_OQ);
+        _mm512_mask_storeu_pd(c + j, better, candidate);
+        const __m512i through = _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pb + j)));
+        _mm512_mask_cvtepi64_storeu_epi32(pc + j, better, through);
+    }
+    relaxScalarTracked(c + j, pc + j, b + j, pb + j, a, n - j);
+}
+
+#endif
+
+template <typename L>
+struct RowKernel {
+    void (*relax)(L*, const L*, L, size_t);
+    void (*relaxTracked)(L*, int*, const L*, const int*, L, size_t);
+};
+
+template <typename L>
+RowKernel<L> selectKernel(SimdLevel level) {
+    RowKernel<L> kernel;
+    kernel.relax = relaxScalar<L>;
+    kernel.relaxTracked = relaxScalarTracked<L>;
+#if SIMD_X86
+    if (level == SIMD_AVX512) {
+        kernel.relax = relaxAvx512;
+        kernel.relaxTracked = relaxAvx512Tracked;
+    }
+    else if (level == SIMD_AVX2) {
+        kernel.relax = relaxAvx2;
+        kernel.relaxTracked = relaxAvx2Tracked;
+    }
+#else
+    (void)level;
+#endif
+    return kernel;
+}
+
+}
+
+template <typename W, typename D>
+BasicFloydWarshall<W, D>::BasicFloydWarshall(size_t threads, SimdLevel simd, size_t tileSize)
+    : threads(threads ? threads : hardwareThreads()), simd(supportedSimdLevel(simd)), tileSize(tileSize) {
+    if (tileSize == 0) {
+        throw std::invalid_argument("Tile size must be positive");
+    }
+}
+
+template <typename W, typename D>
+void BasicFloydWarshall<W, D>::run(const BasicGraph<W>& graph, AlignedMatrix<D>& distances, AlignedMatrix<int>* predecessors) const {
+    const size_t n = graph.getNumVertices();
+    AlignedMatrix<D> result(n, n, WeightTraits<D>::unreachable());
+    if (predecessors) *predecessors = AlignedMatrix<int>(n, n, -1);
+    D maxArc = D();
+    for (size_t u = 0; u < n; ++u) {
+        graph.forEachNeighbor(u, [&](size_t v, W weight) {
+            result[u][v] = static_cast<D>(weight);
+            if (predecessors) (*predecessors)[u][v] = static_cast<int>(u);
+            if (static_cast<D>(weight) > maxArc) maxArc = static_cast<D>(weight);
+        });
+    }
+    solve(result, predecessors, maxArc);
+    distances.swap(result);
+}
+
+template <typename W, typename D>
+void BasicFloydWarshall<W, D>::runInPlace(AlignedMatrix<D>& distances, AlignedMatrix<int>* predecessors) const {
+    const size_t n = distances.rows();
+    if (distances.cols() != n) {
+        throw std::invalid_argument("Distance matrix must be square");
+    }
+    if (predecessors) *predecessors = AlignedMatrix<int>(n, n, -1);
+    const D unreachable = WeightTraits<D>::unreachable();
+    D maxArc = D();
+    for (size_t u = 0; u < n; ++u) {
+        for (size_t v = 0; v < n; ++v) {
+            const D weight = distances[u][v];
+            if (weight == unreachable || u == v) continue;
+            if (weight < D() || weight != weight) {
+                throw std::invalid_argument("Edge weight cannot be negative");
+            }
+            if (predecessors) (*predecessors)[u][v] = static_cast<int>(u);
+            if (weight > maxArc) maxArc = weight;
+        }
+    }
+    solve(distances, predecessors, maxArc);
+}
+
+// Runs on the matrix reinterpreted as lanes: missing arcs become the lane limit on the way in and
+// the unreachable value on the way out.
+template <typename W, typename D>
+void BasicFloydWarshall<W, D>::solve(AlignedMatrix<D>& distances, AlignedMatrix<int>* predecessors, D maxArc) const {
+    typedef typename Lane<D>::type L;
+    static_assert(sizeof(L) == sizeof(D), "Lane type must match the distance type");
+    const size_t n = distances.rows();
+    const L limit = laneLimit<L>();
+    if (std::is_integral<D>::value && n > 1 && maxArc > D() &&
+        static_cast<uint64_t>(maxArc) > static_cast<uint64_t>(limit - 1) / (n - 1)) {
+        throw std::overflow_error("Path length overflows the distance type");
+    }
+
+    const D unreachable = WeightTraits<D>::unreachable();
+    for (size_t u = 0; u < n; ++u) {
+        D* row = distances[u];
+        L* lanes = reinterpret_cast<L*>(row);
+        for (size_t v = 0; v < n; ++v) {
+            if (u == v) lanes[v] = 0;
+            else if (row[v] == unreachable) lanes[v] = limit;
+            else lanes[v] = static_cast<L>(row[v]);
+        }
+    }
+
+    const RowKernel<L> kernel = selectKernel<L>(simd);
+    auto lanesOf = [&](size_t u) { return reinterpret_cast<L*>(distances[u]); };
+    auto updateTile = [&](size_t ib, size_t jb, size_t kb) {
+        const size_t i0 = ib * tileSize, i1 = std::min(n, i0 + tileSize);
+        const size_t j0 = jb * tileSize, j1 = std::min(n, j0 + tileSize);
+        const size_t k0 = kb * tileSize, k1 = std::min(n, k0 + tileSize);
+        for (size_t k = k0; k < k1; ++k) {
+            const L* through = lanesOf(k) + j0;
+            for (size_t i = i0; i < i1; ++i) {
+                L* row = lanesOf(i);
+                const L a = row[k];
+                if (!(a < limit)) continue;
+                if (predecessors) {
+                    kernel.relaxTracked(row + j0, (*predecessors)[i] + j0, through, (*predecessors)[k] + j0, a, j1 - j0);
+                }
+                else {
+                    kernel.relax(row + j0, through, a, j1 - j0);
+                }
+            }
+        }
+    };
+
+    // Tiles other than kb, numbered 0 .. blocks - 2.
+    const size_t blocks = (n + tileSize - 1) / tileSize;
+    const size_t others = blocks - 1;
+    const size_t workers = std::max<size_t>(1, std::min(threads, others * others));
+    Barrier barrier(workers);
+    parallelFor(workers, workers, [&](size_t t) {
+        for (size_t kb = 0; kb < blocks; ++kb) {
+            auto skip = [kb](size_t index) { return index < kb ? index : index + 1; };
+            if (t == 0) updateTile(kb, kb, kb);
+            barrier.wait();
+            for (size_t p = t; p < 2 * others; p += workers) {
+                if (p < others) updateTile(kb, skip(p), kb);
+                else updateTile(skip(p - others), kb, kb);
+            }
+            barrier.wait();
+            for (size_t p = t; p < others * others; p += workers) {
+                updateTile(skip(p / others), skip(p % others), kb);
+            }
+            barrier.wait();
+        }
+    });
+
+    for (size_t u = 0; u < n; ++u) {
+        D* row = distances[u];
+        const L* lanes = reinterpret_cast<const L*>(row);
+        for (size_t v = 0; v < n; ++v) {
+            row[v] = lanes[v] < limit ? static_cast<D>(lanes[v]) : unreachable;
+        }
+    }
+}
+
+template class BasicFloydWarshall<uint16_t, uint32_t>;
+template class BasicFloydWarshall<uint16_t, uint64_t>;
+template class BasicFloydWarshall<uint32_t, uint32_t>;
+template class BasicFloydWarshall<uint32_t, uint64_t>;
+template class BasicFloydWarshall<int, int>;
+template class BasicFloydWarshall<int, int64_t>;
+template class BasicFloydWarshall<int64_t, int64_t>;
+template class BasicFloydWarshall<float, float>;
+template class BasicFloydWarshall<float, double>;
+template class BasicFloydWarshall<double, double>;
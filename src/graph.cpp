@@ -1,7 +1,10 @@
 ﻿#include "graph.h"
 #include <iostream>
 
-Graph::Graph(size_t vertices) : numVertices(vertices), adjacencyMatrix(vertices, myVector<int>(vertices, -1)) {
+template <typename W>
+BasicGraph<W>::BasicGraph(size_t vertices, bool directed)
+    : numVertices(vertices), directed(directed), adjacencyMatrix(vertices, vertices, WeightTraits<W>::noEdge()),
+      edgeBits(vertices, (vertices + 63) / 64, 0), inEdgeBits(directed ? vertices : 0, directed ? (vertices + 63) / 64 : 0, 0), numArcs(0), version(0) {
     if (vertices == 0) {
         throw std::invalid_argument("Number of vertices must be positive");
     }
@@ -10,62 +13,123 @@ Graph::Graph(size_t vertices) : numVertices(vertices), adjacencyMatrix(vertices,
     }
 }
 
-void Graph::addEdge(size_t u, size_t v, int weight) {
-    if (weight <= 0) {
+template <typename W>
+void BasicGraph<W>::addEdge(size_t u, size_t v, W weight) {
+    if (!WeightTraits<W>::isValidWeight(weight)) {
         throw std::invalid_argument("Edge weight must be positive");
     }
     if (u < 0 || v < 0 || u >= numVertices || v >= numVertices) {
         throw std::out_of_range("Vertex index out of range");
     }
-    if (adjacencyMatrix[u][v] != -1) {
+    if (adjacencyMatrix[u][v] != WeightTraits<W>::noEdge()) {
         throw std::logic_error("Edge already exists. Multiple edges are not supported.");
     }
     adjacencyMatrix[u][v] = weight;
-    adjacencyMatrix[v][u] = weight; 
+    ++version;
+    setArc(u, v, true);
+    if (!directed) {
+        adjacencyMatrix[v][u] = weight;
+        setArc(v, u, true);
+    }
 }
 
-bool Graph::isConnected() const {
-    myVector<bool> visited(numVertices, false);
-    Stack<size_t> stack;
-    stack.push(0);
-    visited[0] = true;
-    size_t count = 1;
+template <typename W>
+void BasicGraph<W>::removeEdge(size_t u, size_t v) {
+    if (u >= numVertices || v >= numVertices) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (u == v || adjacencyMatrix[u][v] == WeightTraits<W>::noEdge()) {
+        throw std::logic_error("Edge does not exist");
+    }
+    adjacencyMatrix[u][v] = WeightTraits<W>::noEdge();
+    ++version;
+    setArc(u, v, false);
+    if (!directed) {
+        adjacencyMatrix[v][u] = WeightTraits<W>::noEdge();
+        setArc(v, u, false);
+    }
+}
+
+template <typename W>
+void BasicGraph<W>::updateEdgeWeight(size_t u, size_t v, W weight) {
+    if (!WeightTraits<W>::isValidWeight(weight)) {
+        throw std::invalid_argument("Edge weight must be positive");
+    }
+    if (u >= numVertices || v >= numVertices) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (u == v || adjacencyMatrix[u][v] == WeightTraits<W>::noEdge()) {
+        throw std::logic_error("Edge does not exist");
+    }
+    adjacencyMatrix[u][v] = weight;
+    ++version;
+    if (!directed) {
+        adjacencyMatrix[v][u] = weight;
+    }
+}
 
-    while (!stack.empty()) {
-        size_t current = stack.top();
-        stack.pop();
+// Level-synchronous BFS on bitsets: each frontier vertex ORs its whole bit row into the next frontier.
+template <typename W>
+bool BasicGraph<W>::isConnected() const {
+    const size_t words = edgeBits.cols();
+    myVector<uint64_t> visited(words, 0);
+    myVector<uint64_t> frontier(words, 0);
+    myVector<uint64_t> next(words, 0);
+    visited[0] = frontier[0] = 1;
+    size_t count = 1;
 
-        for (size_t neighbor = 0; neighbor < numVertices; ++neighbor) {
-            if (adjacencyMatrix[current][neighbor] != -1 && !visited[neighbor]) {
-                visited[neighbor] = true;
-                stack.push(neighbor);
-                count++;
+    bool grown = true;
+    while (grown) {
+        for (size_t w = 0; w < words; ++w) next[w] = 0;
+        forEachSetBit(frontier.data(), words, [&](size_t u) {
+            const uint64_t* out = edgeBits[u];
+            for (size_t w = 0; w < words; ++w) next[w] |= out[w];
+            if (directed) {
+                const uint64_t* in = inEdgeBits[u];
+                for (size_t w = 0; w < words; ++w) next[w] |= in[w];
             }
+        });
+
+        grown = false;
+        for (size_t w = 0; w < words; ++w) {
+            next[w] &= ~visited[w];
+            visited[w] |= next[w];
+            count += popCount(next[w]);
+            grown = grown || next[w] != 0;
         }
+        frontier.swap(next);
     }
 
     return count == numVertices;
 }
 
-void Graph::printGraph() const {
+template <typename W>
+void BasicGraph<W>::printGraph() const {
     std::cout << "Матрица смежности (" << numVertices << " вершин):\n";
     for (size_t i = 0; i < numVertices; ++i) {
+        const W* row = adjacencyMatrix[i];
         for (size_t j = 0; j < numVertices; ++j) {
-            if (adjacencyMatrix[i][j] == -1) std::cout << "- ";
-            else std::cout << adjacencyMatrix[i][j] << " ";
+            if (row[j] == WeightTraits<W>::noEdge()) std::cout << "- ";
+            else std::cout << row[j] << " ";
         }
         std::cout << "\n";
     }
 }
 
-int Graph::getEdgeWeight(size_t u, size_t v) const {
+template <typename W>
+W BasicGraph<W>::getEdgeWeight(size_t u, size_t v) const {
     if (u < 0 || v < 0 || u >= numVertices || v >= numVertices) {
         throw std::out_of_range("Vertex index out of range");
     }
     return adjacencyMatrix[u][v];
 }
 
-myVector<int> Graph::getPath(int start, int end, const myVector<int>& predecessors) const {
+template <typename W>
+myVector<int> BasicGraph<W>::getPath(int start, int end, const myVector<int>& predecessors) const {
+    return reconstructPath(start, end, predecessors);
+}
+
+myVector<int> reconstructPath(int start, int end, const myVector<int>& predecessors) {
     myVector<int> path;
     Stack<int> tempPath;
 
@@ -84,4 +148,11 @@ myVector<int> Graph::getPath(int start, int end, const myVector<int>& predecesso
     }
 
     return path;
-}
\ No newline at end of file
+}
+
+template class BasicGraph<uint16_t>;
+template class BasicGraph<uint32_t>;
+template class BasicGraph<int>;
+template class BasicGraph<int64_t>;
+template class BasicGraph<float>;
+template class BasicGraph<double>;
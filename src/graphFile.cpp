@@ -0,0 +1,195 @@
+#include "graphFile.h"
+#include "mappedFile.h"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+const char graphFileMagic[8] = { 'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H' };
+
+uint64_t alignSection(uint64_t position) {
+    const uint64_t alignment = GraphFileHeader::sectionAlignment;
+    return (position + alignment - 1) / alignment * alignment;
+}
+
+uint64_t sectionCount(const GraphFileHeader& header, int section) {
+    switch (section) {
+    case GraphFileHeader::OFFSETS:
+        return header.numVertices + 1;
+    case GraphFileHeader::TARGETS:
+    case GraphFileHeader::WEIGHTS:
+        return header.numArcs;
+    case GraphFileHeader::REVERSE_OFFSETS:
+        return (header.flags & GraphFileHeader::directedFlag) ? header.numVertices + 1 : 0;
+    default:
+        return header.numReverseArcs;
+    }
+}
+
+uint64_t elementSize(const GraphFileHeader& header, int section) {
+    switch (section) {
+    case GraphFileHeader::OFFSETS:
+    case GraphFileHeader::REVERSE_OFFSETS:
+        return sizeof(uint64_t);
+    case GraphFileHeader::TARGETS:
+    case GraphFileHeader::REVERSE_TARGETS:
+        return sizeof(uint32_t);
+    default:
+        return header.weightSize;
+    }
+}
+
+void describeSections(const GraphFileHeader& header, const void* const* data, FileSection* sections) {
+    for (int i = 0; i < GraphFileHeader::SECTION_COUNT; ++i) {
+        sections[i] = { data ? data[i] : nullptr, sectionCount(header, i), elementSize(header, i) };
+    }
+}
+
+}
+
+void writeSectionedFile(const std::string& path, const void* header, size_t headerSize, uint64_t* sectionOffsets,
+    const FileSection* sections, int count) {
+    uint64_t position = alignSection(headerSize);
+    for (int i = 0; i < count; ++i) {
+        const uint64_t bytes = sections[i].count * sections[i].elementBytes;
+        sectionOffsets[i] = bytes ? position : 0;
+        position = alignSection(position + bytes);
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot create file: " + path);
+    }
+
+    const char padding[GraphFileHeader::sectionAlignment] = {};
+    out.write(static_cast<const char*>(header), static_cast<std::streamsize>(headerSize));
+    uint64_t written = headerSize;
+    for (int i = 0; i < count; ++i) {
+        const uint64_t bytes = sections[i].count * sections[i].elementBytes;
+        if (bytes == 0) continue;
+        out.write(padding, static_cast<std::streamsize>(sectionOffsets[i] - written));
+        out.write(static_cast<const char*>(sections[i].data), static_cast<std::streamsize>(bytes));
+        written = sectionOffsets[i] + bytes;
+    }
+
+    if (!out) {
+        throw std::runtime_error("Cannot write file: " + path);
+    }
+}
+
+bool mapSections(const unsigned char* data, uint64_t size, const uint64_t* sectionOffsets, FileSection* sections, int count) {
+    for (int i = 0; i < count; ++i) {
+        sections[i].data = nullptr;
+        if (sections[i].count == 0) continue;
+        const uint64_t offset = sectionOffsets[i];
+        if (offset % GraphFileHeader::sectionAlignment != 0 || offset > size ||
+            sections[i].count > (size - offset) / sections[i].elementBytes) {
+            return false;
+        }
+        sections[i].data = data + offset;
+    }
+    return true;
+}
+
+bool isValidAdjacency(const uint64_t* offsets, const uint32_t* ids, uint64_t numVertices, uint64_t numEntries) {
+    if (offsets[0] != 0 || offsets[numVertices] != numEntries) return false;
+    for (uint64_t u = 0; u < numVertices; ++u) {
+        if (offsets[u] > offsets[u + 1]) return false;
+    }
+    for (uint64_t i = 0; i < numEntries; ++i) {
+        if (ids[i] >= numVertices) return false;
+    }
+    return true;
+}
+
+template <typename W>
+void saveGraphFile(const BasicCsrGraph<W>& graph, const std::string& path) {
+    GraphFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, graphFileMagic, sizeof(header.magic));
+    header.version = GraphFileHeader::currentVersion;
+    header.endian = GraphFileHeader::endianTag;
+    header.flags = (graph.isDirected() ? GraphFileHeader::directedFlag : 0) |
+        (weightKind<W>() << GraphFileHeader::weightKindShift);
+    header.weightSize = sizeof(W);
+    header.numVertices = graph.getNumVertices();
+    header.numArcs = graph.getNumArcs();
+    header.numReverseArcs = graph.isDirected() ? graph.getReverseOffsets()[graph.getNumVertices()] : 0;
+
+    const void* data[GraphFileHeader::SECTION_COUNT] = {
+        graph.getOffsets(), graph.getTargets(), graph.getWeights(),
+        graph.getReverseOffsets(), graph.getReverseTargets(), graph.getReverseWeights()
+    };
+    FileSection sections[GraphFileHeader::SECTION_COUNT];
+    describeSections(header, data, sections);
+    writeSectionedFile(path, &header, sizeof(header), header.sectionOffsets, sections, GraphFileHeader::SECTION_COUNT);
+}
+
+template <typename W>
+BasicCsrGraph<W> loadGraphFile(const std::string& path) {
+    auto file = std::make_shared<MappedFile>(path);
+    if (file->size() < sizeof(GraphFileHeader)) {
+        throw std::runtime_error("Not a graph file: " + path);
+    }
+
+    GraphFileHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, graphFileMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a graph file: " + path);
+    }
+    if (header.version != GraphFileHeader::currentVersion) {
+        throw std::runtime_error("Unsupported graph file version: " + path);
+    }
+    if (header.endian != GraphFileHeader::endianTag) {
+        throw std::runtime_error("Graph file was written on an incompatible platform: " + path);
+    }
+    const uint32_t kind = (header.flags & GraphFileHeader::weightKindMask) >> GraphFileHeader::weightKindShift;
+    if (header.weightSize != sizeof(W) || kind != weightKind<W>()) {
+        throw std::runtime_error("Graph file weight type does not match: " + path);
+    }
+    if (header.numVertices == 0 || header.numVertices > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Corrupted graph file: " + path);
+    }
+
+    const bool directed = (header.flags & GraphFileHeader::directedFlag) != 0;
+    FileSection sections[GraphFileHeader::SECTION_COUNT];
+    describeSections(header, nullptr, sections);
+    if (!mapSections(file->data(), file->size(), header.sectionOffsets, sections, GraphFileHeader::SECTION_COUNT)) {
+        throw std::runtime_error("Corrupted graph file: " + path);
+    }
+
+    BasicCsrGraph<W> graph(static_cast<size_t>(header.numVertices), directed, static_cast<size_t>(header.numArcs), file);
+    graph.offsets = static_cast<const uint64_t*>(sections[GraphFileHeader::OFFSETS].data);
+    graph.targets = static_cast<const uint32_t*>(sections[GraphFileHeader::TARGETS].data);
+    graph.weights = static_cast<const W*>(sections[GraphFileHeader::WEIGHTS].data);
+    if (!isValidAdjacency(graph.offsets, graph.targets, header.numVertices, header.numArcs)) {
+        throw std::runtime_error("Corrupted graph file: " + path);
+    }
+
+    if (directed) {
+        graph.reverseOffsets = static_cast<const uint64_t*>(sections[GraphFileHeader::REVERSE_OFFSETS].data);
+        graph.reverseTargets = static_cast<const uint32_t*>(sections[GraphFileHeader::REVERSE_TARGETS].data);
+        graph.reverseWeights = static_cast<const W*>(sections[GraphFileHeader::REVERSE_WEIGHTS].data);
+        if (!isValidAdjacency(graph.reverseOffsets, graph.reverseTargets, header.numVertices, header.numReverseArcs)) {
+            throw std::runtime_error("Corrupted graph file: " + path);
+        }
+    }
+
+    return graph;
+}
+
+template void saveGraphFile<uint16_t>(const BasicCsrGraph<uint16_t>&, const std::string&);
+template void saveGraphFile<uint32_t>(const BasicCsrGraph<uint32_t>&, const std::string&);
+template void saveGraphFile<int>(const BasicCsrGraph<int>&, const std::string&);
+template void saveGraphFile<int64_t>(const BasicCsrGraph<int64_t>&, const std::string&);
+template void saveGraphFile<float>(const BasicCsrGraph<float>&, const std::string&);
+template void saveGraphFile<double>(const BasicCsrGraph<double>&, const std::string&);
+
+template BasicCsrGraph<uint16_t> loadGraphFile<uint16_t>(const std::string&);
+template BasicCsrGraph<uint32_t> loadGraphFile<uint32_t>(const std::string&);
+template BasicCsrGraph<int> loadGraphFile<int>(const std::string&);
+template BasicCsrGraph<int64_t> loadGraphFile<int64_t>(const std::string&);
+template BasicCsrGraph<float> loadGraphFile<float>(const std::string&);
+template BasicCsrGraph<double> loadGraphFile<double>(const std::string&);
@@ -0,0 +1,407 @@
+#include "graphImport.h"
+#include "mappedFile.h"
+#include "parallel.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+template <typename W>
+struct ParsedEdge {
+    uint64_t u;
+    uint64_t v;
+    W weight;
+};
+
+template <typename W>
+struct ParsedChunk {
+    myVector<ParsedEdge<W>> edges;
+    uint64_t maxVertex = 0;
+};
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+void skipBlanks(const char*& p, const char* end) {
+    while (p < end && isBlank(*p)) ++p;
+}
+
+const char* nextLine(const char* p, const char* end) {
+    const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+    return newline ? newline + 1 : end;
+}
+
+const char* lineEnd(const char* p, const char* end) {
+    const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+    return newline ? newline : end;
+}
+
+bool parseUnsigned(const char*& p, const char* end, uint64_t& value) {
+    skipBlanks(p, end);
+    if (p == end || *p < '0' || *p > '9') return false;
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        const uint64_t digit = static_cast<uint64_t>(*p - '0');
+        // A number past 64 bits is as malformed as a missing one; wrapping would yield a plausible id.
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10) return false;
+        value = value * 10 + digit;
+        ++p;
+    }
+    return true;
+}
+
+bool parseReal(const char*& p, const char* end, double& value) {
+    skipBlanks(p, end);
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    bool digits = false;
+    double mantissa = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        mantissa = mantissa * 10 + (*p - '0');
+        digits = true;
+        ++p;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        double scale = 0.1;
+        while (p < end && *p >= '0' && *p <= '9') {
+            mantissa += (*p - '0') * scale;
+            scale *= 0.1;
+            digits = true;
+            ++p;
+        }
+    }
+    if (!digits) return false;
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        uint64_t exponent = 0;
+        if (!parseUnsigned(p, end, exponent)) return false;
+        mantissa *= std::pow(10.0, negativeExponent ? -static_cast<double>(exponent) : static_cast<double>(exponent));
+    }
+
+    value = negative ? -mantissa : mantissa;
+    return true;
+}
+
+bool sameWord(const char*& p, const char* end, const char* word) {
+    skipBlanks(p, end);
+    const size_t length = std::strlen(word);
+    if (static_cast<size_t>(end - p) < length) return false;
+    for (size_t i = 0; i < length; ++i) {
+        char c = p[i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != word[i]) return false;
+    }
+    p += length;
+    return true;
+}
+
+// Weights the graph would refuse (zero, negative, or the values reserved for missing edges) are
+// reported as malformed input rather than left to the builder's invalid_argument.
+template <typename W>
+W checkedWeight(W weight, const std::string& path) {
+    if (!WeightTraits<W>::isValidWeight(weight)) {
+        throw std::runtime_error("Edge weight must be positive in " + path);
+    }
+    return weight;
+}
+
+template <typename W>
+W toWeight(uint64_t value, const std::string& path) {
+    if (static_cast<double>(value) > static_cast<double>(std::numeric_limits<W>::max())) {
+        throw std::runtime_error("Edge weight does not fit the weight type in " + path);
+    }
+    return checkedWeight(static_cast<W>(value), path);
+}
+
+template <typename W>
+W toWeight(double value, const std::string& path) {
+    if (std::is_floating_point<W>::value) {
+        return checkedWeight(static_cast<W>(value), path);
+    }
+    const double rounded = std::floor(value + 0.5);
+    if (rounded > static_cast<double>(std::numeric_limits<W>::max()) ||
+        rounded < static_cast<double>(std::numeric_limits<W>::lowest())) {
+        throw std::runtime_error("Edge weight does not fit the weight type in " + path);
+    }
+    return checkedWeight(static_cast<W>(rounded), path);
+}
+
+void malformed(const std::string& path) {
+    throw std::runtime_error("Malformed line in " + path);
+}
+
+// parseLine(lineBegin, lineEnd, chunk) is called for every line of the body in parallel.
+template <typename W, typename ParseLine>
+myVector<ParsedChunk<W>> parseBody(const char* begin, const char* end, size_t threads, ParseLine parseLine) {
+    if (threads == 0) threads = hardwareThreads();
+    const size_t bytes = static_cast<size_t>(end - begin);
+    const size_t chunks = bytes == 0 ? 1 : std::min(threads, bytes);
+
+    myVector<const char*> bounds(chunks + 1);
+    bounds[0] = begin;
+    bounds[chunks] = end;
+    for (size_t i = 1; i < chunks; ++i) {
+        bounds[i] = nextLine(begin + bytes * i / chunks - 1, end);
+    }
+
+    myVector<ParsedChunk<W>> parsed(chunks);
+    parallelFor(chunks, threads, [&](size_t i) {
+        const char* p = bounds[i];
+        const char* chunkEnd = bounds[i + 1];
+        while (p < chunkEnd) {
+            const char* eol = lineEnd(p, chunkEnd);
+            parseLine(p, eol, parsed[i]);
+            p = eol < chunkEnd ? eol + 1 : chunkEnd;
+        }
+    });
+    return parsed;
+}
+
+template <typename W>
+BasicCsrGraph<W> buildGraph(myVector<ParsedChunk<W>>& chunks, size_t vertices, bool directed, size_t threads,
+    const std::string& path) {
+    if (vertices == 0) {
+        throw std::runtime_error("Graph file has no vertices: " + path);
+    }
+    if (vertices > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Too many vertices in " + path);
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        total += chunks[i].edges.size();
+    }
+
+    BasicCsrGraphBuilder<W> builder(vertices, directed);
+    builder.reserve(total);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const myVector<ParsedEdge<W>>& edges = chunks[i].edges;
+        for (size_t j = 0; j < edges.size(); ++j) {
+            if (edges[j].u >= vertices || edges[j].v >= vertices) {
+                throw std::runtime_error("Vertex id out of range in " + path);
+            }
+            if (edges[j].u == edges[j].v) continue;
+            builder.addEdge(static_cast<size_t>(edges[j].u), static_cast<size_t>(edges[j].v), edges[j].weight);
+        }
+        chunks[i].edges = myVector<ParsedEdge<W>>();
+    }
+    return builder.build(threads);
+}
+
+}
+
+template <typename W>
+BasicCsrGraph<W> importDimacs(const std::string& path, bool directed, size_t threads) {
+    MappedFile file(path);
+    const char* p = reinterpret_cast<const char*>(file.data());
+    const char* end = p + file.size();
+
+    uint64_t vertices = 0;
+    bool haveProblem = false;
+    while (p < end && !haveProblem) {
+        const char* eol = lineEnd(p, end);
+        const char* q = p;
+        skipBlanks(q, eol);
+        if (q < eol && *q == 'p') {
+            ++q;
+            uint64_t arcs = 0;
+            if (!sameWord(q, eol, "sp") || !parseUnsigned(q, eol, vertices) || !parseUnsigned(q, eol, arcs)) {
+                malformed(path);
+            }
+            haveProblem = true;
+        }
+        else if (q < eol && *q != 'c') {
+            throw std::runtime_error("Missing problem line in " + path);
+        }
+        p = eol < end ? eol + 1 : end;
+    }
+    if (!haveProblem) {
+        throw std::runtime_error("Missing problem line in " + path);
+    }
+
+    auto chunks = parseBody<W>(p, end, threads, [&](const char* q, const char* eol, ParsedChunk<W>& chunk) {
+        skipBlanks(q, eol);
+        if (q == eol || *q == 'c') return;
+        if (*q != 'a') malformed(path);
+        ++q;
+
+        uint64_t u, v, w;
+        if (!parseUnsigned(q, eol, u) || !parseUnsigned(q, eol, v) || !parseUnsigned(q, eol, w) ||
+            u == 0 || v == 0 || u > vertices || v > vertices) {
+            malformed(path);
+        }
+        chunk.edges.push_back({ u - 1, v - 1, toWeight<W>(w, path) });
+    });
+
+    return buildGraph(chunks, static_cast<size_t>(vertices), directed, threads, path);
+}
+
+template <typename W>
+BasicCsrGraph<W> importSnapEdgeList(const std::string& path, bool directed, size_t threads) {
+    MappedFile file(path);
+    const char* begin = reinterpret_cast<const char*>(file.data());
+    const char* end = begin + file.size();
+
+    auto chunks = parseBody<W>(begin, end, threads, [&](const char* q, const char* eol, ParsedChunk<W>& chunk) {
+        skipBlanks(q, eol);
+        if (q == eol || *q == '#' || *q == '%') return;
+
+        uint64_t u, v, w = 1;
+        if (!parseUnsigned(q, eol, u) || !parseUnsigned(q, eol, v)) {
+            malformed(path);
+        }
+        skipBlanks(q, eol);
+        if (q < eol && !parseUnsigned(q, eol, w)) {
+            malformed(path);
+        }
+        chunk.edges.push_back({ u, v, toWeight<W>(w, path) });
+        chunk.maxVertex = std::max(chunk.maxVertex, std::max(u, v));
+    });
+
+    uint64_t vertices = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (!chunks[i].edges.empty()) {
+            vertices = std::max(vertices, chunks[i].maxVertex + 1);
+        }
+    }
+    return buildGraph(chunks, static_cast<size_t>(vertices), directed, threads, path);
+}
+
+template <typename W>
+BasicCsrGraph<W> importMatrixMarket(const std::string& path, size_t threads) {
+    MappedFile file(path);
+    const char* p = reinterpret_cast<const char*>(file.data());
+    const char* end = p + file.size();
+
+    const char* eol = lineEnd(p, end);
+    if (!sameWord(p, eol, "%%matrixmarket") || !sameWord(p, eol, "matrix") || !sameWord(p, eol, "coordinate")) {
+        throw std::runtime_error("Not a Matrix Market coordinate file: " + path);
+    }
+
+    bool pattern = false;
+    if (sameWord(p, eol, "pattern")) {
+        pattern = true;
+    }
+    else if (!sameWord(p, eol, "real") && !sameWord(p, eol, "integer")) {
+        throw std::runtime_error("Unsupported Matrix Market field type in " + path);
+    }
+
+    bool symmetric = false;
+    if (sameWord(p, eol, "symmetric")) {
+        symmetric = true;
+    }
+    else if (!sameWord(p, eol, "general")) {
+        throw std::runtime_error("Unsupported Matrix Market symmetry in " + path);
+    }
+    p = eol < end ? eol + 1 : end;
+
+    uint64_t rows = 0, cols = 0, entries = 0;
+    bool haveSize = false;
+    while (p < end && !haveSize) {
+        eol = lineEnd(p, end);
+        const char* q = p;
+        skipBlanks(q, eol);
+        if (q < eol && *q != '%') {
+            if (!parseUnsigned(q, eol, rows) || !parseUnsigned(q, eol, cols) || !parseUnsigned(q, eol, entries)) {
+                malformed(path);
+            }
+            haveSize = true;
+        }
+        p = eol < end ? eol + 1 : end;
+    }
+    if (!haveSize) {
+        throw std::runtime_error("Missing size line in " + path);
+    }
+    const uint64_t vertices = std::max(rows, cols);
+
+    auto chunks = parseBody<W>(p, end, threads, [&](const char* q, const char* lineEndPtr, ParsedChunk<W>& chunk) {
+        skipBlanks(q, lineEndPtr);
+        if (q == lineEndPtr || *q == '%') return;
+
+        uint64_t i, j;
+        if (!parseUnsigned(q, lineEndPtr, i) || !parseUnsigned(q, lineEndPtr, j) ||
+            i == 0 || j == 0 || i > rows || j > cols) {
+            malformed(path);
+        }
+
+        W weight = 1;
+        if (!pattern) {
+            double value;
+            if (!parseReal(q, lineEndPtr, value)) malformed(path);
+            weight = toWeight<W>(value, path);
+        }
+        chunk.edges.push_back({ i - 1, j - 1, weight });
+    });
+
+    return buildGraph(chunks, static_cast<size_t>(vertices), !symmetric, threads, path);
+}
+
+VertexCoordinates importDimacsCoordinates(const std::string& path) {
+    MappedFile file(path);
+    const char* p = reinterpret_cast<const char*>(file.data());
+    const char* end = p + file.size();
+
+    uint64_t vertices = 0;
+    bool haveProblem = false;
+    VertexCoordinates coordinates(0);
+    while (p < end) {
+        const char* eol = lineEnd(p, end);
+        const char* q = p;
+        p = eol < end ? eol + 1 : end;
+        skipBlanks(q, eol);
+        if (q == eol || *q == 'c') continue;
+
+        if (*q == 'p' && !haveProblem) {
+            ++q;
+            if (!sameWord(q, eol, "aux") || !sameWord(q, eol, "sp") || !sameWord(q, eol, "co") ||
+                !parseUnsigned(q, eol, vertices) || vertices == 0) {
+                malformed(path);
+            }
+            coordinates = VertexCoordinates(static_cast<size_t>(vertices));
+            haveProblem = true;
+            continue;
+        }
+        if (*q != 'v' || !haveProblem) {
+            throw std::runtime_error("Missing problem line in " + path);
+        }
+        ++q;
+
+        uint64_t id;
+        double x, y;
+        if (!parseUnsigned(q, eol, id) || !parseReal(q, eol, x) || !parseReal(q, eol, y) || id == 0 || id > vertices) {
+            malformed(path);
+        }
+        coordinates.set(static_cast<size_t>(id - 1), x, y);
+    }
+    if (!haveProblem) {
+        throw std::runtime_error("Missing problem line in " + path);
+    }
+    return coordinates;
+}
+
+#define INSTANTIATE_IMPORTERS(W) \
+    template BasicCsrGraph<W> importDimacs<W>(const std::string&, bool, size_t); \
+    template BasicCsrGraph<W> importSnapEdgeList<W>(const std::string&, bool, size_t); \
+    template BasicCsrGraph<W> importMatrixMarket<W>(const std::string&, size_t);
+
+INSTANTIATE_IMPORTERS(uint16_t)
+INSTANTIATE_IMPORTERS(uint32_t)
+INSTANTIATE_IMPORTERS(int)
+INSTANTIATE_IMPORTERS(int64_t)
+INSTANTIATE_IMPORTERS(float)
+INSTANTIATE_IMPORTERS(double)
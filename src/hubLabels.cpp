@@ -0,0 +1,323 @@
+#include "hubLabels.h"
+#include "graphFile.h"
+#include "mappedFile.h"
+#include "parallel.h"
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const char hubLabelFileMagic[8] = { 'H', 'U', 'B', 'L', 'A', 'B', 'E', 'L' };
+const uint32_t hubLabelFileVersion = 1;
+
+// Same flag layout and section alignment as GraphFileHeader; the backward sections exist only for directed graphs.
+struct HubLabelFileHeader {
+    enum Section { FORWARD_OFFSETS, FORWARD_HUBS, FORWARD_DISTANCES, BACKWARD_OFFSETS, BACKWARD_HUBS, BACKWARD_DISTANCES, SECTION_COUNT };
+
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+    uint32_t flags;
+    uint32_t distanceSize;
+    uint64_t numVertices;
+    uint64_t numForwardEntries;
+    uint64_t numBackwardEntries;
+    uint64_t sectionOffsets[SECTION_COUNT];
+};
+
+void describeSections(const HubLabelFileHeader& header, const void* const* data, FileSection* sections) {
+    const uint64_t backwardOffsets = (header.flags & GraphFileHeader::directedFlag) ? header.numVertices + 1 : 0;
+    const uint64_t counts[HubLabelFileHeader::SECTION_COUNT] = {
+        header.numVertices + 1, header.numForwardEntries, header.numForwardEntries,
+        backwardOffsets, header.numBackwardEntries, header.numBackwardEntries
+    };
+    const uint64_t sizes[HubLabelFileHeader::SECTION_COUNT] = {
+        sizeof(uint64_t), sizeof(uint32_t), header.distanceSize, sizeof(uint64_t), sizeof(uint32_t), header.distanceSize
+    };
+    for (int i = 0; i < HubLabelFileHeader::SECTION_COUNT; ++i) {
+        sections[i] = { data ? data[i] : nullptr, counts[i], sizes[i] };
+    }
+}
+
+// Shortest path length through a hub common to both labels, each sorted by hub.
+// The cursors advance by comparison results rather than through an if/else chain; common hubs still take a branch.
+template <typename D>
+D mergeLabels(const uint32_t* hubsA, const D* distancesA, size_t sizeA, const uint32_t* hubsB, const D* distancesB, size_t sizeB) {
+    D best = WeightTraits<D>::infinity();
+    size_t i = 0;
+    size_t j = 0;
+    while (i < sizeA && j < sizeB) {
+        const uint32_t a = hubsA[i];
+        const uint32_t b = hubsB[j];
+        if (a == b) {
+            const D total = addDistance(distancesA[i], distancesB[j]);
+            if (total < best) best = total;
+        }
+        i += a <= b;
+        j += b <= a;
+    }
+    return best;
+}
+
+template <typename D>
+struct Label {
+    myVector<uint32_t> hubs;
+    myVector<D> distances;
+};
+
+template <typename D>
+struct HubEntry {
+    uint32_t hub;
+    D distance;
+};
+
+// Label of v from the labels of the higher-ranked vertices its arcs lead to. An entry is pruned when the
+// label itself together with the opposite label of its hub proves a shorter path; opposite labels of
+// hubs are already final because hubs always lie on an earlier level.
+template <typename D, typename ForEachArc>
+void buildLabel(uint32_t v, ForEachArc&& forEachArc, const myVector<Label<D>>& labels, const myVector<Label<D>>& opposite, Label<D>& result) {
+    myVector<HubEntry<D>> candidates;
+    candidates.push_back({ v, 0 });
+    forEachArc([&](size_t w, D weight) {
+        const Label<D>& label = labels[w];
+        for (size_t i = 0; i < label.hubs.size(); ++i) {
+            candidates.push_back({ label.hubs[i], addDistance(weight, label.distances[i]) });
+        }
+    });
+    std::sort(candidates.data(), candidates.data() + candidates.size(), [](const HubEntry<D>& a, const HubEntry<D>& b) {
+        return a.hub < b.hub || (a.hub == b.hub && a.distance < b.distance);
+    });
+
+    Label<D> merged;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (i > 0 && candidates[i].hub == candidates[i - 1].hub) continue;
+        merged.hubs.push_back(candidates[i].hub);
+        merged.distances.push_back(candidates[i].distance);
+    }
+
+    for (size_t i = 0; i < merged.hubs.size(); ++i) {
+        const uint32_t hub = merged.hubs[i];
+        if (hub != v) {
+            const Label<D>& other = opposite[hub];
+            const D shortest = mergeLabels(merged.hubs.data(), merged.distances.data(), merged.hubs.size(),
+                other.hubs.data(), other.distances.data(), other.hubs.size());
+            if (shortest < merged.distances[i]) continue;
+        }
+        result.hubs.push_back(hub);
+        result.distances.push_back(merged.distances[i]);
+    }
+}
+
+template <typename D>
+void flattenLabels(myVector<Label<D>>& labels, myVector<uint64_t>& offsets, myVector<uint32_t>& hubs, myVector<D>& distances) {
+    const size_t n = labels.size();
+    offsets.resize(n + 1);
+    offsets[0] = 0;
+    for (size_t v = 0; v < n; ++v) {
+        offsets[v + 1] = offsets[v] + labels[v].hubs.size();
+    }
+    hubs.resize(static_cast<size_t>(offsets[n]));
+    distances.resize(static_cast<size_t>(offsets[n]));
+    for (size_t v = 0; v < n; ++v) {
+        const size_t begin = static_cast<size_t>(offsets[v]);
+        std::copy(labels[v].hubs.data(), labels[v].hubs.data() + labels[v].hubs.size(), hubs.data() + begin);
+        std::copy(labels[v].distances.data(), labels[v].distances.data() + labels[v].distances.size(), distances.data() + begin);
+        labels[v] = Label<D>();
+    }
+}
+
+}
+
+template <typename W, typename D>
+BasicHubLabels<W, D>::BasicHubLabels(const BasicContractionHierarchy<W, D>& hierarchy, size_t threads)
+    : numVertices(hierarchy.getNumVertices()), directed(hierarchy.isDirected()) {
+    const size_t n = numVertices;
+
+    // A vertex's level is one more than the deepest level among the higher-ranked vertices it has arcs with,
+    // so the labels of one level depend only on earlier levels and can be built concurrently.
+    myVector<uint32_t> byRank(n);
+    for (size_t v = 0; v < n; ++v) {
+        byRank[hierarchy.getRank(v)] = static_cast<uint32_t>(v);
+    }
+    myVector<uint32_t> level(n, 0);
+    uint32_t levels = 0;
+    for (size_t r = n; r-- > 0;) {
+        const uint32_t v = byRank[r];
+        auto deepen = [&](size_t w, D) {
+            if (level[v] < level[w] + 1) level[v] = level[w] + 1;
+        };
+        hierarchy.forEachUpArc(v, deepen);
+        hierarchy.forEachDownArc(v, deepen);
+        if (level[v] + 1 > levels) levels = level[v] + 1;
+    }
+    myVector<uint64_t> levelStart(levels + 1, 0);
+    for (size_t v = 0; v < n; ++v) {
+        ++levelStart[level[v] + 1];
+    }
+    for (uint32_t l = 0; l < levels; ++l) {
+        levelStart[l + 1] += levelStart[l];
+    }
+    myVector<uint32_t> byLevel(n);
+    myVector<uint64_t> fill(levelStart);
+    for (size_t v = 0; v < n; ++v) {
+        byLevel[static_cast<size_t>(fill[level[v]]++)] = static_cast<uint32_t>(v);
+    }
+
+    myVector<Label<D>> forward(n);
+    myVector<Label<D>> backward(directed ? n : 0);
+    for (uint32_t l = 0; l < levels; ++l) {
+        const size_t begin = static_cast<size_t>(levelStart[l]);
+        parallelFor(static_cast<size_t>(levelStart[l + 1]) - begin, threads, [&](size_t i) {
+            const uint32_t v = byLevel[begin + i];
+            auto upArcs = [&](auto&& f) { hierarchy.forEachUpArc(v, f); };
+            if (!directed) {
+                buildLabel(v, upArcs, forward, forward, forward[v]);
+                return;
+            }
+            auto downArcs = [&](auto&& f) { hierarchy.forEachDownArc(v, f); };
+            buildLabel(v, upArcs, forward, backward, forward[v]);
+            buildLabel(v, downArcs, backward, forward, backward[v]);
+        });
+    }
+
+    auto storage = std::make_shared<Storage>();
+    flattenLabels(forward, storage->forwardOffsets, storage->forwardHubs, storage->forwardDistances);
+    forwardOffsets = storage->forwardOffsets.data();
+    forwardHubs = storage->forwardHubs.data();
+    forwardDistances = storage->forwardDistances.data();
+    if (directed) {
+        flattenLabels(backward, storage->backwardOffsets, storage->backwardHubs, storage->backwardDistances);
+        backwardOffsets = storage->backwardOffsets.data();
+        backwardHubs = storage->backwardHubs.data();
+        backwardDistances = storage->backwardDistances.data();
+    }
+    else {
+        backwardOffsets = forwardOffsets;
+        backwardHubs = forwardHubs;
+        backwardDistances = forwardDistances;
+    }
+    owner = storage;
+}
+
+template <typename W, typename D>
+D BasicHubLabels<W, D>::distance(int source, int target) const {
+    const int n = static_cast<int>(numVertices);
+    if (source < 0 || source >= n) {
+        throw std::out_of_range("Start vertex out of range");
+    }
+    if (target < 0 || target >= n) {
+        throw std::out_of_range("Target vertex out of range");
+    }
+    const uint64_t s = forwardOffsets[source];
+    const uint64_t t = backwardOffsets[target];
+    const D best = mergeLabels(forwardHubs + s, forwardDistances + s, static_cast<size_t>(forwardOffsets[source + 1] - s),
+        backwardHubs + t, backwardDistances + t, static_cast<size_t>(backwardOffsets[target + 1] - t));
+    return best == WeightTraits<D>::infinity() ? WeightTraits<D>::unreachable() : best;
+}
+
+template <typename W, typename D>
+typename BasicHubLabels<W, D>::Stats BasicHubLabels<W, D>::getStats() const {
+    Stats stats;
+    stats.forwardEntries = forwardOffsets[numVertices];
+    stats.backwardEntries = directed ? backwardOffsets[numVertices] : 0;
+    stats.maxLabelSize = 0;
+    for (size_t v = 0; v < numVertices; ++v) {
+        if (getForwardLabelSize(v) > stats.maxLabelSize) stats.maxLabelSize = getForwardLabelSize(v);
+        if (getBackwardLabelSize(v) > stats.maxLabelSize) stats.maxLabelSize = getBackwardLabelSize(v);
+    }
+    const uint64_t entries = stats.forwardEntries + stats.backwardEntries;
+    const uint64_t labelSets = directed ? 2 : 1;
+    stats.averageLabelSize = static_cast<double>(entries) / static_cast<double>(numVertices * labelSets);
+    stats.memoryBytes = labelSets * (numVertices + 1) * sizeof(uint64_t) + entries * (sizeof(uint32_t) + sizeof(D));
+    return stats;
+}
+
+template <typename W, typename D>
+void BasicHubLabels<W, D>::save(const std::string& path) const {
+    HubLabelFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, hubLabelFileMagic, sizeof(header.magic));
+    header.version = hubLabelFileVersion;
+    header.endian = GraphFileHeader::endianTag;
+    header.flags = (directed ? GraphFileHeader::directedFlag : 0) | (weightKind<D>() << GraphFileHeader::weightKindShift);
+    header.distanceSize = sizeof(D);
+    header.numVertices = numVertices;
+    header.numForwardEntries = forwardOffsets[numVertices];
+    header.numBackwardEntries = directed ? backwardOffsets[numVertices] : 0;
+
+    const void* data[HubLabelFileHeader::SECTION_COUNT] = {
+        forwardOffsets, forwardHubs, forwardDistances, backwardOffsets, backwardHubs, backwardDistances
+    };
+    FileSection sections[HubLabelFileHeader::SECTION_COUNT];
+    describeSections(header, data, sections);
+    writeSectionedFile(path, &header, sizeof(header), header.sectionOffsets, sections, HubLabelFileHeader::SECTION_COUNT);
+}
+
+template <typename W, typename D>
+BasicHubLabels<W, D> BasicHubLabels<W, D>::load(const std::string& path) {
+    auto file = std::make_shared<MappedFile>(path);
+    if (file->size() < sizeof(HubLabelFileHeader)) {
+        throw std::runtime_error("Not a hub label file: " + path);
+    }
+
+    HubLabelFileHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, hubLabelFileMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a hub label file: " + path);
+    }
+    if (header.version != hubLabelFileVersion) {
+        throw std::runtime_error("Unsupported hub label file version: " + path);
+    }
+    if (header.endian != GraphFileHeader::endianTag) {
+        throw std::runtime_error("Hub label file was written on an incompatible platform: " + path);
+    }
+    const uint32_t kind = (header.flags & GraphFileHeader::weightKindMask) >> GraphFileHeader::weightKindShift;
+    if (header.distanceSize != sizeof(D) || kind != weightKind<D>()) {
+        throw std::runtime_error("Hub label file distance type does not match: " + path);
+    }
+    if (header.numVertices == 0 || header.numVertices > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Corrupted hub label file: " + path);
+    }
+
+    FileSection sections[HubLabelFileHeader::SECTION_COUNT];
+    describeSections(header, nullptr, sections);
+    if (!mapSections(file->data(), file->size(), header.sectionOffsets, sections, HubLabelFileHeader::SECTION_COUNT)) {
+        throw std::runtime_error("Corrupted hub label file: " + path);
+    }
+
+    BasicHubLabels labels;
+    labels.numVertices = static_cast<size_t>(header.numVertices);
+    labels.directed = (header.flags & GraphFileHeader::directedFlag) != 0;
+    labels.forwardOffsets = static_cast<const uint64_t*>(sections[HubLabelFileHeader::FORWARD_OFFSETS].data);
+    labels.forwardHubs = static_cast<const uint32_t*>(sections[HubLabelFileHeader::FORWARD_HUBS].data);
+    labels.forwardDistances = static_cast<const D*>(sections[HubLabelFileHeader::FORWARD_DISTANCES].data);
+    if (!isValidAdjacency(labels.forwardOffsets, labels.forwardHubs, header.numVertices, header.numForwardEntries)) {
+        throw std::runtime_error("Corrupted hub label file: " + path);
+    }
+    if (labels.directed) {
+        labels.backwardOffsets = static_cast<const uint64_t*>(sections[HubLabelFileHeader::BACKWARD_OFFSETS].data);
+        labels.backwardHubs = static_cast<const uint32_t*>(sections[HubLabelFileHeader::BACKWARD_HUBS].data);
+        labels.backwardDistances = static_cast<const D*>(sections[HubLabelFileHeader::BACKWARD_DISTANCES].data);
+        if (!isValidAdjacency(labels.backwardOffsets, labels.backwardHubs, header.numVertices, header.numBackwardEntries)) {
+            throw std::runtime_error("Corrupted hub label file: " + path);
+        }
+    }
+    else {
+        labels.backwardOffsets = labels.forwardOffsets;
+        labels.backwardHubs = labels.forwardHubs;
+        labels.backwardDistances = labels.forwardDistances;
+    }
+    labels.owner = file;
+    return labels;
+}
+
+template class BasicHubLabels<uint16_t, uint32_t>;
+template class BasicHubLabels<uint16_t, uint64_t>;
+template class BasicHubLabels<uint32_t, uint32_t>;
+template class BasicHubLabels<uint32_t, uint64_t>;
+template class BasicHubLabels<int, int>;
+template class BasicHubLabels<int, int64_t>;
+template class BasicHubLabels<int64_t, int64_t>;
+template class BasicHubLabels<float, float>;
+template class BasicHubLabels<float, double>;
+template class BasicHubLabels<double, double>;
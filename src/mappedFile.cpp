@@ -0,0 +1,132 @@
+#include "mappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path)
+    : data_(nullptr), size_(0), writable(false), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize)) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot read file size: " + path);
+    }
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    if (size_ == 0) {
+        return;
+    }
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    data_ = static_cast<unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!data_) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+}
+
+MappedFile::MappedFile(const std::string& path, size_t size)
+    : data_(nullptr), size_(size), writable(true), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot create file: " + path);
+    }
+    if (size_ == 0) {
+        return;
+    }
+
+    const unsigned long long fullSize = size_;
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(fullSize >> 32), static_cast<DWORD>(fullSize & 0xFFFFFFFFull), nullptr);
+    if (!mappingHandle) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    data_ = static_cast<unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_WRITE, 0, 0, 0));
+    if (!data_) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data_) UnmapViewOfFile(data_);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) : data_(nullptr), size_(0), writable(false), fd(-1) {
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("Cannot read file size: " + path);
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    if (size_ == 0) {
+        return;
+    }
+
+    void* address = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    data_ = static_cast<unsigned char*>(address);
+}
+
+MappedFile::MappedFile(const std::string& path, size_t size) : data_(nullptr), size_(size), writable(true), fd(-1) {
+    fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create file: " + path);
+    }
+    if (ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        close(fd);
+        throw std::runtime_error("Cannot resize file: " + path);
+    }
+    if (size_ == 0) {
+        return;
+    }
+
+    void* address = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    data_ = static_cast<unsigned char*>(address);
+}
+
+MappedFile::~MappedFile() {
+    if (data_) munmap(data_, size_);
+    if (fd >= 0) close(fd);
+}
+
+#endif
@@ -0,0 +1,232 @@
+#include "reorder.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+template <typename W>
+size_t undirectedDegree(const BasicCsrGraph<W>& graph, size_t v) {
+    return graph.isDirected() ? graph.getDegree(v) + graph.getInDegree(v) : graph.getDegree(v);
+}
+
+template <typename W, typename F>
+void forEachUndirectedNeighbor(const BasicCsrGraph<W>& graph, size_t v, F&& f) {
+    graph.forEachNeighbor(v, [&](size_t u, W) { f(u); });
+    if (graph.isDirected()) {
+        graph.forEachInNeighbor(v, [&](size_t u, W) { f(u); });
+    }
+}
+
+myVector<uint32_t> orderToPermutation(const myVector<uint32_t>& order) {
+    myVector<uint32_t> permutation(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        permutation[order[i]] = static_cast<uint32_t>(i);
+    }
+    return permutation;
+}
+
+// Breadth-first layout of one component into order[], optionally visiting neighbors by ascending degree.
+template <typename W>
+void bfsComponent(const BasicCsrGraph<W>& graph, uint32_t root, bool byDegree, myVector<bool>& placed,
+    myVector<uint32_t>& order) {
+    size_t head = order.size();
+    order.push_back(root);
+    placed[root] = true;
+
+    myVector<uint32_t> neighbors;
+    while (head < order.size()) {
+        const uint32_t v = order[head++];
+        neighbors.clear();
+        forEachUndirectedNeighbor(graph, v, [&](size_t u) {
+            if (!placed[u]) {
+                placed[u] = true;
+                neighbors.push_back(static_cast<uint32_t>(u));
+            }
+        });
+        if (byDegree) {
+            std::stable_sort(neighbors.data(), neighbors.data() + neighbors.size(), [&](uint32_t a, uint32_t b) {
+                return undirectedDegree(graph, a) < undirectedDegree(graph, b);
+            });
+        }
+        for (size_t i = 0; i < neighbors.size(); ++i) {
+            order.push_back(neighbors[i]);
+        }
+    }
+}
+
+// Last vertex reached by a BFS from start, preferring low degree; a cheap pseudo-peripheral vertex.
+template <typename W>
+uint32_t farthestVertex(const BasicCsrGraph<W>& graph, uint32_t start, myVector<int>& level) {
+    myVector<uint32_t> queue;
+    queue.push_back(start);
+    level[start] = 0;
+    uint32_t best = start;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const uint32_t v = queue[head];
+        if (level[v] > level[best] ||
+            (level[v] == level[best] && undirectedDegree(graph, v) < undirectedDegree(graph, best))) {
+            best = v;
+        }
+        forEachUndirectedNeighbor(graph, v, [&](size_t u) {
+            if (level[u] == -1) {
+                level[u] = level[v] + 1;
+                queue.push_back(static_cast<uint32_t>(u));
+            }
+        });
+    }
+    for (size_t i = 0; i < queue.size(); ++i) {
+        level[queue[i]] = -1;
+    }
+    return best;
+}
+
+uint64_t hilbertIndex(uint32_t x, uint32_t y, uint32_t side) {
+    uint64_t index = 0;
+    for (uint32_t s = side / 2; s > 0; s /= 2) {
+        const uint32_t rx = (x & s) ? 1 : 0;
+        const uint32_t ry = (y & s) ? 1 : 0;
+        index += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+}
+
+template <typename W>
+myVector<uint32_t> reverseCuthillMcKeeOrder(const BasicCsrGraph<W>& graph) {
+    const size_t n = graph.getNumVertices();
+    myVector<uint32_t> byDegree(n);
+    for (size_t v = 0; v < n; ++v) {
+        byDegree[v] = static_cast<uint32_t>(v);
+    }
+    std::stable_sort(byDegree.data(), byDegree.data() + n, [&](uint32_t a, uint32_t b) {
+        return undirectedDegree(graph, a) < undirectedDegree(graph, b);
+    });
+
+    myVector<bool> placed(n, false);
+    myVector<int> level(n, -1);
+    myVector<uint32_t> order;
+    order.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (!placed[byDegree[i]]) {
+            bfsComponent(graph, farthestVertex(graph, byDegree[i], level), true, placed, order);
+        }
+    }
+
+    std::reverse(order.data(), order.data() + n);
+    return orderToPermutation(order);
+}
+
+template <typename W>
+myVector<uint32_t> bfsOrder(const BasicCsrGraph<W>& graph) {
+    const size_t n = graph.getNumVertices();
+    myVector<bool> placed(n, false);
+    myVector<uint32_t> order;
+    order.reserve(n);
+    for (size_t v = 0; v < n; ++v) {
+        if (!placed[v]) {
+            bfsComponent(graph, static_cast<uint32_t>(v), false, placed, order);
+        }
+    }
+    return orderToPermutation(order);
+}
+
+template <typename W>
+myVector<uint32_t> degreeOrder(const BasicCsrGraph<W>& graph) {
+    const size_t n = graph.getNumVertices();
+    myVector<uint32_t> order(n);
+    for (size_t v = 0; v < n; ++v) {
+        order[v] = static_cast<uint32_t>(v);
+    }
+    std::stable_sort(order.data(), order.data() + n, [&](uint32_t a, uint32_t b) {
+        return undirectedDegree(graph, a) > undirectedDegree(graph, b);
+    });
+    return orderToPermutation(order);
+}
+
+myVector<uint32_t> hilbertOrder(const myVector<double>& x, const myVector<double>& y) {
+    if (x.size() != y.size() || x.empty()) {
+        throw std::invalid_argument("Coordinate arrays must be non-empty and of equal size");
+    }
+
+    const size_t n = x.size();
+    double minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+    for (size_t v = 1; v < n; ++v) {
+        minX = std::min(minX, x[v]);
+        maxX = std::max(maxX, x[v]);
+        minY = std::min(minY, y[v]);
+        maxY = std::max(maxY, y[v]);
+    }
+
+    const uint32_t side = 1u << 16;
+    const double spanX = maxX > minX ? maxX - minX : 1.0;
+    const double spanY = maxY > minY ? maxY - minY : 1.0;
+    myVector<uint64_t> keys(n);
+    for (size_t v = 0; v < n; ++v) {
+        const uint32_t cx = static_cast<uint32_t>((x[v] - minX) / spanX * (side - 1));
+        const uint32_t cy = static_cast<uint32_t>((y[v] - minY) / spanY * (side - 1));
+        keys[v] = hilbertIndex(cx, cy, side);
+    }
+
+    myVector<uint32_t> order(n);
+    for (size_t v = 0; v < n; ++v) {
+        order[v] = static_cast<uint32_t>(v);
+    }
+    std::stable_sort(order.data(), order.data() + n, [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+    return orderToPermutation(order);
+}
+
+template <typename W>
+BasicCsrGraph<W> relabelGraph(const BasicCsrGraph<W>& graph, const myVector<uint32_t>& permutation) {
+    const size_t n = graph.getNumVertices();
+    if (permutation.size() != n) {
+        throw std::invalid_argument("Permutation size does not match the graph");
+    }
+    myVector<bool> used(n, false);
+    for (size_t v = 0; v < n; ++v) {
+        if (permutation[v] >= n || used[permutation[v]]) {
+            throw std::invalid_argument("Not a permutation of the vertex ids");
+        }
+        used[permutation[v]] = true;
+    }
+
+    BasicCsrGraphBuilder<W> builder(n, graph.isDirected());
+    builder.reserve(graph.isDirected() ? graph.getNumArcs() : graph.getNumArcs() / 2);
+    for (size_t u = 0; u < n; ++u) {
+        graph.forEachNeighbor(u, [&](size_t v, W weight) {
+            if (graph.isDirected() || u < v) {
+                builder.addEdge(permutation[u], permutation[v], weight);
+            }
+        });
+    }
+    return builder.build();
+}
+
+template <typename W>
+BasicReorderedGraph<W>::BasicReorderedGraph(const BasicCsrGraph<W>& original, const myVector<uint32_t>& permutation)
+    : graph(relabelGraph(original, permutation)), permutation(permutation), inverse(permutation.size()) {
+    for (size_t v = 0; v < permutation.size(); ++v) {
+        inverse[permutation[v]] = static_cast<uint32_t>(v);
+    }
+}
+
+#define INSTANTIATE_REORDERING(W) \
+    template myVector<uint32_t> reverseCuthillMcKeeOrder<W>(const BasicCsrGraph<W>&); \
+    template myVector<uint32_t> bfsOrder<W>(const BasicCsrGraph<W>&); \
+    template myVector<uint32_t> degreeOrder<W>(const BasicCsrGraph<W>&); \
+    template BasicCsrGraph<W> relabelGraph<W>(const BasicCsrGraph<W>&, const myVector<uint32_t>&); \
+    template class BasicReorderedGraph<W>;
+
+INSTANTIATE_REORDERING(uint16_t)
+INSTANTIATE_REORDERING(uint32_t)
+INSTANTIATE_REORDERING(int)
+INSTANTIATE_REORDERING(int64_t)
+INSTANTIATE_REORDERING(float)
+INSTANTIATE_REORDERING(double)
@@ -0,0 +1,76 @@
+#pragma once
+#include <gtest.h>
+#include "dijkstra.h"
+
+// Arcs leaving a grid vertex, in the order gridGraph asks for their weights.
+enum GridArc { GRID_RIGHT, GRID_DOWN, GRID_LEFT, GRID_UP };
+
+// side x side grid whose arcs leaving u weigh weight(u, arc); left and up arcs are asked for only on directed
+// grids, and a weight of zero leaves the arc out.
+template <typename Weight>
+CsrGraph gridGraph(size_t side, bool directed, Weight weight) {
+    CsrGraphBuilder b(side * side, directed);
+    for (size_t y = 0; y < side; ++y) {
+        for (size_t x = 0; x < side; ++x) {
+            const size_t u = y * side + x;
+            int w;
+            if (x + 1 < side && (w = weight(u, GRID_RIGHT)) > 0) b.addEdge(u, u + 1, w);
+            if (y + 1 < side && (w = weight(u, GRID_DOWN)) > 0) b.addEdge(u, u + side, w);
+            if (directed && x > 0 && (w = weight(u, GRID_LEFT)) > 0) b.addEdge(u, u - 1, w);
+            if (directed && y > 0 && (w = weight(u, GRID_UP)) > 0) b.addEdge(u, u - side, w);
+        }
+    }
+    return b.build();
+}
+
+// The grid most tests share: weights 1..13 scattered over the vertices, with dearer down and left arcs.
+inline CsrGraph gridGraph(size_t side, bool directed) {
+    return gridGraph(side, directed, [](size_t u, GridArc arc) {
+        const int w = static_cast<int>((u * 7919) % 13 + 1);
+        return arc == GRID_RIGHT ? w : arc == GRID_DOWN ? w + 2 : arc == GRID_LEFT ? w + 5 : 0;
+    });
+}
+
+inline int pathLength(const CsrGraph& g, const myVector<int>& path) {
+    int length = 0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        length += g.getEdgeWeight(path[i - 1], path[i]);
+    }
+    return length;
+}
+
+// A path reported for a query at the given distance: empty when the target is unreachable, otherwise running
+// from source to target at exactly that length.
+inline void expectPath(const CsrGraph& g, const myVector<int>& path, int source, int target, int distance) {
+    if (distance == -1) {
+        EXPECT_TRUE(path.empty());
+        return;
+    }
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path[0], source);
+    EXPECT_EQ(path[path.size() - 1], target);
+    EXPECT_EQ(pathLength(g, path), distance);
+}
+
+// Reference distances from source, by the d-ary heap Dijkstra.
+template <typename D = int, typename G>
+myVector<D> dijkstraDistances(const G& g, int source) {
+    typedef BasicDijkstra<typename G::WeightType, D> Reference;
+    Reference reference(g);
+    myVector<int> pred;
+    return reference.shortestPathsWithPredecessors(source, Reference::D_HEAP, pred, 2);
+}
+
+// Hands check(source, target, expected) the reference distance for every sourceStep-th source and
+// targetStep-th target, stopping at the first fatal failure.
+template <typename Check>
+void expectMatchesDijkstra(const CsrGraph& g, int sourceStep, int targetStep, Check check) {
+    const int n = static_cast<int>(g.getNumVertices());
+    for (int source = 0; source < n; source += sourceStep) {
+        myVector<int> dist = dijkstraDistances(g, source);
+        for (int target = 0; target < n; target += targetStep) {
+            check(source, target, dist[target]);
+            if (::testing::Test::HasFatalFailure()) return;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#include <gtest.h>
+#include "alignedMatrix.h"
+#include "graph.h"
+
+TEST(AlignedMatrixTest, RowsAreCacheLineAligned) {
+    AlignedMatrix<int> m(5, 3, -1);
+    EXPECT_EQ(m.rows(), 5);
+    EXPECT_EQ(m.cols(), 3);
+    EXPECT_EQ(m.stride(), 16);
+    for (size_t i = 0; i < m.rows(); ++i) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(m[i]) % 64, 0);
+    }
+}
+
+TEST(AlignedMatrixTest, PaddingHoldsFillValue) {
+    AlignedMatrix<int> m(2, 17, -1);
+    EXPECT_EQ(m.stride(), 32);
+    for (size_t j = 0; j < m.stride(); ++j) {
+        EXPECT_EQ(m[1][j], -1);
+    }
+}
+
+TEST(AlignedMatrixTest, CopyIsDeep) {
+    AlignedMatrix<int> m(2, 2, 0);
+    m[0][1] = 7;
+    AlignedMatrix<int> copy(m);
+    m[0][1] = 3;
+    EXPECT_EQ(copy[0][1], 7);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(copy.data()) % 64, 0);
+}
+
+TEST(AlignedMatrixTest, MoveLeavesSourceEmpty) {
+    AlignedMatrix<int> m(3, 3, 1);
+    AlignedMatrix<int> moved(std::move(m));
+    EXPECT_EQ(moved.rows(), 3);
+    EXPECT_EQ(moved[2][2], 1);
+    EXPECT_EQ(m.data(), nullptr);
+}
+
+TEST(AlignedMatrixTest, GraphUsesSingleContiguousBuffer) {
+    Graph g(20);
+    const AlignedMatrix<int>& matrix = g.getAdjacencyMatrix();
+    EXPECT_EQ(matrix[1] - matrix[0], static_cast<ptrdiff_t>(matrix.stride()));
+    EXPECT_EQ(matrix[19] - matrix[0], static_cast<ptrdiff_t>(19 * matrix.stride()));
+}
@@ -0,0 +1,113 @@
+#include <gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include "allPairs.h"
+#include "mappedFile.h"
+#include "parallel.h"
+#include "reorder.h"
+#include "testGraphs.h"
+
+namespace {
+
+void expectRowsMatchDijkstra(const CsrGraph& g, const myVector<int>& matrix, int firstSource, int lastSource) {
+    const size_t n = g.getNumVertices();
+    for (int source = firstSource; source < lastSource; ++source) {
+        myVector<int> dist = dijkstraDistances(g, source);
+        for (size_t v = 0; v < n; ++v) {
+            ASSERT_EQ(matrix[(source - firstSource) * n + v], dist[v]);
+        }
+    }
+}
+
+}
+
+TEST(ParallelForDynamicTest, VisitsEveryIndexOnce) {
+    const size_t count = 1000;
+    std::unique_ptr<std::atomic<int>[]> storage(new std::atomic<int>[count]);
+    for (size_t i = 0; i < count; ++i) storage[i] = 0;
+    std::atomic<int> badWorker(0);
+    parallelForDynamic(count, 4, [&](size_t i, size_t worker) {
+        if (worker >= 4) ++badWorker;
+        // Uneven costs push the early finishers to steal.
+        volatile size_t spin = 0;
+        for (size_t k = 0; k < (i < 250 ? 20000u : 10u); ++k) spin = spin + k;
+        ++storage[i];
+    });
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(storage[i].load(), 1);
+    }
+    EXPECT_EQ(badWorker.load(), 0);
+    EXPECT_THROW(parallelForDynamic(10, 3, [](size_t i, size_t) {
+        if (i == 7) throw std::runtime_error("failure");
+    }), std::runtime_error);
+}
+
+TEST(AllPairsTest, MatchesDijkstraOnDirectedGrid) {
+    CsrGraph g = gridGraph(9, true);
+    AllPairs apsp(g, 3);
+    EXPECT_EQ(apsp.getNumVertices(), 81u);
+    EXPECT_EQ(apsp.getThreadCount(), 3u);
+    myVector<int> matrix = apsp.compute();
+    ASSERT_EQ(matrix.size(), 81u * 81u);
+    expectRowsMatchDijkstra(g, matrix, 0, 81);
+}
+
+TEST(AllPairsTest, SourceRangeAndUnreachable) {
+    Graph g(5, true);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 2);
+    g.addEdge(3, 0, 1);
+    AllPairs apsp(g, 2);
+    myVector<int> rows(2 * 5);
+    apsp.computeRows(1, 3, rows.data());
+    EXPECT_EQ(rows[0 * 5 + 2], 2);
+    EXPECT_EQ(rows[0 * 5 + 0], -1);
+    EXPECT_EQ(rows[1 * 5 + 2], 0);
+    EXPECT_EQ(rows[1 * 5 + 4], -1);
+    apsp.computeRows(2, 2, rows.data());
+    EXPECT_THROW(apsp.computeRows(3, 6, rows.data()), std::out_of_range);
+    EXPECT_THROW(apsp.computeRows(-1, 2, rows.data()), std::out_of_range);
+    EXPECT_THROW(apsp.computeRows(3, 2, rows.data()), std::out_of_range);
+}
+
+TEST(AllPairsTest, ReorderedGraphUsesOriginalIds) {
+    CsrGraph g = gridGraph(6, false);
+    ReorderedGraph reordered(g, reverseCuthillMcKeeOrder(g));
+    AllPairs apsp(reordered, 2);
+    myVector<int> matrix = apsp.compute();
+    expectRowsMatchDijkstra(g, matrix, 0, 36);
+}
+
+TEST(AllPairsTest, RangesWrittenToMappedFiles) {
+    CsrGraph g = gridGraph(7, true);
+    AllPairs apsp(g, 2);
+    const std::string first = "all_pairs_test_0.bin";
+    const std::string second = "all_pairs_test_1.bin";
+    apsp.computeToFile(first, 0, 20);
+    apsp.computeToFile(second, 20, 49);
+    {
+        MappedFile a(first);
+        MappedFile b(second);
+        ASSERT_EQ(a.size(), 20u * 49 * sizeof(int));
+        ASSERT_EQ(b.size(), 29u * 49 * sizeof(int));
+        EXPECT_THROW(a.writableData(), std::logic_error);
+        myVector<int> matrix(49 * 49);
+        std::memcpy(matrix.data(), a.data(), a.size());
+        std::memcpy(matrix.data() + 20 * 49, b.data(), b.size());
+        expectRowsMatchDijkstra(g, matrix, 0, 49);
+    }
+    std::remove(first.c_str());
+    std::remove(second.c_str());
+}
+
+TEST(AllPairsTest, WideDistances) {
+    BasicGraph<uint16_t> g(3);
+    g.addEdge(0, 1, 60000);
+    g.addEdge(1, 2, 60000);
+    BasicAllPairs<uint16_t, uint32_t> apsp(g, 2);
+    myVector<uint32_t> matrix = apsp.compute();
+    EXPECT_EQ(matrix[0 * 3 + 2], 120000u);
+    EXPECT_EQ(matrix[2 * 3 + 0], 120000u);
+    EXPECT_EQ(matrix[1 * 3 + 1], 0u);
+}
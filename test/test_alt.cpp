@@ -0,0 +1,134 @@
+#include <gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "alt.h"
+#include "testGraphs.h"
+
+namespace {
+
+CsrGraph roadLikeGrid(size_t side, bool directed) {
+    return gridGraph(side, directed, [](size_t u, GridArc arc) {
+        const int w = static_cast<int>((u * 7919) % 17 + 3);
+        return arc == GRID_RIGHT ? w : arc == GRID_DOWN ? w + 1 : arc == GRID_LEFT ? w + 4 : w + 2;
+    });
+}
+
+void expectExact(const CsrGraph& g, const Landmarks& landmarks) {
+    Alt engine(g, landmarks, 2);
+    expectMatchesDijkstra(g, 41, 17, [&](int source, int target, int expected) {
+        Alt::PathResult result = engine.shortestPath(source, target, Alt::D_HEAP, 4);
+        EXPECT_EQ(result.distance, expected);
+        EXPECT_LE(landmarks.lowerBound(source, target, engine.getActiveLandmarks().data(),
+            engine.getActiveLandmarks().size()), expected);
+    });
+}
+
+}
+
+TEST(AltTest, FarthestLandmarksGiveExactDistances) {
+    CsrGraph g = roadLikeGrid(16, false);
+    myVector<uint32_t> chosen = Landmarks::selectLandmarks(g, 4, Landmarks::FARTHEST);
+    ASSERT_EQ(chosen.size(), 4);
+    for (size_t i = 0; i < chosen.size(); ++i) {
+        for (size_t j = i + 1; j < chosen.size(); ++j) {
+            EXPECT_NE(chosen[i], chosen[j]);
+        }
+    }
+    expectExact(g, Landmarks(g, chosen, 2));
+}
+
+TEST(AltTest, AvoidLandmarksOnDirectedGraph) {
+    CsrGraph g = roadLikeGrid(14, true);
+    Landmarks landmarks(g, Landmarks::selectLandmarks(g, 5, Landmarks::AVOID, nullptr, 7), 3);
+    EXPECT_TRUE(landmarks.isDirected());
+    EXPECT_EQ(landmarks.getNumLandmarks(), 5);
+    expectExact(g, landmarks);
+}
+
+TEST(AltTest, PlanarLandmarksNeedCoordinates) {
+    const size_t side = 12;
+    CsrGraph g = roadLikeGrid(side, false);
+    EXPECT_THROW(Landmarks::selectLandmarks(g, 4, Landmarks::PLANAR), std::invalid_argument);
+
+    VertexCoordinates coordinates(side * side);
+    for (size_t v = 0; v < side * side; ++v) {
+        coordinates.set(v, static_cast<double>(v % side), static_cast<double>(v / side));
+    }
+    myVector<uint32_t> chosen = Landmarks::selectLandmarks(g, 4, Landmarks::PLANAR, &coordinates);
+    ASSERT_EQ(chosen.size(), 4);
+    expectExact(g, Landmarks(g, chosen));
+}
+
+TEST(AltTest, LandmarksCutTheSearchSpace) {
+    CsrGraph g = roadLikeGrid(40, false);
+    Landmarks landmarks(g, Landmarks::selectLandmarks(g, 8, Landmarks::FARTHEST));
+    Alt engine(g, landmarks, 4);
+    BasicAStar<int, int, ZeroHeuristic> blind(g, ZeroHeuristic());
+    const int source = 20 * 40 + 1;
+    const int target = 20 * 40 + 38;
+    EXPECT_EQ(engine.shortestPath(source, target, Alt::D_HEAP, 2).distance,
+        blind.shortestPath(source, target, BasicAStar<int, int, ZeroHeuristic>::D_HEAP, 2).distance);
+    EXPECT_LT(engine.getLastSettledCount() * 2, blind.getLastSettledCount());
+}
+
+TEST(AltTest, UnreachableVerticesAndComponents) {
+    CsrGraphBuilder b(6);
+    b.addEdge(0, 1, 2);
+    b.addEdge(1, 2, 2);
+    b.addEdge(3, 4, 1);
+    CsrGraph g = b.build();
+    myVector<uint32_t> chosen = Landmarks::selectLandmarks(g, 3, Landmarks::FARTHEST);
+    Landmarks landmarks(g, chosen);
+    Alt engine(g, landmarks);
+    EXPECT_EQ(engine.shortestPath(0, 2, Alt::BINOMIAL_HEAP, 2).distance, 4);
+    EXPECT_EQ(engine.shortestPath(0, 4, Alt::D_HEAP, 2).distance, -1);
+    EXPECT_EQ(landmarks.distanceFrom(0, landmarks.getLandmarks()[0]), 0);
+}
+
+TEST(AltTest, TablesRoundTripThroughFile) {
+    CsrGraph g = roadLikeGrid(10, true);
+    Landmarks landmarks(g, Landmarks::selectLandmarks(g, 3, Landmarks::FARTHEST));
+    const std::string path = "alt_test.lmk";
+    landmarks.save(path);
+    Landmarks loaded = Landmarks::load(path);
+    EXPECT_THROW((BasicLandmarks<int, int64_t>::load(path)), std::runtime_error);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(loaded.getNumLandmarks(), 3);
+    EXPECT_TRUE(loaded.isDirected());
+    for (size_t l = 0; l < 3; ++l) {
+        EXPECT_EQ(loaded.getLandmarks()[l], landmarks.getLandmarks()[l]);
+        for (size_t v = 0; v < 100; ++v) {
+            EXPECT_EQ(loaded.distanceFrom(l, v), landmarks.distanceFrom(l, v));
+            EXPECT_EQ(loaded.distanceTo(l, v), landmarks.distanceTo(l, v));
+        }
+    }
+    expectExact(g, loaded);
+}
+
+TEST(AltTest, RejectsCountsThatWrapTheFileSize) {
+    CsrGraph g = roadLikeGrid(5, false);
+    Landmarks landmarks(g, Landmarks::selectLandmarks(g, 4, Landmarks::FARTHEST));
+    const std::string path = "alt_test_counts.lmk";
+
+    // The vertex and landmark counts follow the magic and four 32-bit fields. Each forged count keeps the
+    // expected file size unchanged modulo 2^64, so only the bounds on the counts catch it.
+    const uint64_t forged[][2] = { { 24, 25 + (uint64_t(1) << 60) }, { 32, 4 + (uint64_t(1) << 62) } };
+    for (const auto& field : forged) {
+        landmarks.save(path);
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(field[0]));
+        file.write(reinterpret_cast<const char*>(&field[1]), sizeof(field[1]));
+        file.close();
+        EXPECT_THROW(Landmarks::load(path), std::runtime_error);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(AltTest, RejectsMismatchedGraph) {
+    CsrGraph g = roadLikeGrid(5, false);
+    CsrGraph other = roadLikeGrid(6, false);
+    Landmarks landmarks(g, Landmarks::selectLandmarks(g, 2, Landmarks::FARTHEST));
+    EXPECT_THROW(Alt(other, landmarks), std::invalid_argument);
+    EXPECT_THROW(Landmarks::selectLandmarks(g, 26, Landmarks::FARTHEST), std::invalid_argument);
+}
@@ -0,0 +1,100 @@
+#include <gtest.h>
+#include "astar.h"
+
+namespace {
+
+// Grid with unit spacing where every edge weight is at least its Euclidean length times 10.
+struct Grid {
+    CsrGraph graph;
+    VertexCoordinates coordinates;
+
+    explicit Grid(size_t side) : graph(build(side)), coordinates(side * side) {
+        for (size_t v = 0; v < side * side; ++v) {
+            coordinates.set(v, static_cast<double>(v % side), static_cast<double>(v / side));
+        }
+    }
+
+    static CsrGraph build(size_t side) {
+        CsrGraphBuilder b(side * side);
+        for (size_t y = 0; y < side; ++y) {
+            for (size_t x = 0; x < side; ++x) {
+                const size_t u = y * side + x;
+                if (x + 1 < side) b.addEdge(u, u + 1, static_cast<int>(10 + (u * 31) % 7));
+                if (y + 1 < side) b.addEdge(u, u + side, static_cast<int>(10 + (u * 17) % 5));
+            }
+        }
+        return b.build();
+    }
+};
+
+}
+
+TEST(AStarTest, EuclideanMatchesDijkstra) {
+    Grid grid(20);
+    Dijkstra reference(grid.graph);
+    AStar engine(grid.graph, EuclideanHeuristic(grid.coordinates, 10.0));
+    myVector<int> pred;
+    myVector<int> dist = reference.shortestPathsWithPredecessors(45, Dijkstra::D_HEAP, pred, 2);
+    for (int target = 0; target < 400; target += 13) {
+        AStar::PathResult result = engine.shortestPath(45, target, AStar::D_HEAP, 4);
+        EXPECT_EQ(result.distance, dist[target]);
+        ASSERT_FALSE(result.path.empty());
+        EXPECT_EQ(result.path[result.path.size() - 1], target);
+    }
+}
+
+TEST(AStarTest, HeuristicNarrowsTheSearch) {
+    Grid grid(30);
+    BasicAStar<int, int, ZeroHeuristic> blind(grid.graph, ZeroHeuristic());
+    BasicAStar<int, int, ManhattanHeuristic> guided(grid.graph, ManhattanHeuristic(grid.coordinates, 10.0));
+    const int source = 15 * 30 + 2;
+    const int target = 15 * 30 + 27;
+    EXPECT_EQ(guided.shortestPath(source, target, BasicAStar<int, int, ManhattanHeuristic>::D_HEAP, 2).distance,
+        blind.shortestPath(source, target, BasicAStar<int, int, ZeroHeuristic>::D_HEAP, 2).distance);
+    EXPECT_LT(guided.getLastSettledCount() * 2, blind.getLastSettledCount());
+}
+
+TEST(AStarTest, InconsistentHeuristicStillExact) {
+    Graph g(4, true);
+    g.addEdge(0, 1, 1);
+    g.addEdge(0, 2, 4);
+    g.addEdge(1, 2, 1);
+    g.addEdge(2, 3, 4);
+    auto bound = [](size_t v, size_t) { return v == 1 ? 6.0 : 0.0; };
+    BasicAStar<int, int, decltype(bound)> engine(g, bound);
+    auto result = engine.shortestPath(0, 3, BasicAStar<int, int, decltype(bound)>::BINOMIAL_HEAP, 2);
+    EXPECT_EQ(result.distance, 6);
+    ASSERT_EQ(result.path.size(), 4);
+    EXPECT_EQ(result.path[1], 1);
+}
+
+TEST(AStarTest, HaversineDistance) {
+    VertexCoordinates coordinates(2);
+    coordinates.set(0, 0.0, 0.0);
+    coordinates.set(1, 1.0, 0.0);
+    HaversineHeuristic h(coordinates);
+    EXPECT_NEAR(h(0, 1), 111194.9, 0.5);
+    EXPECT_DOUBLE_EQ(h(1, 1), 0.0);
+}
+
+TEST(AStarTest, ReorderedGraphUsesOriginalIds) {
+    Grid grid(10);
+    ReorderedGraph reordered(grid.graph, degreeOrder(grid.graph));
+    BasicAStar<int, double, EuclideanHeuristic> plain(grid.graph, EuclideanHeuristic(grid.coordinates, 10.0));
+    BasicAStar<int, double, EuclideanHeuristic> local(reordered, EuclideanHeuristic(grid.coordinates, 10.0));
+    auto expected = plain.shortestPath(3, 96, BasicAStar<int, double, EuclideanHeuristic>::D_HEAP, 2);
+    auto actual = local.shortestPath(3, 96, BasicAStar<int, double, EuclideanHeuristic>::D_HEAP, 2);
+    EXPECT_DOUBLE_EQ(actual.distance, expected.distance);
+    ASSERT_EQ(actual.path.size(), expected.path.size());
+    EXPECT_EQ(actual.path[0], 3);
+    EXPECT_EQ(actual.path[actual.path.size() - 1], 96);
+}
+
+TEST(AStarTest, UnreachableTarget) {
+    Graph g(3);
+    g.addEdge(0, 1, 2);
+    VertexCoordinates coordinates(3);
+    AStar engine(g, EuclideanHeuristic(coordinates));
+    EXPECT_EQ(engine.shortestPath(0, 2, AStar::D_HEAP, 2).distance, -1);
+    EXPECT_THROW(engine.shortestPath(0, 3, AStar::D_HEAP, 2), std::out_of_range);
+}
@@ -0,0 +1,56 @@
+#include <gtest.h>
+#include "bidirectionalDijkstra.h"
+#include "testGraphs.h"
+
+TEST(BidirectionalDijkstraTest, MatchesDijkstraOnUndirectedGrid) {
+    CsrGraph g = gridGraph(15, false);
+    BidirectionalDijkstra engine(g);
+    expectMatchesDijkstra(g, 37, 11, [&](int source, int target, int expected) {
+        BidirectionalDijkstra::PathResult result = engine.shortestPath(source, target, BidirectionalDijkstra::D_HEAP, 4);
+        EXPECT_EQ(result.distance, expected);
+        ASSERT_NE(expected, -1);
+        expectPath(g, result.path, source, target, expected);
+    });
+}
+
+TEST(BidirectionalDijkstraTest, MatchesDijkstraOnDirectedGrid) {
+    CsrGraph g = gridGraph(12, true);
+    BidirectionalDijkstra engine(g);
+    expectMatchesDijkstra(g, 29, 7, [&](int source, int target, int expected) {
+        BidirectionalDijkstra::PathResult result = engine.shortestPath(source, target, BidirectionalDijkstra::BINOMIAL_HEAP, 2);
+        EXPECT_EQ(result.distance, expected);
+        expectPath(g, result.path, source, target, expected);
+    });
+}
+
+TEST(BidirectionalDijkstraTest, SettlesFewerVerticesOnNearbyTargets) {
+    CsrGraph g = gridGraph(40, false);
+    BidirectionalDijkstra engine(g);
+    engine.shortestPath(20 * 40 + 18, 20 * 40 + 22, BidirectionalDijkstra::D_HEAP, 2);
+    EXPECT_GT(engine.getLastSettledCount(), 0);
+    EXPECT_LT(engine.getLastSettledCount(), 1600 / 4);
+}
+
+TEST(BidirectionalDijkstraTest, DenseGraphAndTrivialQueries) {
+    Graph g(4, true);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 2);
+    g.addEdge(0, 2, 5);
+    BidirectionalDijkstra engine(g);
+    BidirectionalDijkstra::PathResult result = engine.shortestPath(0, 2, BidirectionalDijkstra::D_HEAP, 2);
+    EXPECT_EQ(result.distance, 4);
+    ASSERT_EQ(result.path.size(), 3);
+    EXPECT_EQ(result.path[1], 1);
+
+    EXPECT_EQ(engine.shortestPath(2, 0, BidirectionalDijkstra::D_HEAP, 2).distance, -1);
+    EXPECT_EQ(engine.shortestPath(3, 3, BidirectionalDijkstra::D_HEAP, 2).distance, 0);
+    EXPECT_THROW(engine.shortestPath(0, 4, BidirectionalDijkstra::D_HEAP, 2), std::out_of_range);
+}
+
+TEST(BidirectionalDijkstraTest, WideDistances) {
+    BasicGraph<uint16_t> g(3);
+    g.addEdge(0, 1, 60000);
+    g.addEdge(1, 2, 60000);
+    BasicBidirectionalDijkstra<uint16_t, uint32_t> engine(g);
+    EXPECT_EQ(engine.shortestPath(0, 2, BasicBidirectionalDijkstra<uint16_t, uint32_t>::D_HEAP, 2).distance, 120000u);
+}
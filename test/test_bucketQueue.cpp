@@ -0,0 +1,70 @@
+#include <gtest.h>
+#include "bucketQueue.h"
+#include "dijkstra.h"
+
+TEST(BucketQueueTest, PopsInKeyOrder) {
+    BucketQueue<HeapNode> queue(10);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.getNumBuckets(), 11u);
+    queue.push({ 0, 4 });
+    queue.push({ 1, 9 });
+    queue.push({ 2, 4 });
+    queue.push({ 3, 6 });
+    EXPECT_EQ(queue.size(), 4u);
+
+    int keys[4];
+    for (int i = 0; i < 4; ++i) {
+        keys[i] = queue.top().distance;
+        queue.pop();
+    }
+    EXPECT_EQ(keys[0], 4);
+    EXPECT_EQ(keys[1], 4);
+    EXPECT_EQ(keys[2], 6);
+    EXPECT_EQ(keys[3], 9);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(BucketQueueTest, WrapsAroundTheBuckets) {
+    BucketQueue<HeapNode> queue(3);
+    queue.push({ 0, 0 });
+    queue.push({ 1, 1 });
+    queue.push({ 2, 2 });
+    for (int key = 0; key < 100; ++key) {
+        EXPECT_EQ(queue.top().distance, key);
+        queue.pop();
+        queue.push({ key + 3, key + 3 });
+    }
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(queue.top().vertex, 100);
+}
+
+TEST(BucketQueueTest, PushAfterEmptyingTheCurrentBucket) {
+    BucketQueue<HeapNode> queue(5);
+    queue.push({ 0, 2 });
+    queue.push({ 1, 7 });
+    queue.pop();
+    queue.push({ 2, 3 });
+    EXPECT_EQ(queue.top().vertex, 2);
+    queue.pop();
+    EXPECT_EQ(queue.top().vertex, 1);
+    queue.pop();
+    EXPECT_TRUE(queue.empty());
+    queue.push({ 3, 12 });
+    queue.push({ 4, 8 });
+    EXPECT_EQ(queue.top().vertex, 4);
+}
+
+TEST(BucketQueueTest, RejectsKeysOutsideTheWindow) {
+    BucketQueue<HeapNode> queue(4);
+    queue.push({ 0, 10 });
+    EXPECT_THROW(queue.push({ 1, 9 }), std::out_of_range);
+    EXPECT_THROW(queue.push({ 1, 15 }), std::out_of_range);
+    queue.push({ 1, 14 });
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_THROW(queue.top(), std::out_of_range);
+    EXPECT_THROW(queue.pop(), std::out_of_range);
+    queue.push({ 2, 1 });
+    EXPECT_EQ(queue.top().distance, 1);
+    EXPECT_THROW(BucketQueue<HeapNode>(uint64_t(1) << 30), std::invalid_argument);
+}
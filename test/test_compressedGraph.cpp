@@ -0,0 +1,109 @@
+#include <gtest.h>
+#include "compressedGraph.h"
+#include "dijkstra.h"
+
+namespace {
+
+template <typename W>
+void expectSameRows(const BasicCsrGraph<W>& csr, const BasicCompressedGraph<W>& compressed) {
+    for (size_t u = 0; u < csr.getNumVertices(); ++u) {
+        myVector<size_t> targets;
+        myVector<W> weights;
+        compressed.forEachNeighbor(u, [&](size_t v, W w) {
+            targets.push_back(v);
+            weights.push_back(w);
+        });
+        ASSERT_EQ(targets.size(), csr.getDegree(u));
+        EXPECT_EQ(compressed.getDegree(u), csr.getDegree(u));
+        const uint64_t begin = csr.getOffsets()[u];
+        for (size_t i = 0; i < targets.size(); ++i) {
+            EXPECT_EQ(targets[i], csr.getTargets()[begin + i]);
+            EXPECT_EQ(weights[i], csr.getWeights()[begin + i]);
+        }
+    }
+}
+
+}
+
+TEST(CompressedGraphTest, RoundTripsRows) {
+    CsrGraphBuilder b(200);
+    for (size_t u = 0; u < 200; ++u) {
+        b.addEdge(u, (u * 37 + 11) % 200 == u ? (u + 1) % 200 : (u * 37 + 11) % 200, static_cast<int>(u % 9 + 1));
+        b.addEdge(u, (u + 150) % 200, 1000 + static_cast<int>(u));
+    }
+    CsrGraph csr = b.build();
+    CompressedGraph compressed(csr);
+    EXPECT_EQ(compressed.getNumArcs(), csr.getNumArcs());
+    EXPECT_EQ(compressed.getWeightWidth(), 2);
+    expectSameRows(csr, compressed);
+}
+
+TEST(CompressedGraphTest, ParallelCompressionMatches) {
+    BasicCsrGraphBuilder<uint32_t> b(1000, true);
+    for (size_t u = 0; u + 1 < 1000; ++u) {
+        b.addEdge(u, u + 1, 70000u + static_cast<uint32_t>(u));
+        b.addEdge(u + 1, u / 2, 3);
+    }
+    BasicCsrGraph<uint32_t> csr = b.build();
+    BasicCompressedGraph<uint32_t> single(csr);
+    BasicCompressedGraph<uint32_t> parallel(csr, 4);
+    EXPECT_EQ(single.getWeightWidth(), 4);
+    EXPECT_EQ(single.getMemoryBytes(), parallel.getMemoryBytes());
+    expectSameRows(csr, parallel);
+
+    myVector<size_t> sources;
+    parallel.forEachInNeighbor(1, [&](size_t u, uint32_t) { sources.push_back(u); });
+    ASSERT_EQ(sources.size(), 3);
+    EXPECT_EQ(sources[0], 0);
+    EXPECT_EQ(sources[1], 3);
+    EXPECT_EQ(sources[2], 4);
+}
+
+TEST(CompressedGraphTest, FloatingWeightsKeepWidth) {
+    BasicCsrGraphBuilder<double> b(3);
+    b.addEdge(0, 1, 0.25);
+    b.addEdge(1, 2, 1.5);
+    BasicCsrGraph<double> csr = b.build();
+    BasicCompressedGraph<double> compressed(csr);
+    EXPECT_EQ(compressed.getWeightWidth(), sizeof(double));
+    EXPECT_DOUBLE_EQ(compressed.getEdgeWeight(2, 1), 1.5);
+    EXPECT_EQ(compressed.getEdgeWeight(0, 2), -1.0);
+}
+
+TEST(CompressedGraphTest, SmallerThanCsrOnLocalGraph) {
+    const size_t n = 10000;
+    CsrGraphBuilder b(n);
+    for (size_t v = 1; v < n; ++v) {
+        b.addEdge(v - 1, v, static_cast<int>(v % 100 + 1));
+    }
+    CsrGraph csr = b.build();
+    CompressedGraph compressed(csr);
+    const size_t csrBytes = (n + 1) * sizeof(uint64_t) + csr.getNumArcs() * (sizeof(uint32_t) + sizeof(int));
+    EXPECT_EQ(compressed.getWeightWidth(), 1);
+    EXPECT_LT(compressed.getMemoryBytes() * 2, csrBytes);
+}
+
+TEST(CompressedGraphTest, DijkstraMatchesCsr) {
+    CsrGraphBuilder b(6, true);
+    b.addEdge(0, 1, 7);
+    b.addEdge(0, 2, 9);
+    b.addEdge(0, 5, 14);
+    b.addEdge(1, 2, 10);
+    b.addEdge(2, 3, 11);
+    b.addEdge(2, 5, 2);
+    b.addEdge(5, 4, 9);
+    b.addEdge(3, 4, 6);
+    CsrGraph csr = b.build();
+    CompressedGraph compressed(csr);
+
+    myVector<int> expectedPred;
+    myVector<int> pred;
+    Dijkstra reference(csr);
+    Dijkstra engine(compressed);
+    myVector<int> expected = reference.shortestPathsToTarget(4, Dijkstra::D_HEAP, expectedPred, 2);
+    myVector<int> dist = engine.shortestPathsToTarget(4, Dijkstra::D_HEAP, pred, 2);
+    for (size_t v = 0; v < 6; ++v) {
+        EXPECT_EQ(dist[v], expected[v]);
+        EXPECT_EQ(pred[v], expectedPred[v]);
+    }
+}
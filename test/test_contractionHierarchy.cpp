@@ -0,0 +1,88 @@
+#include <gtest.h>
+#include "contractionHierarchy.h"
+#include "testGraphs.h"
+
+namespace {
+
+void expectHierarchyExact(const CsrGraph& g, size_t threads) {
+    ContractionHierarchy ch(g, threads);
+    ChQuery query(ch);
+    expectMatchesDijkstra(g, 13, 5, [&](int source, int target, int expected) {
+        ChQuery::PathResult result = query.shortestPath(source, target);
+        ASSERT_EQ(result.distance, expected);
+        EXPECT_EQ(query.distance(source, target), expected);
+        expectPath(g, result.path, source, target, expected);
+    });
+}
+
+}
+
+TEST(ContractionHierarchyTest, MatchesDijkstraOnUndirectedGrid) {
+    expectHierarchyExact(gridGraph(14, false), 1);
+}
+
+TEST(ContractionHierarchyTest, MatchesDijkstraOnDirectedGridWithThreads) {
+    expectHierarchyExact(gridGraph(12, true), 3);
+}
+
+// Equal weights make every square a pair of equally long paths, the case where contracting both
+// middle vertices in one round could drop the connection if each served as the other's witness.
+TEST(ContractionHierarchyTest, MatchesDijkstraWithUniformWeights) {
+    CsrGraphBuilder b(100, false);
+    for (size_t u = 0; u < 100; ++u) {
+        if (u % 10 + 1 < 10) b.addEdge(u, u + 1, 1);
+        if (u + 10 < 100) b.addEdge(u, u + 10, 1);
+    }
+    expectHierarchyExact(b.build(), 2);
+}
+
+TEST(ContractionHierarchyTest, ArcsPointUpTheOrder) {
+    CsrGraph g = gridGraph(10, true);
+    ContractionHierarchy ch(g, 1);
+    for (size_t v = 0; v < ch.getNumVertices(); ++v) {
+        ch.forEachUpArc(v, [&](size_t w, int) { EXPECT_GT(ch.getRank(w), ch.getRank(v)); });
+        ch.forEachDownArc(v, [&](size_t u, int) { EXPECT_GT(ch.getRank(u), ch.getRank(v)); });
+    }
+    // Each original arc sits once at its tail or its head, as does each shortcut.
+    EXPECT_EQ(ch.getNumUpArcs() + ch.getNumDownArcs(), g.getNumArcs() + ch.getNumShortcuts());
+}
+
+TEST(ContractionHierarchyTest, SettlesFewVertices) {
+    CsrGraph g = gridGraph(30, false);
+    ContractionHierarchy ch(g, 1);
+    ChQuery query(ch);
+    query.shortestPath(0, 899);
+    EXPECT_GT(query.getLastSettledCount(), 0);
+    EXPECT_LT(query.getLastSettledCount(), 900 / 2);
+}
+
+TEST(ContractionHierarchyTest, DenseGraphAndTrivialQueries) {
+    Graph g(4, true);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 2);
+    g.addEdge(0, 2, 5);
+    ContractionHierarchy ch(g);
+    ChQuery query(ch);
+    ChQuery::PathResult result = query.shortestPath(0, 2);
+    EXPECT_EQ(result.distance, 4);
+    ASSERT_EQ(result.path.size(), 3);
+    EXPECT_EQ(result.path[1], 1);
+
+    EXPECT_EQ(query.shortestPath(2, 0).distance, -1);
+    EXPECT_TRUE(query.shortestPath(2, 0).path.empty());
+    result = query.shortestPath(3, 3);
+    EXPECT_EQ(result.distance, 0);
+    EXPECT_EQ(result.path.size(), 1);
+    EXPECT_THROW(query.shortestPath(0, 4), std::out_of_range);
+    EXPECT_THROW(query.distance(-1, 0), std::out_of_range);
+}
+
+TEST(ContractionHierarchyTest, WideDistances) {
+    BasicGraph<uint16_t> g(3);
+    g.addEdge(0, 1, 60000);
+    g.addEdge(1, 2, 60000);
+    BasicContractionHierarchy<uint16_t, uint32_t> ch(g);
+    BasicChQuery<uint16_t, uint32_t> query(ch);
+    EXPECT_EQ(query.distance(0, 2), 120000u);
+    EXPECT_EQ(query.distance(2, 0), 120000u);
+}
@@ -0,0 +1,129 @@
+#include <gtest.h>
+#include "csrGraph.h"
+
+TEST(CsrGraphTest, BuilderRejectsZeroVertices) {
+    EXPECT_THROW(CsrGraphBuilder b(0), std::invalid_argument);
+}
+
+TEST(CsrGraphTest, BuilderValidatesEdges) {
+    CsrGraphBuilder b(3);
+    EXPECT_THROW(b.addEdge(0, 1, 0), std::invalid_argument);
+    EXPECT_THROW(b.addEdge(0, 3, 1), std::out_of_range);
+    EXPECT_EQ(b.getNumEdges(), 0);
+}
+
+TEST(CsrGraphTest, BuildStoresBothDirections) {
+    CsrGraphBuilder b(3);
+    b.addEdge(0, 1, 5);
+    b.addEdge(1, 2, 7);
+    CsrGraph g = b.build();
+    EXPECT_EQ(g.getNumVertices(), 3);
+    EXPECT_EQ(g.getNumArcs(), 4);
+    EXPECT_EQ(g.getEdgeWeight(0, 1), 5);
+    EXPECT_EQ(g.getEdgeWeight(1, 0), 5);
+    EXPECT_EQ(g.getEdgeWeight(2, 1), 7);
+    EXPECT_EQ(g.getEdgeWeight(0, 2), -1);
+    EXPECT_EQ(g.getEdgeWeight(2, 2), 0);
+}
+
+TEST(CsrGraphTest, NeighborsAreSorted) {
+    CsrGraphBuilder b(5);
+    b.addEdge(0, 4, 1);
+    b.addEdge(0, 2, 1);
+    b.addEdge(0, 3, 1);
+    b.addEdge(0, 1, 1);
+    CsrGraph g = b.build();
+    myVector<size_t> neighbors;
+    g.forEachNeighbor(0, [&](size_t v, int) { neighbors.push_back(v); });
+    ASSERT_EQ(neighbors.size(), 4);
+    for (size_t i = 0; i < neighbors.size(); ++i) {
+        EXPECT_EQ(neighbors[i], i + 1);
+    }
+}
+
+TEST(CsrGraphTest, ParallelEdgesKeepLightest) {
+    CsrGraphBuilder b(2);
+    b.addEdge(0, 1, 9);
+    b.addEdge(1, 0, 3);
+    b.addEdge(0, 1, 5);
+    CsrGraph g = b.build();
+    EXPECT_EQ(g.getDegree(0), 1);
+    EXPECT_EQ(g.getEdgeWeight(0, 1), 3);
+    EXPECT_EQ(g.getEdgeWeight(1, 0), 3);
+}
+
+TEST(CsrGraphTest, SelfLoopsAreRejected) {
+    CsrGraphBuilder b(2);
+    EXPECT_THROW(b.addEdge(1, 1, 4), std::invalid_argument);
+    b.addEdge(0, 1, 4);
+    CsrGraph g = b.build();
+    EXPECT_EQ(g.getNumArcs(), 2);
+    EXPECT_EQ(g.getEdgeWeight(1, 1), 0);
+}
+
+TEST(CsrGraphTest, ConvertsFromDenseGraph) {
+    Graph dense(4);
+    dense.addEdge(0, 1, 2);
+    dense.addEdge(2, 3, 6);
+    CsrGraph g(dense);
+    EXPECT_EQ(g.getNumArcs(), 4);
+    for (size_t u = 0; u < 4; ++u) {
+        for (size_t v = 0; v < 4; ++v) {
+            EXPECT_EQ(g.getEdgeWeight(u, v), dense.getEdgeWeight(u, v));
+        }
+    }
+}
+
+TEST(CsrGraphTest, Connectivity) {
+    CsrGraphBuilder b(3);
+    b.addEdge(0, 1, 1);
+    EXPECT_FALSE(b.build().isConnected());
+
+    CsrGraphBuilder c(3);
+    c.addEdge(0, 1, 1);
+    c.addEdge(2, 1, 1);
+    EXPECT_TRUE(c.build().isConnected());
+}
+
+TEST(CsrGraphTest, GetEdgeWeightInvalidVertex) {
+    CsrGraphBuilder b(3);
+    CsrGraph g = b.build();
+    EXPECT_THROW(g.getEdgeWeight(0, 3), std::out_of_range);
+    EXPECT_THROW(g.getEdgeWeight(5, 5), std::out_of_range);
+}
+
+TEST(CsrGraphTest, DirectedKeepsForwardAndReverse) {
+    CsrGraphBuilder b(3, true);
+    b.addEdge(0, 1, 2);
+    b.addEdge(2, 1, 3);
+    CsrGraph g = b.build();
+    EXPECT_TRUE(g.isDirected());
+    EXPECT_EQ(g.getNumArcs(), 2);
+    EXPECT_EQ(g.getEdgeWeight(0, 1), 2);
+    EXPECT_EQ(g.getEdgeWeight(1, 0), -1);
+    EXPECT_EQ(g.getDegree(1), 0);
+    EXPECT_EQ(g.getInDegree(1), 2);
+
+    int total = 0;
+    g.forEachInNeighbor(1, [&](size_t u, int weight) { total += static_cast<int>(u) * 10 + weight; });
+    EXPECT_EQ(total, 2 + 23);
+}
+
+TEST(CsrGraphTest, UndirectedStoresNoReverseCopy) {
+    CsrGraphBuilder b(3);
+    b.addEdge(0, 1, 2);
+    CsrGraph g = b.build();
+    EXPECT_EQ(g.getNumArcs(), 2);
+    EXPECT_EQ(g.getInDegree(1), g.getDegree(1));
+}
+
+TEST(CsrGraphTest, ConvertsFromDirectedDenseGraph) {
+    Graph dense(3, true);
+    dense.addEdge(0, 1, 1);
+    dense.addEdge(1, 2, 1);
+    CsrGraph g(dense);
+    EXPECT_TRUE(g.isDirected());
+    EXPECT_EQ(g.getInDegree(2), 1);
+    EXPECT_EQ(g.getInDegree(0), 0);
+    EXPECT_EQ(g.getEdgeWeight(2, 1), -1);
+}
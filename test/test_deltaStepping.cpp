@@ -0,0 +1,129 @@
+#include <gtest.h>
+#include "deltaStepping.h"
+#include "testGraphs.h"
+
+namespace {
+
+// Weights spread over 1..102 so that the deltas below split them into different numbers of buckets.
+CsrGraph spreadGrid(size_t side, bool directed) {
+    return gridGraph(side, directed, [](size_t u, GridArc arc) {
+        const int w = static_cast<int>((u * 7919) % 97 + 1);
+        return arc == GRID_RIGHT ? w : arc == GRID_DOWN ? w / 3 + 1 : arc == GRID_LEFT ? w + 5 : 0;
+    });
+}
+
+void expectShortestPathTree(const CsrGraph& g, int start, const myVector<int>& dist, const myVector<int>& pred) {
+    myVector<int> expected = dijkstraDistances(g, start);
+    ASSERT_EQ(dist.size(), expected.size());
+    ASSERT_EQ(pred.size(), expected.size());
+    for (size_t v = 0; v < dist.size(); ++v) {
+        ASSERT_EQ(dist[v], expected[v]);
+        if (static_cast<int>(v) == start || dist[v] == -1) {
+            EXPECT_EQ(pred[v], -1);
+        }
+        else {
+            ASSERT_NE(pred[v], -1);
+            EXPECT_EQ(dist[pred[v]] + g.getEdgeWeight(pred[v], v), dist[v]);
+        }
+    }
+}
+
+}
+
+TEST(DeltaSteppingTest, MatchesDijkstraWithDefaultDelta) {
+    CsrGraph g = spreadGrid(30, false);
+    DeltaStepping engine(g, 3);
+    EXPECT_EQ(engine.getThreadCount(), 3);
+    EXPECT_GT(engine.getDefaultDelta(), 0);
+    myVector<int> pred;
+    myVector<int> dist = engine.shortestPathsWithPredecessors(17, pred);
+    expectShortestPathTree(g, 17, dist, pred);
+}
+
+TEST(DeltaSteppingTest, MatchesDijkstraForAnyDelta) {
+    CsrGraph g = spreadGrid(20, true);
+    const int deltas[] = { 1, 7, 50, 1000 };
+    for (size_t threads = 1; threads <= 4; threads += 3) {
+        DeltaStepping engine(g, threads);
+        for (int delta : deltas) {
+            myVector<int> pred;
+            myVector<int> dist = engine.shortestPathsWithPredecessors(5, pred, delta);
+            expectShortestPathTree(g, 5, dist, pred);
+        }
+    }
+}
+
+TEST(DeltaSteppingTest, UnreachableVerticesAndInvalidArguments) {
+    Graph g(5, true);
+    g.addEdge(0, 1, 4);
+    g.addEdge(1, 2, 1);
+    g.addEdge(0, 2, 9);
+    DeltaStepping engine(g, 2);
+    myVector<int> pred;
+    myVector<int> dist = engine.shortestPathsWithPredecessors(0, pred, 2);
+    EXPECT_EQ(dist[2], 5);
+    EXPECT_EQ(pred[2], 1);
+    EXPECT_EQ(dist[3], -1);
+    EXPECT_EQ(pred[3], -1);
+    EXPECT_THROW(engine.shortestPathsWithPredecessors(5, pred), std::out_of_range);
+    EXPECT_THROW(engine.shortestPathsWithPredecessors(0, pred, -3), std::invalid_argument);
+}
+
+TEST(DeltaSteppingTest, ReorderedGraphKeepsOriginalIds) {
+    CsrGraph g = spreadGrid(16, false);
+    ReorderedGraph reordered(g, reverseCuthillMcKeeOrder(g));
+    DeltaStepping engine(reordered, 2);
+    myVector<int> pred;
+    myVector<int> dist = engine.shortestPathsWithPredecessors(40, pred);
+    expectShortestPathTree(g, 40, dist, pred);
+}
+
+TEST(DeltaSteppingTest, GraphEditedAfterConstruction) {
+    Graph g(6, true);
+    g.addEdge(0, 1, 1);
+    DeltaStepping engine(g, 2);
+    EXPECT_EQ(engine.getDefaultDelta(), 1);
+    // With the bucket array still sized for weight 1, vertex 2 would land in a live bucket and be dropped.
+    g.addEdge(0, 2, 10);
+    g.addEdge(2, 3, 1);
+    const int deltas[] = { 0, 1 };
+    for (int delta : deltas) {
+        myVector<int> pred;
+        myVector<int> dist = engine.shortestPathsWithPredecessors(0, pred, delta);
+        EXPECT_EQ(dist[1], 1);
+        EXPECT_EQ(dist[2], 10);
+        EXPECT_EQ(dist[3], 11);
+        EXPECT_EQ(pred[3], 2);
+    }
+    EXPECT_EQ(engine.getDefaultDelta(), 10);
+}
+
+TEST(DeltaSteppingTest, FloatingPointWeights) {
+    BasicCsrGraphBuilder<double> b(4, false);
+    b.addEdge(0, 1, 0.5);
+    b.addEdge(1, 2, 0.25);
+    b.addEdge(0, 2, 1.0);
+    b.addEdge(2, 3, 2.5);
+    BasicCsrGraph<double> g = b.build();
+    BasicDeltaStepping<double> engine(g, 2);
+    myVector<int> pred;
+    myVector<double> dist = engine.shortestPathsWithPredecessors(0, pred, 0.3);
+    EXPECT_DOUBLE_EQ(dist[2], 0.75);
+    EXPECT_DOUBLE_EQ(dist[3], 3.25);
+    EXPECT_EQ(pred[3], 2);
+}
+
+TEST(DeltaSteppingTest, DistanceOverflowIsReported) {
+    Graph g(3);
+    g.addEdge(0, 1, 2000000000);
+    g.addEdge(1, 2, 2000000000);
+    DeltaStepping narrow(g, 2);
+    myVector<int> pred;
+    EXPECT_THROW(narrow.shortestPathsWithPredecessors(0, pred), std::overflow_error);
+
+    BasicGraph<uint16_t> small(3);
+    small.addEdge(0, 1, 60000);
+    small.addEdge(1, 2, 60000);
+    BasicDeltaStepping<uint16_t, uint32_t> wide(small, 2);
+    EXPECT_EQ(wide.shortestPathsWithPredecessors(0, pred)[2], 120000u);
+}
@@ -0,0 +1,110 @@
+#include <gtest.h>
+#include "denseScan.h"
+
+namespace {
+
+const SimdLevel levels[] = { SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512 };
+
+void settle(myVector<uint64_t>& settled, size_t v) {
+    settled[v >> 6] |= uint64_t(1) << (v & 63);
+}
+
+}
+
+TEST(DenseScanTest, SelectsLeastUnsettledDistance) {
+    const size_t n = 203;
+    myVector<int> dist(n, WeightTraits<int>::infinity());
+    myVector<uint64_t> settled((n + 63) / 64, 0);
+    for (SimdLevel level : levels) {
+        DenseScan scan(level);
+        EXPECT_LE(scan.getSimdLevel(), level);
+        EXPECT_EQ(scan.selectMin(dist.data(), settled.data(), n), -1);
+    }
+
+    for (size_t v = 0; v < n; ++v) dist[v] = static_cast<int>((v * 7919) % 1000) + 5;
+    dist[37] = 2;
+    dist[150] = 2;
+    dist[201] = 1;
+    for (SimdLevel level : levels) {
+        DenseScan scan(level);
+        myVector<uint64_t> marks((n + 63) / 64, 0);
+        // The tail past the last whole vector holds the minimum until it is settled.
+        EXPECT_EQ(scan.selectMin(dist.data(), marks.data(), n), 201);
+        settle(marks, 201);
+        EXPECT_EQ(scan.selectMin(dist.data(), marks.data(), n), 37);
+        settle(marks, 37);
+        EXPECT_EQ(scan.selectMin(dist.data(), marks.data(), n), 150);
+    }
+}
+
+TEST(DenseScanTest, SelectsOnWideAndFloatingDistances) {
+    const size_t n = 77;
+    myVector<int64_t> wide(n, WeightTraits<int64_t>::infinity());
+    myVector<double> real(n, WeightTraits<double>::infinity());
+    myVector<uint32_t> narrow(n, WeightTraits<uint32_t>::infinity());
+    myVector<uint64_t> settled((n + 63) / 64, 0);
+    wide[70] = int64_t(1) << 40;
+    wide[12] = (int64_t(1) << 40) + 1;
+    real[3] = 0.5;
+    real[64] = 0.25;
+    narrow[76] = 4000000000u;
+    settle(settled, 64);
+    typedef BasicDenseScan<int, int64_t> WideScan;
+    typedef BasicDenseScan<double, double> RealScan;
+    typedef BasicDenseScan<uint32_t, uint32_t> NarrowScan;
+    for (SimdLevel level : levels) {
+        EXPECT_EQ(WideScan(level).selectMin(wide.data(), settled.data(), n), 70);
+        EXPECT_EQ(RealScan(level).selectMin(real.data(), settled.data(), n), 3);
+        EXPECT_EQ(NarrowScan(level).selectMin(narrow.data(), settled.data(), n), 76);
+    }
+    EXPECT_EQ(NarrowScan(SIMD_AVX512).getSimdLevel(), SIMD_SCALAR);
+}
+
+TEST(DenseScanTest, RelaxRowMatchesScalar) {
+    const size_t n = 150;
+    Graph g(n, true);
+    for (size_t v = 0; v < n; ++v) {
+        if (v != 5 && (v * 31) % 7 != 0) g.addEdge(5, v, static_cast<int>((v * 13) % 40) + 1);
+    }
+    myVector<int> start(n, WeightTraits<int>::infinity());
+    for (size_t v = 0; v < n; v += 3) start[v] = 20;
+    myVector<uint64_t> settled((n + 63) / 64, 0);
+    settle(settled, 9);
+    settle(settled, 100);
+
+    myVector<int> expectedDist = start, expectedPred(n, -1);
+    myVector<uint64_t> expectedImproved((n + 63) / 64, 0);
+    DenseScan(SIMD_SCALAR).relaxRow(g, 5, 3, settled.data(), expectedDist.data(), expectedPred.data(), expectedImproved.data());
+    EXPECT_EQ(expectedDist[9], 20);
+    EXPECT_EQ(expectedPred[9], -1);
+    for (SimdLevel level : levels) {
+        myVector<int> dist = start, pred(n, -1);
+        myVector<uint64_t> improved((n + 63) / 64, ~uint64_t(0));
+        DenseScan(level).relaxRow(g, 5, 3, settled.data(), dist.data(), pred.data(), improved.data());
+        for (size_t v = 0; v < n; ++v) {
+            ASSERT_EQ(dist[v], expectedDist[v]);
+            ASSERT_EQ(pred[v], expectedPred[v]);
+            const bool lowered = (improved[v >> 6] >> (v & 63)) & 1;
+            ASSERT_EQ(lowered, expectedPred[v] == 5);
+        }
+    }
+}
+
+TEST(DenseScanTest, RelaxRowDetectsOverflow) {
+    // Column 5 falls inside the vector loop at every level rather than in the scalar tail.
+    Graph g(40, true);
+    g.addEdge(0, 5, 100);
+    myVector<uint64_t> settled(1, 0);
+    const int infinity = WeightTraits<int>::infinity();
+    for (SimdLevel level : levels) {
+        DenseScan scan(level);
+        myVector<int> dist(40, infinity), pred(40, -1);
+        EXPECT_THROW(scan.relaxRow(g, 0, infinity - 50, settled.data(), dist.data(), pred.data(), nullptr), std::overflow_error);
+        // A sum of exactly infinity is rejected as well, and one below it is kept.
+        EXPECT_THROW(scan.relaxRow(g, 0, infinity - 100, settled.data(), dist.data(), pred.data(), nullptr), std::overflow_error);
+        dist[5] = infinity;
+        scan.relaxRow(g, 0, infinity - 101, settled.data(), dist.data(), pred.data(), nullptr);
+        EXPECT_EQ(dist[5], infinity - 1);
+        EXPECT_EQ(pred[5], 0);
+    }
+}
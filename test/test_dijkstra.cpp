@@ -1,5 +1,7 @@
 #include <gtest.h>
 #include "dijkstra.h"
+#include "reorder.h"
+#include "testGraphs.h"
 
 TEST(DijkstraTest, ShortestPathBasic) {
     Graph g(4);
@@ -294,4 +296,644 @@ TEST(DijkstraTest, PathReconstruction) {
     EXPECT_EQ(path[1], 1);
     EXPECT_EQ(path[2], 2);
     EXPECT_EQ(path[3], 3);
-}
\ No newline at end of file
+}
+
+TEST(DijkstraCsrTest, MatchesDenseGraph) {
+    Graph dense(6);
+    dense.addEdge(0, 1, 7);
+    dense.addEdge(0, 2, 9);
+    dense.addEdge(0, 5, 14);
+    dense.addEdge(1, 2, 10);
+    dense.addEdge(1, 3, 15);
+    dense.addEdge(2, 3, 11);
+    dense.addEdge(2, 5, 2);
+    dense.addEdge(3, 4, 6);
+    dense.addEdge(4, 5, 9);
+    CsrGraph sparse(dense);
+    Dijkstra denseDijkstra(dense);
+    Dijkstra sparseDijkstra(sparse);
+    myVector<int> pred_dense, pred_binom, pred_d;
+    auto expected = denseDijkstra.shortestPathsWithPredecessors(0, Dijkstra::D_HEAP, pred_dense, 2);
+    auto dist_binom = sparseDijkstra.shortestPathsWithPredecessors(0, Dijkstra::BINOMIAL_HEAP, pred_binom, 2);
+    auto dist_d = sparseDijkstra.shortestPathsWithPredecessors(0, Dijkstra::D_HEAP, pred_d, 4);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(dist_binom[i], expected[i]);
+        EXPECT_EQ(dist_d[i], expected[i]);
+    }
+}
+
+TEST(DijkstraCsrTest, PathReconstruction) {
+    CsrGraphBuilder b(4);
+    b.addEdge(0, 1, 1);
+    b.addEdge(1, 2, 2);
+    b.addEdge(2, 3, 3);
+    b.addEdge(0, 3, 10);
+    CsrGraph g = b.build();
+    Dijkstra d(g);
+    myVector<int> pred;
+    auto dist = d.shortestPathsWithPredecessors(0, Dijkstra::D_HEAP, pred, 2);
+    EXPECT_EQ(dist[3], 6);
+
+    auto path = g.getPath(0, 3, pred);
+    ASSERT_EQ(path.size(), 4);
+    EXPECT_EQ(path[0], 0);
+    EXPECT_EQ(path[3], 3);
+}
+
+TEST(DijkstraCsrTest, DisconnectedGraph) {
+    CsrGraphBuilder b(3);
+    b.addEdge(0, 1, 1);
+    CsrGraph g = b.build();
+    Dijkstra d(g);
+    myVector<int> pred;
+    auto dist = d.shortestPathsWithPredecessors(0, Dijkstra::BINOMIAL_HEAP, pred, 2);
+    EXPECT_EQ(dist[1], 1);
+    EXPECT_EQ(dist[2], -1);
+}
+
+TEST(DijkstraPerformanceTest, SparseLargeGraph) {
+    const int N = 200000;
+    CsrGraphBuilder b(N);
+    for (int i = 0; i < N - 1; ++i) {
+        b.addEdge(i, i + 1, 1);
+    }
+    CsrGraph g = b.build();
+    Dijkstra d(g);
+    myVector<int> pred;
+    auto start = std::clock();
+    auto dist = d.shortestPathsWithPredecessors(0, Dijkstra::D_HEAP, pred, 4);
+    double duration = (std::clock() - start) / (double)CLOCKS_PER_SEC;
+    EXPECT_EQ(dist[N - 1], N - 1);
+    EXPECT_LT(duration, 1.0);
+}
+
+TEST(DijkstraDirectedTest, RespectsEdgeDirection) {
+    CsrGraphBuilder b(3, true);
+    b.addEdge(0, 1, 1);
+    b.addEdge(1, 2, 1);
+    b.addEdge(2, 0, 5);
+    CsrGraph g = b.build();
+    Dijkstra d(g);
+    myVector<int> pred;
+    auto dist = d.shortestPathsWithPredecessors(1, Dijkstra::D_HEAP, pred, 2);
+    EXPECT_EQ(dist[2], 1);
+    EXPECT_EQ(dist[0], 6);
+}
+
+TEST(DijkstraDirectedTest, ReverseSearchGivesDistanceToTarget) {
+    Graph dense(4, true);
+    dense.addEdge(0, 1, 2);
+    dense.addEdge(1, 3, 2);
+    dense.addEdge(2, 3, 7);
+    dense.addEdge(3, 2, 1);
+    CsrGraph sparse(dense);
+
+    Dijkstra denseDijkstra(dense);
+    Dijkstra sparseDijkstra(sparse);
+    myVector<int> succ_dense, succ_sparse;
+    auto to_dense = denseDijkstra.shortestPathsToTarget(3, Dijkstra::D_HEAP, succ_dense, 2);
+    auto to_sparse = sparseDijkstra.shortestPathsToTarget(3, Dijkstra::BINOMIAL_HEAP, succ_sparse, 2);
+
+    EXPECT_EQ(to_sparse[0], 4);
+    EXPECT_EQ(to_sparse[1], 2);
+    EXPECT_EQ(to_sparse[2], 7);
+    EXPECT_EQ(to_sparse[3], 0);
+    EXPECT_EQ(succ_sparse[0], 1);
+    EXPECT_EQ(succ_sparse[1], 3);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(to_dense[i], to_sparse[i]);
+    }
+}
+
+TEST(DijkstraDirectedTest, ReverseSearchOnUndirectedMatchesForward) {
+    Graph g(4);
+    g.addEdge(0, 1, 1);
+    g.addEdge(1, 2, 2);
+    g.addEdge(2, 3, 3);
+    Dijkstra d(g);
+    myVector<int> pred, succ;
+    auto from = d.shortestPathsWithPredecessors(3, Dijkstra::D_HEAP, pred, 2);
+    auto to = d.shortestPathsToTarget(3, Dijkstra::D_HEAP, succ, 2);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(from[i], to[i]);
+    }
+}
+
+TEST(DijkstraTypedTest, NarrowWeightsWideDistances) {
+    const int N = 10;
+    BasicCsrGraphBuilder<uint16_t> b(N);
+    for (int i = 0; i < N - 1; ++i) {
+        b.addEdge(i, i + 1, 60000);
+    }
+    BasicCsrGraph<uint16_t> g = b.build();
+    BasicDijkstra<uint16_t, uint32_t> d(g);
+    myVector<int> pred;
+    auto dist = d.shortestPathsWithPredecessors(0, BasicDijkstra<uint16_t, uint32_t>::D_HEAP, pred, 2);
+    EXPECT_EQ(dist[N - 1], 60000u * (N - 1));
+}
+
+TEST(DijkstraTypedTest, UnsignedUnreachableIsMax) {
+    BasicGraph<uint32_t> g(3);
+    g.addEdge(0, 1, 4);
+    BasicDijkstra<uint32_t, uint64_t> d(g);
+    myVector<int> pred;
+    auto dist = d.shortestPathsWithPredecessors(0, BasicDijkstra<uint32_t, uint64_t>::BINOMIAL_HEAP, pred, 2);
+    EXPECT_EQ(dist[1], 4u);
+    EXPECT_EQ(dist[2], WeightTraits<uint64_t>::unreachable());
+}
+
+TEST(DijkstraTypedTest, FloatingWeights) {
+    BasicGraph<float> g(3);
+    g.addEdge(0, 1, 0.5f);
+    g.addEdge(1, 2, 0.25f);
+    g.addEdge(0, 2, 1.0f);
+    BasicDijkstra<float, double> d(g);
+    myVector<int> pred;
+    auto dist = d.shortestPathsWithPredecessors(0, BasicDijkstra<float, double>::D_HEAP, pred, 2);
+    EXPECT_DOUBLE_EQ(dist[2], 0.75);
+    EXPECT_EQ(pred[2], 1);
+}
+
+TEST(DijkstraTypedTest, OverflowIsReported) {
+    Graph g(3);
+    g.addEdge(0, 1, std::numeric_limits<int>::max() - 1);
+    g.addEdge(1, 2, 10);
+    Dijkstra d(g);
+    myVector<int> pred;
+    EXPECT_THROW(d.shortestPathsWithPredecessors(0, Dijkstra::D_HEAP, pred, 2), std::overflow_error);
+
+    BasicDijkstra<int, int64_t> wide(g);
+    auto dist = wide.shortestPathsWithPredecessors(0, BasicDijkstra<int, int64_t>::D_HEAP, pred, 2);
+    EXPECT_EQ(dist[2], static_cast<int64_t>(std::numeric_limits<int>::max()) + 9);
+}
+
+TEST(DijkstraPointToPointTest, ReturnsDistanceAndPath) {
+    Graph g(5);
+    g.addEdge(0, 1, 4);
+    g.addEdge(0, 2, 1);
+    g.addEdge(2, 1, 2);
+    g.addEdge(1, 3, 1);
+    g.addEdge(3, 4, 3);
+    Dijkstra d(g);
+    Dijkstra::PathResult result = d.shortestPath(0, 3, Dijkstra::D_HEAP, 2);
+    EXPECT_EQ(result.distance, 4);
+    ASSERT_EQ(result.path.size(), 4);
+    EXPECT_EQ(result.path[0], 0);
+    EXPECT_EQ(result.path[1], 2);
+    EXPECT_EQ(result.path[2], 1);
+    EXPECT_EQ(result.path[3], 3);
+
+    Dijkstra::PathResult self = d.shortestPath(2, 2, Dijkstra::BINOMIAL_HEAP, 2);
+    EXPECT_EQ(self.distance, 0);
+    ASSERT_EQ(self.path.size(), 1);
+}
+
+TEST(DijkstraPointToPointTest, UnreachableTarget) {
+    Graph g(3, true);
+    g.addEdge(0, 1, 1);
+    g.addEdge(2, 0, 1);
+    Dijkstra d(g);
+    Dijkstra::PathResult result = d.shortestPath(0, 2, Dijkstra::D_HEAP, 2);
+    EXPECT_EQ(result.distance, -1);
+    EXPECT_TRUE(result.path.empty());
+    EXPECT_THROW(d.shortestPath(0, 3, Dijkstra::D_HEAP, 2), std::out_of_range);
+    EXPECT_THROW(d.shortestPath(-1, 1, Dijkstra::D_HEAP, 2), std::out_of_range);
+}
+
+TEST(DijkstraPointToPointTest, MatchesFullSearchOnCsr) {
+    const size_t n = 300;
+    CsrGraphBuilder b(n);
+    for (size_t u = 0; u < n; ++u) {
+        b.addEdge(u, (u + 1) % n, static_cast<int>(u % 7 + 1));
+        b.addEdge(u, (u * 13 + 5) % n, static_cast<int>(u % 11 + 3));
+    }
+    CsrGraph g = b.build();
+    Dijkstra d(g);
+    myVector<int> pred;
+    myVector<int> dist = d.shortestPathsWithPredecessors(17, Dijkstra::D_HEAP, pred, 4);
+    for (int target = 0; target < static_cast<int>(n); target += 23) {
+        Dijkstra::PathResult result = d.shortestPath(17, target, Dijkstra::D_HEAP, 4);
+        EXPECT_EQ(result.distance, dist[target]);
+        int length = 0;
+        for (size_t i = 1; i < result.path.size(); ++i) {
+            length += g.getEdgeWeight(result.path[i - 1], result.path[i]);
+        }
+        EXPECT_EQ(length, dist[target]);
+    }
+}
+
+TEST(DijkstraBucketQueueTest, MatchesDHeapOnSmallWeights) {
+    const int side = 30;
+    CsrGraphBuilder b(side * side, true);
+    for (int u = 0; u < side * side; ++u) {
+        const int w = (u * 7919) % 100 + 1;
+        if ((u + 1) % side) b.addEdge(u, u + 1, w);
+        if (u + side < side * side) b.addEdge(u, u + side, 101 - w);
+        if (u % side) b.addEdge(u, u - 1, w / 2 + 1);
+    }
+    CsrGraph g = b.build();
+    Dijkstra d(g);
+    myVector<int> pred_d, pred_dial, pred_auto;
+    auto expected = d.shortestPathsWithPredecessors(17, Dijkstra::D_HEAP, pred_d, 4);
+    auto dial = d.shortestPathsWithPredecessors(17, Dijkstra::DIAL_BUCKETS, pred_dial, 4);
+    auto automatic = d.shortestPathsWithPredecessors(17, Dijkstra::AUTO, pred_auto, 4);
+    for (int v = 0; v < side * side; ++v) {
+        ASSERT_EQ(dial[v], expected[v]);
+        ASSERT_EQ(automatic[v], expected[v]);
+        if (pred_dial[v] != -1) {
+            EXPECT_EQ(dial[pred_dial[v]] + g.getEdgeWeight(pred_dial[v], v), dial[v]);
+        }
+    }
+    Dijkstra::PathResult result = d.shortestPath(17, side * side - 1, Dijkstra::DIAL_BUCKETS, 2);
+    EXPECT_EQ(result.distance, expected[side * side - 1]);
+    EXPECT_EQ(result.path[0], 17);
+}
+
+TEST(DijkstraBucketQueueTest, AutoFallsBackOnLargeOrFloatingWeights) {
+    Graph g(3);
+    g.addEdge(0, 1, 1000000);
+    g.addEdge(1, 2, 1);
+    Dijkstra d(g);
+    myVector<int> pred;
+    EXPECT_EQ(d.shortestPathsWithPredecessors(0, Dijkstra::AUTO, pred, 2)[2], 1000001);
+    EXPECT_EQ(d.shortestPathsWithPredecessors(0, Dijkstra::DIAL_BUCKETS, pred, 2)[2], 1000001);
+
+    BasicGraph<float> f(3);
+    f.addEdge(0, 1, 0.5f);
+    f.addEdge(1, 2, 0.25f);
+    BasicDijkstra<float, double> fd(f);
+    EXPECT_DOUBLE_EQ(fd.shortestPathsWithPredecessors(0, BasicDijkstra<float, double>::AUTO, pred, 2)[2], 0.75);
+    EXPECT_THROW(fd.shortestPathsWithPredecessors(0, BasicDijkstra<float, double>::DIAL_BUCKETS, pred, 2), std::invalid_argument);
+}
+
+TEST(DijkstraBucketQueueTest, WideDistancesAndUnreachable) {
+    BasicGraph<uint16_t> g(4, true);
+    g.addEdge(0, 1, 60000);
+    g.addEdge(1, 2, 60000);
+    BasicDijkstra<uint16_t, uint32_t> d(g);
+    myVector<int> pred;
+    auto dist = d.shortestPathsWithPredecessors(0, BasicDijkstra<uint16_t, uint32_t>::DIAL_BUCKETS, pred, 2);
+    EXPECT_EQ(dist[2], 120000u);
+    EXPECT_EQ(dist[3], WeightTraits<uint32_t>::unreachable());
+    EXPECT_EQ(pred[3], -1);
+}
+
+TEST(DijkstraWorkspaceTest, ReusedWorkspaceMatchesFreshQueries) {
+    const int side = 25;
+    CsrGraph g = gridGraph(side, true);
+    Dijkstra d(g);
+    DijkstraWorkspace workspace(g.getNumVertices(), 2);
+    for (int query = 0; query < 60; ++query) {
+        const int source = (query * 131) % (side * side);
+        const int target = (query * 577 + 3) % (side * side);
+        Dijkstra::PathResult expected = d.shortestPath(source, target, Dijkstra::D_HEAP, 4);
+        Dijkstra::PathResult actual = d.shortestPath(source, target, workspace);
+        ASSERT_EQ(actual.distance, expected.distance);
+        EXPECT_EQ(d.distance(source, target, workspace), expected.distance);
+        expectPath(g, actual.path, source, target, expected.distance);
+    }
+}
+
+TEST(DijkstraWorkspaceTest, ShortQueriesSettleFewVertices) {
+    const int N = 100000;
+    CsrGraphBuilder b(N);
+    for (int i = 0; i < N - 1; ++i) {
+        b.addEdge(i, i + 1, 1);
+    }
+    CsrGraph g = b.build();
+    Dijkstra d(g);
+    DijkstraWorkspace workspace(N);
+    EXPECT_EQ(workspace.getNumVertices(), static_cast<size_t>(N));
+    EXPECT_EQ(d.distance(50000, 50010, workspace), 10);
+    EXPECT_LE(workspace.getLastSettledCount(), 21u);
+    EXPECT_EQ(d.distance(10, 0, workspace), 10);
+    EXPECT_LE(workspace.getLastSettledCount(), 21u);
+    EXPECT_EQ(d.distance(10, 10, workspace), 0);
+    EXPECT_EQ(workspace.getLastSettledCount(), 1u);
+}
+
+TEST(DijkstraWorkspaceTest, UnreachableAndInvalidQueries) {
+    Graph g(4, true);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 2);
+    Dijkstra d(g);
+    DijkstraWorkspace workspace(4);
+    EXPECT_EQ(d.distance(0, 2, workspace), 4);
+    EXPECT_EQ(d.distance(2, 0, workspace), -1);
+    EXPECT_TRUE(d.shortestPath(0, 3, workspace).path.empty());
+    EXPECT_EQ(d.shortestPath(0, 2, workspace).path.size(), 3u);
+    EXPECT_THROW(d.distance(0, 4, workspace), std::out_of_range);
+    EXPECT_THROW(d.distance(-1, 0, workspace), std::out_of_range);
+    DijkstraWorkspace wrongSize(5);
+    EXPECT_THROW(d.distance(0, 1, wrongSize), std::invalid_argument);
+}
+
+TEST(DijkstraWorkspaceTest, ReorderedGraphUsesOriginalIds) {
+    Graph g(6);
+    g.addEdge(0, 1, 3);
+    g.addEdge(1, 2, 1);
+    g.addEdge(2, 3, 4);
+    g.addEdge(3, 4, 1);
+    g.addEdge(4, 5, 5);
+    g.addEdge(0, 5, 20);
+    CsrGraph csr(g);
+    ReorderedGraph reordered(csr, reverseCuthillMcKeeOrder(csr));
+    Dijkstra plain(g);
+    Dijkstra local(reordered);
+    DijkstraWorkspace workspace(6);
+    Dijkstra::PathResult expected = plain.shortestPath(5, 1, Dijkstra::D_HEAP, 2);
+    Dijkstra::PathResult actual = local.shortestPath(5, 1, workspace);
+    EXPECT_EQ(actual.distance, expected.distance);
+    ASSERT_EQ(actual.path.size(), expected.path.size());
+    for (size_t i = 0; i < expected.path.size(); ++i) {
+        EXPECT_EQ(actual.path[i], expected.path[i]);
+    }
+}
+
+TEST(DijkstraMultiSourceTest, MatchesMinimumOverSingleSourceRuns) {
+    const int side = 20;
+    CsrGraphBuilder b(side * side, true);
+    for (int u = 0; u < side * side; ++u) {
+        const int w = (u * 7919) % 11 + 1;
+        if ((u + 1) % side) b.addEdge(u, u + 1, w);
+        if (u + side < side * side) b.addEdge(u, u + side, w + 2);
+        if (u % side) b.addEdge(u, u - 1, w + 4);
+        if (u >= side) b.addEdge(u, u - side, w + 1);
+    }
+    CsrGraph g = b.build();
+    Dijkstra d(g);
+    myVector<int> sources;
+    sources.push_back(0);
+    sources.push_back(215);
+    sources.push_back(399);
+    sources.push_back(87);
+    myVector<myVector<int>> single;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        myVector<int> pred;
+        single.push_back(d.shortestPathsWithPredecessors(sources[i], Dijkstra::D_HEAP, pred, 2));
+    }
+
+    const Dijkstra::HeapType types[] = { Dijkstra::D_HEAP, Dijkstra::BINOMIAL_HEAP, Dijkstra::DIAL_BUCKETS, Dijkstra::AUTO,
+        Dijkstra::DENSE_SCAN };
+    for (Dijkstra::HeapType type : types) {
+        myVector<int> owners, pred;
+        myVector<int> dist = d.shortestPathsFromSources(sources, type, owners, pred, 4);
+        for (int v = 0; v < side * side; ++v) {
+            int best = single[0][v];
+            for (size_t i = 1; i < sources.size(); ++i) {
+                if (single[i][v] < best) best = single[i][v];
+            }
+            ASSERT_EQ(dist[v], best);
+            ASSERT_GE(owners[v], 0);
+            EXPECT_EQ(single[owners[v]][v], best);
+            if (pred[v] == -1) {
+                EXPECT_EQ(sources[owners[v]], v);
+            }
+            else {
+                EXPECT_EQ(owners[pred[v]], owners[v]);
+            }
+        }
+    }
+}
+
+TEST(DijkstraMultiSourceTest, OffsetsShiftTheCells) {
+    Graph g(5);
+    for (int i = 0; i < 4; ++i) {
+        g.addEdge(i, i + 1, 2);
+    }
+    Dijkstra d(g);
+    myVector<int> sources(2, 0);
+    sources[1] = 4;
+    myVector<int> owners, pred;
+    myVector<int> dist = d.shortestPathsFromSources(sources, Dijkstra::D_HEAP, owners, pred, 2);
+    EXPECT_EQ(dist[1], 2);
+    EXPECT_EQ(dist[3], 2);
+    EXPECT_EQ(owners[1], 0);
+    EXPECT_EQ(owners[3], 1);
+
+    myVector<int> offsets(2, 0);
+    offsets[0] = 5;
+    for (Dijkstra::HeapType type : { Dijkstra::D_HEAP, Dijkstra::DIAL_BUCKETS }) {
+        dist = d.shortestPathsFromSources(sources, offsets, type, owners, pred, 2);
+        EXPECT_EQ(dist[0], 5);
+        EXPECT_EQ(dist[1], 6);
+        EXPECT_EQ(dist[2], 4);
+        EXPECT_EQ(owners[0], 0);
+        EXPECT_EQ(owners[1], 1);
+        EXPECT_EQ(pred[1], 2);
+    }
+
+    // A source whose offset exceeds its distance from another one belongs to the other cell.
+    offsets[0] = 9;
+    dist = d.shortestPathsFromSources(sources, offsets, Dijkstra::D_HEAP, owners, pred, 2);
+    EXPECT_EQ(dist[0], 8);
+    EXPECT_EQ(owners[0], 1);
+}
+
+TEST(DijkstraMultiSourceTest, DuplicatesUnreachableAndInvalidInput) {
+    Graph g(4, true);
+    g.addEdge(0, 1, 3);
+    g.addEdge(2, 1, 1);
+    Dijkstra d(g);
+    myVector<int> sources(3, 0);
+    sources[1] = 2;
+    sources[2] = 0;
+    myVector<int> offsets(3, 7);
+    offsets[2] = 1;
+    myVector<int> owners, pred;
+    myVector<int> dist = d.shortestPathsFromSources(sources, offsets, Dijkstra::D_HEAP, owners, pred, 2);
+    EXPECT_EQ(dist[0], 1);
+    EXPECT_EQ(owners[0], 2);
+    EXPECT_EQ(dist[1], 4);
+    EXPECT_EQ(owners[1], 2);
+    EXPECT_EQ(dist[3], -1);
+    EXPECT_EQ(owners[3], -1);
+    EXPECT_EQ(pred[3], -1);
+
+    EXPECT_THROW(d.shortestPathsFromSources(myVector<int>(), Dijkstra::D_HEAP, owners, pred, 2), std::invalid_argument);
+    EXPECT_THROW(d.shortestPathsFromSources(sources, myVector<int>(2, 0), Dijkstra::D_HEAP, owners, pred, 2), std::invalid_argument);
+    EXPECT_THROW(d.shortestPathsFromSources(sources, myVector<int>(3, -2), Dijkstra::D_HEAP, owners, pred, 2), std::invalid_argument);
+    EXPECT_THROW(d.shortestPathsFromSources(myVector<int>(1, 4), Dijkstra::D_HEAP, owners, pred, 2), std::out_of_range);
+}
+
+TEST(DijkstraMultiSourceTest, ReorderedGraphUsesOriginalIds) {
+    CsrGraphBuilder b(30);
+    for (int i = 0; i + 1 < 30; ++i) {
+        b.addEdge(i, i + 1, i % 4 + 1);
+        if (i + 7 < 30) b.addEdge(i, i + 7, 9);
+    }
+    CsrGraph g = b.build();
+    ReorderedGraph reordered(g, reverseCuthillMcKeeOrder(g));
+    Dijkstra plain(g);
+    Dijkstra local(reordered);
+    myVector<int> sources(2, 3);
+    sources[1] = 26;
+    myVector<int> expectedOwners, owners, pred;
+    myVector<int> expected = plain.shortestPathsFromSources(sources, Dijkstra::D_HEAP, expectedOwners, pred, 2);
+    myVector<int> dist = local.shortestPathsFromSources(sources, Dijkstra::D_HEAP, owners, pred, 2);
+    for (int v = 0; v < 30; ++v) {
+        EXPECT_EQ(dist[v], expected[v]);
+        EXPECT_EQ(owners[v], expectedOwners[v]);
+        if (pred[v] != -1) {
+            EXPECT_EQ(dist[pred[v]] + g.getEdgeWeight(pred[v], v), dist[v]);
+        }
+    }
+}
+
+namespace {
+
+template <typename W>
+BasicGraph<W> denseRandomGraph(size_t n, size_t keepOutOf8, int maxWeight) {
+    BasicGraph<W> g(n, true);
+    for (size_t u = 0; u < n; ++u) {
+        for (size_t v = 0; v < n; ++v) {
+            const size_t h = (u * 7919 + v * 104729) % 1009;
+            if (u != v && h % 8 < keepOutOf8) g.addEdge(u, v, static_cast<W>(h % maxWeight + 1));
+        }
+    }
+    return g;
+}
+
+template <typename W, typename D>
+void expectDenseScanMatchesDHeap(const BasicGraph<W>& g) {
+    typedef BasicDijkstra<W, D> Engine;
+    Engine d(g);
+    const int n = static_cast<int>(g.getNumVertices());
+    for (int source = 0; source < n; source += 17) {
+        myVector<int> pred_heap, pred_scan, pred_auto;
+        myVector<D> expected = d.shortestPathsWithPredecessors(source, Engine::D_HEAP, pred_heap, 4);
+        myVector<D> scan = d.shortestPathsWithPredecessors(source, Engine::DENSE_SCAN, pred_scan, 4);
+        myVector<D> automatic = d.shortestPathsWithPredecessors(source, Engine::AUTO, pred_auto, 4);
+        for (int v = 0; v < n; ++v) {
+            ASSERT_EQ(scan[v], expected[v]);
+            ASSERT_EQ(automatic[v], expected[v]);
+            if (pred_scan[v] != -1) {
+                ASSERT_EQ(scan[pred_scan[v]] + static_cast<D>(g.getEdgeWeight(pred_scan[v], v)), scan[v]);
+            }
+        }
+    }
+}
+
+}
+
+TEST(DijkstraDenseScanTest, MatchesDHeapOnDenseGraphs) {
+    expectDenseScanMatchesDHeap<int, int>(denseRandomGraph<int>(131, 7, 100));
+    expectDenseScanMatchesDHeap<int, int64_t>(denseRandomGraph<int>(70, 6, 100));
+    expectDenseScanMatchesDHeap<int64_t, int64_t>(denseRandomGraph<int64_t>(67, 8, 1000));
+    expectDenseScanMatchesDHeap<uint16_t, uint32_t>(denseRandomGraph<uint16_t>(50, 5, 1000));
+    expectDenseScanMatchesDHeap<uint32_t, uint32_t>(denseRandomGraph<uint32_t>(50, 5, 1000));
+    expectDenseScanMatchesDHeap<float, float>(denseRandomGraph<float>(83, 7, 50));
+    expectDenseScanMatchesDHeap<double, double>(denseRandomGraph<double>(66, 4, 50));
+}
+
+TEST(DijkstraDenseScanTest, TargetsUnreachableAndOtherBackends) {
+    Graph g = denseRandomGraph<int>(90, 7, 30);
+    for (size_t v = 0; v < 89; ++v) {
+        if (g.hasEdge(v, 89)) g.removeEdge(v, 89);
+    }
+    Dijkstra d(g);
+    myVector<int> pred;
+    myVector<int> dist = d.shortestPathsWithPredecessors(0, Dijkstra::DENSE_SCAN, pred, 2);
+    EXPECT_EQ(dist[89], -1);
+    EXPECT_EQ(pred[89], -1);
+    Dijkstra::PathResult result = d.shortestPath(3, 77, Dijkstra::DENSE_SCAN, 2);
+    EXPECT_EQ(result.distance, d.shortestPath(3, 77, Dijkstra::D_HEAP, 2).distance);
+    EXPECT_EQ(result.path[0], 3);
+    EXPECT_EQ(result.path[result.path.size() - 1], 77);
+
+    CsrGraphBuilder b(40, false);
+    for (int u = 0; u + 1 < 40; ++u) {
+        b.addEdge(u, u + 1, u % 5 + 1);
+        if (u + 7 < 40) b.addEdge(u, u + 7, 9);
+    }
+    CsrGraph csr = b.build();
+    Dijkstra c(csr);
+    myVector<int> pred_heap;
+    myVector<int> expected = c.shortestPathsWithPredecessors(11, Dijkstra::D_HEAP, pred_heap, 2);
+    myVector<int> scan = c.shortestPathsWithPredecessors(11, Dijkstra::DENSE_SCAN, pred, 2);
+    for (int v = 0; v < 40; ++v) {
+        ASSERT_EQ(scan[v], expected[v]);
+    }
+}
+
+TEST(DijkstraDenseScanTest, OverflowIsReported) {
+    // Vertex 5 lies inside the first vector at every level, so the vector kernels must catch the overflow.
+    Graph g(20, true);
+    g.addEdge(0, 1, 2000000000);
+    g.addEdge(1, 5, 2000000000);
+    Dijkstra d(g);
+    myVector<int> pred;
+    EXPECT_THROW(d.shortestPathsWithPredecessors(0, Dijkstra::DENSE_SCAN, pred, 2), std::overflow_error);
+
+    // A sum landing exactly on infinity is an overflow too; one less is the longest path that fits.
+    Graph exact(20, true);
+    exact.addEdge(0, 1, 1 << 30);
+    exact.addEdge(1, 5, (1 << 30) - 1);
+    Dijkstra e(exact);
+    EXPECT_THROW(e.shortestPathsWithPredecessors(0, Dijkstra::DENSE_SCAN, pred, 2), std::overflow_error);
+    exact.removeEdge(1, 5);
+    exact.addEdge(1, 5, (1 << 30) - 2);
+    Dijkstra fits(exact);
+    EXPECT_EQ(fits.shortestPathsWithPredecessors(0, Dijkstra::DENSE_SCAN, pred, 2)[5], WeightTraits<int>::infinity() - 1);
+}
+
+TEST(DijkstraDenseScanTest, QueuesMatchOnMatrixAndCsr) {
+    Graph g = denseRandomGraph<int>(140, 3, 60);
+    CsrGraph csr(g);
+    Dijkstra dense(g), sparse(csr);
+    const Dijkstra::HeapType types[] = { Dijkstra::D_HEAP, Dijkstra::BINOMIAL_HEAP, Dijkstra::DIAL_BUCKETS };
+    for (Dijkstra::HeapType type : types) {
+        for (int source = 0; source < 140; source += 29) {
+            myVector<int> pred_dense, pred_sparse;
+            myVector<int> expected = sparse.shortestPathsWithPredecessors(source, type, pred_sparse, 4);
+            myVector<int> dist = dense.shortestPathsWithPredecessors(source, type, pred_dense, 4);
+            for (int v = 0; v < 140; ++v) {
+                ASSERT_EQ(dist[v], expected[v]);
+                ASSERT_EQ(pred_dense[v], pred_sparse[v]);
+            }
+        }
+    }
+}
+
+TEST(DijkstraBucketQueueTest, AutoPointToPointStopsAtTarget) {
+    // Left arcs weigh 2 and right arcs 3, so no vertex ties with the target and both queues settle the same set.
+    const int n = 1000;
+    CsrGraphBuilder b(n, true);
+    for (int u = 0; u + 1 < n; ++u) {
+        b.addEdge(u, u + 1, 3);
+        b.addEdge(u + 1, u, 2);
+    }
+    CsrGraph g = b.build();
+    Dijkstra d(g);
+    Dijkstra::PathResult heap = d.shortestPath(500, 503, Dijkstra::D_HEAP, 4);
+    const size_t heapSettled = d.getLastSettledCount();
+    Dijkstra::PathResult automatic = d.shortestPath(500, 503, Dijkstra::AUTO, 4);
+    EXPECT_EQ(automatic.distance, heap.distance);
+    EXPECT_LE(d.getLastSettledCount(), heapSettled);
+    EXPECT_EQ(heapSettled, 8u);
+}
+
+TEST(DijkstraBucketQueueTest, GraphEditedAfterConstruction) {
+    // The engine is built on an empty graph, so the largest weight it first sees is zero.
+    const int n = 200;
+    Graph g(n, true);
+    Dijkstra d(g);
+    for (int i = 1; i < n; ++i) {
+        g.addEdge(0, i, i % 7 + 1);
+        if (i + 1 < n) g.addEdge(i, i + 1, 100);
+    }
+    const Dijkstra::HeapType types[] = { Dijkstra::AUTO, Dijkstra::DIAL_BUCKETS };
+    for (int round = 0; round < 2; ++round) {
+        myVector<int> pred_heap;
+        myVector<int> expected = d.shortestPathsWithPredecessors(0, Dijkstra::D_HEAP, pred_heap, 2);
+        for (Dijkstra::HeapType type : types) {
+            myVector<int> pred;
+            myVector<int> dist = d.shortestPathsWithPredecessors(0, type, pred, 2);
+            for (int v = 0; v < n; ++v) ASSERT_EQ(dist[v], expected[v]);
+        }
+        if (round > 0) break;
+        // Heavier arcs than any seen so far must widen the bucket window again.
+        g.updateEdgeWeight(0, n - 1, 3000);
+        g.removeEdge(0, n / 2);
+    }
+}
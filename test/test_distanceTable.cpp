@@ -0,0 +1,96 @@
+#include <gtest.h>
+#include "distanceTable.h"
+#include "testGraphs.h"
+
+namespace {
+
+void expectTableExact(const CsrGraph& g, size_t threads) {
+    const int n = static_cast<int>(g.getNumVertices());
+    ContractionHierarchy ch(g, 1);
+    DistanceTable table(ch, threads);
+    myVector<int> sources, targets;
+    for (int v = 0; v < n; v += 11) sources.push_back(v);
+    for (int v = 3; v < n; v += 7) targets.push_back(v);
+    targets.push_back(sources[2]);
+
+    for (int round = 0; round < 2; ++round) {
+        myVector<int> result = table.compute(sources, targets);
+        ASSERT_EQ(result.size(), sources.size() * targets.size());
+        EXPECT_GT(table.getLastBucketEntries(), targets.size());
+        for (size_t i = 0; i < sources.size(); ++i) {
+            myVector<int> dist = dijkstraDistances(g, sources[i]);
+            for (size_t j = 0; j < targets.size(); ++j) {
+                ASSERT_EQ(result[i * targets.size() + j], dist[targets[j]]);
+            }
+        }
+    }
+}
+
+}
+
+TEST(DistanceTableTest, MatchesDijkstraOnUndirectedGrid) {
+    expectTableExact(gridGraph(14, false), 1);
+}
+
+TEST(DistanceTableTest, MatchesDijkstraOnDirectedGridWithThreads) {
+    expectTableExact(gridGraph(12, true), 3);
+}
+
+TEST(DistanceTableTest, WritesIntoCallerBuffer) {
+    CsrGraph g = gridGraph(8, false);
+    ContractionHierarchy ch(g);
+    DistanceTable table(ch, 2);
+    ChQuery query(ch);
+    myVector<int> sources(3, 0);
+    sources[1] = 63;
+    sources[2] = 0;
+    myVector<int> targets(2, 63);
+    targets[1] = 27;
+    int buffer[8];
+    buffer[6] = 12345;
+    buffer[7] = 12345;
+    table.compute(sources, targets, buffer);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        for (size_t j = 0; j < targets.size(); ++j) {
+            EXPECT_EQ(buffer[i * 2 + j], query.distance(sources[i], targets[j]));
+        }
+    }
+    EXPECT_EQ(buffer[2], 0);
+    EXPECT_EQ(buffer[6], 12345);
+    EXPECT_EQ(buffer[7], 12345);
+}
+
+TEST(DistanceTableTest, UnreachableEmptyAndInvalid) {
+    Graph g(4, true);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 2);
+    ContractionHierarchy ch(g);
+    DistanceTable table(ch);
+    myVector<int> all;
+    for (int v = 0; v < 4; ++v) all.push_back(v);
+    myVector<int> result = table.compute(all, all);
+    EXPECT_EQ(result[0 * 4 + 2], 4);
+    EXPECT_EQ(result[2 * 4 + 0], -1);
+    EXPECT_EQ(result[3 * 4 + 3], 0);
+    EXPECT_EQ(result[0 * 4 + 3], -1);
+
+    EXPECT_TRUE(table.compute(myVector<int>(), all).empty());
+    EXPECT_TRUE(table.compute(all, myVector<int>()).empty());
+    EXPECT_EQ(table.getLastBucketEntries(), 0u);
+    EXPECT_THROW(table.compute(myVector<int>(1, 4), all), std::out_of_range);
+    EXPECT_THROW(table.compute(all, myVector<int>(1, -1)), std::out_of_range);
+}
+
+TEST(DistanceTableTest, WideDistances) {
+    BasicGraph<uint16_t> g(3);
+    g.addEdge(0, 1, 60000);
+    g.addEdge(1, 2, 60000);
+    BasicContractionHierarchy<uint16_t, uint32_t> ch(g);
+    BasicDistanceTable<uint16_t, uint32_t> table(ch, 2);
+    myVector<int> ends(2, 0);
+    ends[1] = 2;
+    myVector<uint32_t> result = table.compute(ends, ends);
+    EXPECT_EQ(result[1], 120000u);
+    EXPECT_EQ(result[2], 120000u);
+    EXPECT_EQ(result[3], 0u);
+}
@@ -0,0 +1,152 @@
+#include <gtest.h>
+#include "dynamicGraph.h"
+#include "dijkstra.h"
+
+namespace {
+
+CsrGraph pathGraph(size_t n, bool directed = false) {
+    CsrGraphBuilder builder(n, directed);
+    for (size_t v = 1; v < n; ++v) {
+        builder.addEdge(v - 1, v, 1);
+    }
+    return builder.build();
+}
+
+myVector<EdgeUpdate> batchOf(EdgeUpdate update) {
+    myVector<EdgeUpdate> batch;
+    batch.push_back(update);
+    return batch;
+}
+
+}
+
+TEST(DynamicGraphTest, InsertRemoveAndReweight) {
+    DynamicGraph g(pathGraph(4));
+    myVector<EdgeUpdate> batch;
+    batch.push_back({ EdgeUpdate::INSERT, 0, 3, 2 });
+    batch.push_back({ EdgeUpdate::REWEIGHT, 1, 2, 7 });
+    batch.push_back({ EdgeUpdate::REMOVE, 3, 2, 0 });
+    g.applyBatch(batch);
+
+    GraphSnapshot s = g.snapshot();
+    EXPECT_EQ(s.getEdgeWeight(0, 3), 2);
+    EXPECT_EQ(s.getEdgeWeight(3, 0), 2);
+    EXPECT_EQ(s.getEdgeWeight(2, 1), 7);
+    EXPECT_EQ(s.getEdgeWeight(2, 3), -1);
+    EXPECT_EQ(s.getEdgeWeight(0, 1), 1);
+
+    myVector<size_t> neighbors;
+    s.forEachNeighbor(3, [&](size_t v, int) { neighbors.push_back(v); });
+    ASSERT_EQ(neighbors.size(), 1);
+    EXPECT_EQ(neighbors[0], 0);
+}
+
+TEST(DynamicGraphTest, FailingBatchChangesNothing) {
+    DynamicGraph g(pathGraph(3));
+    myVector<EdgeUpdate> batch;
+    batch.push_back({ EdgeUpdate::REWEIGHT, 0, 1, 5 });
+    batch.push_back({ EdgeUpdate::INSERT, 1, 2, 3 });
+    EXPECT_THROW(g.applyBatch(batch), std::logic_error);
+    EXPECT_EQ(g.snapshot().getEdgeWeight(0, 1), 1);
+
+    EXPECT_THROW(g.applyBatch(batchOf({ EdgeUpdate::REMOVE, 0, 2, 0 })), std::logic_error);
+    EXPECT_THROW(g.applyBatch(batchOf({ EdgeUpdate::INSERT, 0, 3, 1 })), std::out_of_range);
+    EXPECT_THROW(g.applyBatch(batchOf({ EdgeUpdate::INSERT, 0, 2, 0 })), std::invalid_argument);
+    EXPECT_THROW(g.applyBatch(batchOf({ EdgeUpdate::INSERT, 1, 1, 1 })), std::invalid_argument);
+    EXPECT_EQ(g.getOverlaySize(), 0);
+}
+
+TEST(DynamicGraphTest, UpdatesWithinBatchApplyInOrder) {
+    DynamicGraph g(pathGraph(3));
+    myVector<EdgeUpdate> batch;
+    batch.push_back({ EdgeUpdate::INSERT, 0, 2, 4 });
+    batch.push_back({ EdgeUpdate::REWEIGHT, 2, 0, 6 });
+    batch.push_back({ EdgeUpdate::REMOVE, 0, 1, 0 });
+    batch.push_back({ EdgeUpdate::INSERT, 1, 0, 8 });
+    g.applyBatch(batch);
+    GraphSnapshot s = g.snapshot();
+    EXPECT_EQ(s.getEdgeWeight(0, 2), 6);
+    EXPECT_EQ(s.getEdgeWeight(0, 1), 8);
+}
+
+TEST(DynamicGraphTest, RevertedEdgesLeaveOverlay) {
+    DynamicGraph g(pathGraph(3));
+    g.applyBatch(batchOf({ EdgeUpdate::REWEIGHT, 0, 1, 5 }));
+    EXPECT_EQ(g.getOverlaySize(), 2);
+    g.applyBatch(batchOf({ EdgeUpdate::REWEIGHT, 1, 0, 1 }));
+    EXPECT_EQ(g.getOverlaySize(), 0);
+}
+
+TEST(DynamicGraphTest, SnapshotIsIsolatedFromLaterBatches) {
+    DynamicGraph g(pathGraph(3));
+    GraphSnapshot before = g.snapshot();
+    g.applyBatch(batchOf({ EdgeUpdate::REMOVE, 1, 2, 0 }));
+    EXPECT_EQ(before.getEdgeWeight(1, 2), 1);
+    EXPECT_EQ(g.snapshot().getEdgeWeight(1, 2), -1);
+}
+
+TEST(DynamicGraphTest, DirectedUpdatesKeepInNeighbors) {
+    DynamicGraph g(pathGraph(3, true));
+    g.applyBatch(batchOf({ EdgeUpdate::INSERT, 2, 0, 3 }));
+    GraphSnapshot s = g.snapshot();
+    EXPECT_EQ(s.getEdgeWeight(2, 0), 3);
+    EXPECT_EQ(s.getEdgeWeight(0, 2), -1);
+
+    myVector<size_t> sources;
+    s.forEachInNeighbor(0, [&](size_t u, int) { sources.push_back(u); });
+    ASSERT_EQ(sources.size(), 1);
+    EXPECT_EQ(sources[0], 2);
+}
+
+TEST(DynamicGraphTest, CompactionFoldsOverlayIntoBase) {
+    DynamicGraph g(pathGraph(5, true));
+    myVector<EdgeUpdate> batch;
+    batch.push_back({ EdgeUpdate::INSERT, 4, 0, 2 });
+    batch.push_back({ EdgeUpdate::REMOVE, 1, 2, 0 });
+    g.applyBatch(batch);
+    g.compact();
+
+    GraphSnapshot s = g.snapshot();
+    EXPECT_EQ(s.getOverlaySize(), 0);
+    EXPECT_EQ(s.getBase().getNumArcs(), 4);
+    EXPECT_EQ(s.getBase().getEdgeWeight(4, 0), 2);
+    EXPECT_EQ(s.getBase().getEdgeWeight(1, 2), -1);
+    EXPECT_EQ(s.getBase().getInDegree(0), 1);
+}
+
+TEST(DynamicGraphTest, BackgroundCompactionKeepsLaterBatches) {
+    const size_t n = 200;
+    DynamicGraph g(pathGraph(n), 16);
+    for (size_t round = 0; round < 20; ++round) {
+        myVector<EdgeUpdate> batch;
+        for (size_t v = 1; v < n; ++v) {
+            batch.push_back({ EdgeUpdate::REWEIGHT, v - 1, v, static_cast<int>(round + 2) });
+        }
+        g.applyBatch(batch);
+    }
+    g.applyBatch(batchOf({ EdgeUpdate::INSERT, 0, n - 1, 1 }));
+    g.waitForCompaction();
+    EXPECT_FALSE(g.isCompacting());
+
+    GraphSnapshot s = g.snapshot();
+    for (size_t v = 1; v < n; ++v) {
+        EXPECT_EQ(s.getEdgeWeight(v - 1, v), 21);
+    }
+    EXPECT_EQ(s.getEdgeWeight(n - 1, 0), 1);
+}
+
+TEST(DynamicGraphTest, DijkstraRunsOnSnapshot) {
+    DynamicGraph g(pathGraph(4));
+    GraphSnapshot before = g.snapshot();
+    g.applyBatch(batchOf({ EdgeUpdate::INSERT, 0, 3, 1 }));
+    GraphSnapshot after = g.snapshot();
+
+    myVector<int> pred;
+    Dijkstra oldEngine(before);
+    EXPECT_EQ(oldEngine.shortestPathsWithPredecessors(0, Dijkstra::D_HEAP, pred, 2)[3], 3);
+    Dijkstra newEngine(after);
+    myVector<int> dist = newEngine.shortestPathsWithPredecessors(0, Dijkstra::BINOMIAL_HEAP, pred, 2);
+    EXPECT_EQ(dist[3], 1);
+    EXPECT_EQ(dist[2], 2);
+    EXPECT_EQ(pred[3], 0);
+}
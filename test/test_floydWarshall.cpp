@@ -0,0 +1,143 @@
+#include <gtest.h>
+#include "floydWarshall.h"
+#include "testGraphs.h"
+
+namespace {
+
+template <typename W>
+BasicGraph<W> denseGraph(size_t n, bool directed, long maxWeight) {
+    BasicGraph<W> g(n, directed);
+    for (size_t u = 0; u < n; ++u) {
+        for (size_t v = 0; v < n; ++v) {
+            if (u == v || (!directed && v < u)) continue;
+            const long h = static_cast<long>((u * 7919 + v * 104729) % 1009);
+            if (h % 3 == 0) continue;
+            g.addEdge(u, v, static_cast<W>(h % maxWeight + 1));
+        }
+    }
+    return g;
+}
+
+template <typename W, typename D>
+void expectMatrixExact(const BasicGraph<W>& g, const AlignedMatrix<D>& distances, const AlignedMatrix<int>* predecessors) {
+    const size_t n = g.getNumVertices();
+    for (size_t source = 0; source < n; ++source) {
+        myVector<D> dist = dijkstraDistances<D>(g, static_cast<int>(source));
+        for (size_t v = 0; v < n; ++v) {
+            ASSERT_EQ(distances[source][v], dist[v]) << source << " -> " << v;
+        }
+        if (!predecessors) continue;
+        // Each predecessor row must spell out paths of the reported lengths.
+        const int* row = (*predecessors)[source];
+        EXPECT_EQ(row[source], -1);
+        for (size_t v = 0; v < n; ++v) {
+            if (v == source || dist[v] == WeightTraits<D>::unreachable()) continue;
+            const int p = row[v];
+            ASSERT_GE(p, 0);
+            ASSERT_TRUE(g.hasEdge(static_cast<size_t>(p), v));
+            ASSERT_EQ(distances[source][p] + static_cast<D>(g.getEdgeWeight(static_cast<size_t>(p), v)), dist[v]);
+        }
+    }
+}
+
+}
+
+TEST(FloydWarshallTest, EverySimdLevelMatchesDijkstra) {
+    Graph g = denseGraph<int>(101, true, 50);
+    const SimdLevel levels[] = { SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512 };
+    const size_t tiles[] = { 16, 32, 64, 200 };
+    for (SimdLevel level : levels) {
+        for (size_t tile : tiles) {
+            FloydWarshall fw(3, level, tile);
+            EXPECT_LE(fw.getSimdLevel(), level);
+            AlignedMatrix<int> distances;
+            AlignedMatrix<int> predecessors;
+            fw.run(g, distances);
+            expectMatrixExact(g, distances, static_cast<const AlignedMatrix<int>*>(nullptr));
+            fw.run(g, distances, &predecessors);
+            expectMatrixExact(g, distances, &predecessors);
+        }
+    }
+}
+
+TEST(FloydWarshallTest, WideAndFloatingDistances) {
+    const SimdLevel levels[] = { SIMD_SCALAR, SIMD_AVX2, SIMD_AVX512 };
+    BasicGraph<int> ints = denseGraph<int>(45, false, 1000);
+    BasicGraph<uint32_t> unsigneds = denseGraph<uint32_t>(37, true, 1000);
+    BasicGraph<float> floats = denseGraph<float>(43, true, 100);
+    BasicGraph<double> doubles = denseGraph<double>(29, false, 100);
+    for (SimdLevel level : levels) {
+        AlignedMatrix<int> predecessors;
+        AlignedMatrix<int64_t> wide;
+        BasicFloydWarshall<int, int64_t>(2, level, 16).run(ints, wide, &predecessors);
+        expectMatrixExact(ints, wide, &predecessors);
+        AlignedMatrix<uint32_t> narrow;
+        BasicFloydWarshall<uint32_t, uint32_t>(2, level, 16).run(unsigneds, narrow, &predecessors);
+        expectMatrixExact(unsigneds, narrow, &predecessors);
+        AlignedMatrix<float> single;
+        BasicFloydWarshall<float, float>(2, level, 16).run(floats, single, &predecessors);
+        expectMatrixExact(floats, single, &predecessors);
+        AlignedMatrix<double> twice;
+        BasicFloydWarshall<double, double>(2, level, 16).run(doubles, twice, &predecessors);
+        expectMatrixExact(doubles, twice, &predecessors);
+    }
+}
+
+TEST(FloydWarshallTest, UnreachableVerticesAndPaths) {
+    Graph g(5, true);
+    g.addEdge(0, 1, 4);
+    g.addEdge(1, 2, 1);
+    g.addEdge(0, 2, 7);
+    g.addEdge(2, 3, 2);
+    AlignedMatrix<int> distances;
+    AlignedMatrix<int> predecessors;
+    FloydWarshall(1).run(g, distances, &predecessors);
+    EXPECT_EQ(distances[0][3], 7);
+    EXPECT_EQ(distances[3][0], -1);
+    EXPECT_EQ(distances[0][4], -1);
+    EXPECT_EQ(distances[4][4], 0);
+    EXPECT_EQ(predecessors[0][4], -1);
+
+    const size_t n = g.getNumVertices();
+    myVector<int> row(n);
+    for (size_t v = 0; v < n; ++v) row[v] = predecessors[0][v];
+    myVector<int> path = reconstructPath(0, 3, row);
+    ASSERT_EQ(path.size(), 4u);
+    EXPECT_EQ(path[0], 0);
+    EXPECT_EQ(path[1], 1);
+    EXPECT_EQ(path[2], 2);
+    EXPECT_EQ(path[3], 3);
+}
+
+TEST(FloydWarshallTest, RunInPlaceOnArcMatrix) {
+    AlignedMatrix<int> distances(4, 4, -1);
+    distances[0][1] = 3;
+    distances[1][2] = 3;
+    distances[0][2] = 9;
+    distances[2][0] = 1;
+    distances[3][3] = 5;
+    FloydWarshall(2, SIMD_AVX2).runInPlace(distances);
+    EXPECT_EQ(distances[0][2], 6);
+    EXPECT_EQ(distances[2][1], 4);
+    EXPECT_EQ(distances[1][0], 4);
+    EXPECT_EQ(distances[3][3], 0);
+    EXPECT_EQ(distances[0][3], -1);
+
+    AlignedMatrix<int> negative(2, 2, -1);
+    negative[0][1] = -5;
+    EXPECT_THROW(FloydWarshall().runInPlace(negative), std::invalid_argument);
+    AlignedMatrix<int> oblong(2, 3, -1);
+    EXPECT_THROW(FloydWarshall().runInPlace(oblong), std::invalid_argument);
+    EXPECT_THROW(FloydWarshall(1, SIMD_SCALAR, 0), std::invalid_argument);
+}
+
+TEST(FloydWarshallTest, RejectsPathsThatCouldOverflow) {
+    Graph g(3, true);
+    g.addEdge(0, 1, 1 << 29);
+    g.addEdge(1, 2, 1 << 29);
+    AlignedMatrix<int> distances;
+    EXPECT_THROW(FloydWarshall().run(g, distances), std::overflow_error);
+    AlignedMatrix<int64_t> wide;
+    BasicFloydWarshall<int, int64_t>().run(g, wide);
+    EXPECT_EQ(wide[0][2], int64_t(1) << 30);
+}
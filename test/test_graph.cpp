@@ -175,4 +175,118 @@ TEST(GraphTest, GetEdgeWeightInEmptyGraph) {
     EXPECT_EQ(graph.getEdgeWeight(0, 1), -1);
     EXPECT_EQ(graph.getEdgeWeight(1, 2), -1);
     EXPECT_EQ(graph.getEdgeWeight(0, 0), 0); 
-}
\ No newline at end of file
+}
+
+TEST(GraphTest, DirectedAddEdgeDoesNotMirror) {
+    Graph g(3, true);
+    g.addEdge(0, 1, 4);
+    EXPECT_TRUE(g.isDirected());
+    EXPECT_EQ(g.getEdgeWeight(0, 1), 4);
+    EXPECT_EQ(g.getEdgeWeight(1, 0), -1);
+    EXPECT_NO_THROW(g.addEdge(1, 0, 6));
+    EXPECT_EQ(g.getEdgeWeight(1, 0), 6);
+}
+
+TEST(GraphTest, DirectedInNeighbors) {
+    Graph g(3, true);
+    g.addEdge(0, 2, 1);
+    g.addEdge(1, 2, 5);
+    myVector<size_t> sources;
+    g.forEachInNeighbor(2, [&](size_t u, int) { sources.push_back(u); });
+    ASSERT_EQ(sources.size(), 2);
+    EXPECT_EQ(sources[0], 0);
+    EXPECT_EQ(sources[1], 1);
+}
+
+TEST(GraphTest, DirectedConnectivityIgnoresDirection) {
+    Graph g(3, true);
+    g.addEdge(1, 0, 1);
+    g.addEdge(1, 2, 1);
+    EXPECT_TRUE(g.isConnected());
+}
+
+TEST(GraphTest, UnsignedWeightsUseMaxAsNoEdge) {
+    BasicGraph<uint16_t> g(3);
+    g.addEdge(0, 1, 65000);
+    EXPECT_EQ(g.getEdgeWeight(0, 1), 65000);
+    EXPECT_EQ(g.getEdgeWeight(0, 2), WeightTraits<uint16_t>::noEdge());
+    EXPECT_THROW(g.addEdge(1, 2, 0), std::invalid_argument);
+    EXPECT_THROW(g.addEdge(1, 2, 65535), std::invalid_argument);
+}
+
+TEST(GraphTest, FloatingWeights) {
+    BasicGraph<double> g(2);
+    g.addEdge(0, 1, 0.25);
+    EXPECT_DOUBLE_EQ(g.getEdgeWeight(1, 0), 0.25);
+    EXPECT_THROW(g.addEdge(0, 1, -0.5), std::invalid_argument);
+}
+
+TEST(GraphTest, RemoveEdgeClearsBothDirections) {
+    Graph g(3);
+    g.addEdge(0, 1, 4);
+    g.removeEdge(1, 0);
+    EXPECT_EQ(g.getEdgeWeight(0, 1), -1);
+    EXPECT_EQ(g.getEdgeWeight(1, 0), -1);
+    EXPECT_THROW(g.removeEdge(0, 1), std::logic_error);
+    EXPECT_NO_THROW(g.addEdge(0, 1, 2));
+}
+
+TEST(GraphTest, UpdateEdgeWeight) {
+    Graph g(3, true);
+    g.addEdge(0, 1, 4);
+    g.updateEdgeWeight(0, 1, 9);
+    EXPECT_EQ(g.getEdgeWeight(0, 1), 9);
+    EXPECT_EQ(g.getEdgeWeight(1, 0), -1);
+    EXPECT_THROW(g.updateEdgeWeight(1, 0, 3), std::logic_error);
+    EXPECT_THROW(g.updateEdgeWeight(0, 1, 0), std::invalid_argument);
+    EXPECT_THROW(g.updateEdgeWeight(0, 5, 1), std::out_of_range);
+}
+
+TEST(GraphTest, EdgeBitsTrackArcs) {
+    Graph g(130, true);
+    g.addEdge(0, 129, 3);
+    g.addEdge(64, 1, 2);
+    EXPECT_TRUE(g.hasEdge(0, 129));
+    EXPECT_FALSE(g.hasEdge(129, 0));
+    EXPECT_FALSE(g.hasEdge(0, 0));
+    EXPECT_EQ(g.getEdgeBits().cols(), 3);
+    EXPECT_EQ(g.getNumArcs(), 2);
+    g.removeEdge(0, 129);
+    EXPECT_FALSE(g.hasEdge(0, 129));
+    EXPECT_EQ(g.getNumArcs(), 1);
+
+    Graph undirected(3);
+    undirected.addEdge(0, 2, 1);
+    EXPECT_EQ(undirected.getNumArcs(), 2);
+}
+
+TEST(GraphTest, NeighborsComeFromBitRows) {
+    Graph g(200, true);
+    g.addEdge(5, 199, 1);
+    g.addEdge(5, 63, 2);
+    g.addEdge(5, 64, 3);
+    g.addEdge(70, 5, 4);
+    myVector<size_t> out;
+    g.forEachNeighbor(5, [&](size_t v, int) { out.push_back(v); });
+    ASSERT_EQ(out.size(), 3);
+    EXPECT_EQ(out[0], 63);
+    EXPECT_EQ(out[1], 64);
+    EXPECT_EQ(out[2], 199);
+
+    myVector<int> in;
+    g.forEachInNeighbor(5, [&](size_t u, int w) { in.push_back(static_cast<int>(u) * 10 + w); });
+    ASSERT_EQ(in.size(), 1);
+    EXPECT_EQ(in[0], 704);
+}
+
+TEST(GraphTest, ConnectivityAcrossWordBoundaries) {
+    Graph g(150);
+    for (size_t v = 1; v < 150; ++v) {
+        g.addEdge(v - 1, v, 1);
+    }
+    EXPECT_TRUE(g.isConnected());
+    g.removeEdge(63, 64);
+    EXPECT_FALSE(g.isConnected());
+    g.addEdge(0, 149, 1);
+    EXPECT_TRUE(g.isConnected());
+}
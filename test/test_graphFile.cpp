@@ -0,0 +1,176 @@
+#include <gtest.h>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include "graphFile.h"
+#include "dijkstra.h"
+
+namespace {
+
+CsrGraph sampleGraph(bool directed) {
+    CsrGraphBuilder b(5, directed);
+    b.addEdge(0, 1, 4);
+    b.addEdge(0, 2, 1);
+    b.addEdge(2, 1, 2);
+    b.addEdge(1, 3, 5);
+    b.addEdge(3, 4, 3);
+    return b.build();
+}
+
+template <typename T>
+void overwrite(const std::string& path, uint64_t position, T value) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(static_cast<std::streamoff>(position));
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+GraphFileHeader readHeader(const std::string& path) {
+    GraphFileHeader header;
+    std::ifstream in(path, std::ios::binary);
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    return header;
+}
+
+}
+
+TEST(GraphFileTest, RoundTripUndirected) {
+    const std::string path = "graph_file_test_undirected.bin";
+    CsrGraph original = sampleGraph(false);
+    saveGraphFile(original, path);
+    {
+        CsrGraph loaded = loadGraphFile(path);
+        EXPECT_FALSE(loaded.isDirected());
+        EXPECT_EQ(loaded.getNumVertices(), original.getNumVertices());
+        EXPECT_EQ(loaded.getNumArcs(), original.getNumArcs());
+        for (size_t u = 0; u < 5; ++u) {
+            for (size_t v = 0; v < 5; ++v) {
+                EXPECT_EQ(loaded.getEdgeWeight(u, v), original.getEdgeWeight(u, v));
+            }
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, RoundTripDirectedKeepsReverseArcs) {
+    const std::string path = "graph_file_test_directed.bin";
+    saveGraphFile(sampleGraph(true), path);
+    {
+        CsrGraph loaded = loadGraphFile(path);
+        EXPECT_TRUE(loaded.isDirected());
+        EXPECT_EQ(loaded.getInDegree(1), 2);
+        EXPECT_EQ(loaded.getEdgeWeight(1, 0), -1);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, SectionsAreAligned) {
+    const std::string path = "graph_file_test_aligned.bin";
+    saveGraphFile(sampleGraph(true), path);
+    {
+        CsrGraph loaded = loadGraphFile(path);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(loaded.getOffsets()) % 64, 0);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(loaded.getTargets()) % 64, 0);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(loaded.getWeights()) % 64, 0);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(loaded.getReverseTargets()) % 64, 0);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, DijkstraRunsOnMappedGraph) {
+    const std::string path = "graph_file_test_dijkstra.bin";
+    saveGraphFile(sampleGraph(false), path);
+    {
+        CsrGraph loaded = loadGraphFile(path);
+        Dijkstra d(loaded);
+        myVector<int> pred;
+        auto dist = d.shortestPathsWithPredecessors(0, Dijkstra::D_HEAP, pred, 2);
+        EXPECT_EQ(dist[1], 3);
+        EXPECT_EQ(dist[4], 11);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, MappedGraphOutlivesCopies) {
+    const std::string path = "graph_file_test_copies.bin";
+    saveGraphFile(sampleGraph(false), path);
+    CsrGraph* copy = nullptr;
+    {
+        CsrGraph loaded = loadGraphFile(path);
+        copy = new CsrGraph(loaded);
+    }
+    EXPECT_EQ(copy->getEdgeWeight(3, 4), 3);
+    delete copy;
+    std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, RejectsForeignFile) {
+    const std::string path = "graph_file_test_foreign.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (int i = 0; i < 256; ++i) out.put('x');
+    }
+    EXPECT_THROW(loadGraphFile(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, RejectsCorruptedAdjacency) {
+    const std::string path = "graph_file_test_corrupted.bin";
+    saveGraphFile(sampleGraph(true), path);
+    const GraphFileHeader header = readHeader(path);
+    const uint64_t* sections = header.sectionOffsets;
+
+    // A target past the last vertex, in the forward and then the reverse arcs.
+    overwrite<uint32_t>(path, sections[GraphFileHeader::TARGETS] + sizeof(uint32_t), 5);
+    EXPECT_THROW(loadGraphFile(path), std::runtime_error);
+    saveGraphFile(sampleGraph(true), path);
+    overwrite<uint32_t>(path, sections[GraphFileHeader::REVERSE_TARGETS], 7);
+    EXPECT_THROW(loadGraphFile(path), std::runtime_error);
+
+    // Row 1 ending before it starts, with both ends of the offsets intact.
+    saveGraphFile(sampleGraph(true), path);
+    overwrite<uint64_t>(path, sections[GraphFileHeader::OFFSETS] + 2 * sizeof(uint64_t), 0);
+    EXPECT_THROW(loadGraphFile(path), std::runtime_error);
+    saveGraphFile(sampleGraph(true), path);
+    overwrite<uint64_t>(path, sections[GraphFileHeader::REVERSE_OFFSETS] + 2 * sizeof(uint64_t), 9);
+    EXPECT_THROW(loadGraphFile(path), std::runtime_error);
+
+    saveGraphFile(sampleGraph(true), path);
+    EXPECT_EQ(loadGraphFile(path).getNumArcs(), 5u);
+    std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, RejectsCountsThatWrapTheSectionSize) {
+    const std::string path = "graph_file_test_counts.bin";
+    const uint64_t huge = uint64_t(1) << 62;
+    const uint64_t arcCounts[] = { offsetof(GraphFileHeader, numArcs), offsetof(GraphFileHeader, numReverseArcs) };
+    for (uint64_t field : arcCounts) {
+        // 2^62 four-byte targets wrap to a zero-byte section; the matching last offset gets past the row check.
+        saveGraphFile(sampleGraph(true), path);
+        const GraphFileHeader header = readHeader(path);
+        const bool reverse = field == offsetof(GraphFileHeader, numReverseArcs);
+        overwrite<uint64_t>(path, field, huge);
+        overwrite<uint64_t>(path, header.sectionOffsets[reverse ? GraphFileHeader::REVERSE_OFFSETS : GraphFileHeader::OFFSETS] +
+            header.numVertices * sizeof(uint64_t), huge);
+        EXPECT_THROW(loadGraphFile(path), std::runtime_error);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(GraphFileTest, MissingFileThrows) {
+    EXPECT_THROW(loadGraphFile("graph_file_test_missing.bin"), std::runtime_error);
+}
+
+TEST(GraphFileTest, TypedWeightsRoundTrip) {
+    const std::string path = "graph_file_test_typed.bin";
+    BasicCsrGraphBuilder<uint16_t> b(3);
+    b.addEdge(0, 1, 40000);
+    b.addEdge(1, 2, 7);
+    saveGraphFile(b.build(), path);
+    {
+        BasicCsrGraph<uint16_t> loaded = loadGraphFile<uint16_t>(path);
+        EXPECT_EQ(loaded.getEdgeWeight(1, 0), 40000);
+        EXPECT_THROW(loadGraphFile<int>(path), std::runtime_error);
+        EXPECT_THROW(loadGraphFile<float>(path), std::runtime_error);
+    }
+    std::remove(path.c_str());
+}
@@ -0,0 +1,217 @@
+#include <gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "graphImport.h"
+#include "dijkstra.h"
+
+namespace {
+
+void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream out(path, std::ios::binary);
+    out << contents;
+}
+
+}
+
+TEST(GraphImportTest, DimacsArcsAreDirectedAndOneBased) {
+    const std::string path = "import_test.gr";
+    writeFile(path,
+        "c sample road graph\n"
+        "p sp 4 5\n"
+        "c arcs follow\n"
+        "a 1 2 3\n"
+        "a 2 3 4\n"
+        "a 3 4 5\r\n"
+        "a 4 1 6\n"
+        "a 1 3 10");
+    CsrGraph g = importDimacs(path, true, 3);
+    std::remove(path.c_str());
+
+    EXPECT_TRUE(g.isDirected());
+    EXPECT_EQ(g.getNumVertices(), 4);
+    EXPECT_EQ(g.getNumArcs(), 5);
+    EXPECT_EQ(g.getEdgeWeight(0, 1), 3);
+    EXPECT_EQ(g.getEdgeWeight(1, 0), -1);
+    EXPECT_EQ(g.getEdgeWeight(2, 3), 5);
+    EXPECT_EQ(g.getEdgeWeight(0, 2), 10);
+}
+
+TEST(GraphImportTest, ParallelChunksMatchSingleThread) {
+    const std::string path = "import_test_chunks.gr";
+    std::string contents = "p sp 300 299\n";
+    for (int i = 1; i < 300; ++i) {
+        contents += "a " + std::to_string(i) + " " + std::to_string(i + 1) + " " + std::to_string(i % 7 + 1) + "\n";
+    }
+    writeFile(path, contents);
+    CsrGraph serial = importDimacs(path, false, 1);
+    CsrGraph parallel = importDimacs(path, false, 8);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(serial.getNumArcs(), parallel.getNumArcs());
+    Dijkstra a(serial), b(parallel);
+    myVector<int> pa, pb;
+    auto da = a.shortestPathsWithPredecessors(0, Dijkstra::D_HEAP, pa, 4);
+    auto db = b.shortestPathsWithPredecessors(0, Dijkstra::D_HEAP, pb, 4);
+    for (size_t i = 0; i < da.size(); ++i) {
+        EXPECT_EQ(da[i], db[i]);
+    }
+    int expected = 0;
+    for (int i = 1; i < 300; ++i) {
+        expected += i % 7 + 1;
+    }
+    EXPECT_EQ(da[299], expected);
+}
+
+TEST(GraphImportTest, DimacsRequiresProblemLine) {
+    const std::string path = "import_test_noproblem.gr";
+    writeFile(path, "c nothing\na 1 2 3\n");
+    EXPECT_THROW(importDimacs(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(GraphImportTest, DimacsRejectsOutOfRangeVertex) {
+    const std::string path = "import_test_range.gr";
+    writeFile(path, "p sp 2 1\na 1 3 1\n");
+    EXPECT_THROW(importDimacs(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(GraphImportTest, SnapEdgeListWithOptionalWeights) {
+    const std::string path = "import_test_snap.txt";
+    writeFile(path,
+        "# Directed graph: sample\n"
+        "# FromNodeId\tToNodeId\n"
+        "0\t1\n"
+        "1\t4\t7\n"
+        "\n"
+        "3 3 5\n"
+        "4 2\n");
+    CsrGraph g = importSnapEdgeList(path, false, 2);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(g.isDirected());
+    EXPECT_EQ(g.getNumVertices(), 5);
+    EXPECT_EQ(g.getEdgeWeight(1, 0), 1);
+    EXPECT_EQ(g.getEdgeWeight(4, 1), 7);
+    EXPECT_EQ(g.getEdgeWeight(2, 4), 1);
+    EXPECT_EQ(g.getDegree(3), 0);
+}
+
+TEST(GraphImportTest, SnapRejectsGarbage) {
+    const std::string path = "import_test_snap_bad.txt";
+    writeFile(path, "0 1\nx y\n");
+    EXPECT_THROW(importSnapEdgeList(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(GraphImportTest, MatrixMarketSymmetricReal) {
+    const std::string path = "import_test.mtx";
+    writeFile(path,
+        "%%MatrixMarket matrix coordinate real symmetric\n"
+        "% comment\n"
+        "3 3 2\n"
+        "2 1 2.6\n"
+        "3 2 1.5e1\n");
+    CsrGraph g = importMatrixMarket(path, 2);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(g.isDirected());
+    EXPECT_EQ(g.getEdgeWeight(0, 1), 3);
+    EXPECT_EQ(g.getEdgeWeight(1, 0), 3);
+    EXPECT_EQ(g.getEdgeWeight(2, 1), 15);
+}
+
+TEST(GraphImportTest, MatrixMarketGeneralPattern) {
+    const std::string path = "import_test_pattern.mtx";
+    writeFile(path,
+        "%%MatrixMarket matrix coordinate pattern general\n"
+        "3 3 2\n"
+        "1 2\n"
+        "2 3\n");
+    CsrGraph g = importMatrixMarket(path);
+    std::remove(path.c_str());
+
+    EXPECT_TRUE(g.isDirected());
+    EXPECT_EQ(g.getEdgeWeight(0, 1), 1);
+    EXPECT_EQ(g.getEdgeWeight(1, 0), -1);
+    EXPECT_EQ(g.getInDegree(2), 1);
+}
+
+TEST(GraphImportTest, MatrixMarketRejectsArrayFormat) {
+    const std::string path = "import_test_array.mtx";
+    writeFile(path, "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n");
+    EXPECT_THROW(importMatrixMarket(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(GraphImportTest, TypedWeights) {
+    const std::string path = "import_test_typed.mtx";
+    writeFile(path,
+        "%%MatrixMarket matrix coordinate real general\n"
+        "2 2 1\n"
+        "1 2 0.75\n");
+    BasicCsrGraph<double> g = importMatrixMarket<double>(path);
+    EXPECT_DOUBLE_EQ(g.getEdgeWeight(0, 1), 0.75);
+
+    writeFile(path, "p sp 2 1\na 1 2 70000\n");
+    EXPECT_THROW(importDimacs<uint16_t>(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(GraphImportTest, NonPositiveWeightsAreMalformed) {
+    const std::string path = "import_test_weights.txt";
+    writeFile(path, "p sp 2 1\na 1 2 0\n");
+    EXPECT_THROW(importDimacs(path), std::runtime_error);
+
+    writeFile(path, "0 1 0\n");
+    EXPECT_THROW(importSnapEdgeList(path), std::runtime_error);
+
+    // 0.3 rounds to zero for integer weights but stays a valid double.
+    writeFile(path,
+        "%%MatrixMarket matrix coordinate real general\n"
+        "2 2 1\n"
+        "1 2 0.3\n");
+    EXPECT_THROW(importMatrixMarket(path), std::runtime_error);
+    EXPECT_DOUBLE_EQ(importMatrixMarket<double>(path).getEdgeWeight(0, 1), 0.3);
+
+    writeFile(path,
+        "%%MatrixMarket matrix coordinate real general\n"
+        "2 2 1\n"
+        "1 2 -2\n");
+    EXPECT_THROW(importMatrixMarket<double>(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(GraphImportTest, OversizedNumbersAreMalformed) {
+    const std::string path = "import_test_oversized.txt";
+    // 2^64 + 1 would wrap to vertex 1.
+    writeFile(path, "0 18446744073709551617\n");
+    EXPECT_THROW(importSnapEdgeList(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(GraphImportTest, DimacsCoordinates) {
+    const std::string path = "import_test.co";
+    writeFile(path,
+        "c coordinates\n"
+        "p aux sp co 3\n"
+        "v 1 -73530767 41085396\n"
+        "v 3 10 -20\n");
+    VertexCoordinates coordinates = importDimacsCoordinates(path);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(coordinates.size(), 3);
+    EXPECT_DOUBLE_EQ(coordinates.getX(0), -73530767.0);
+    EXPECT_DOUBLE_EQ(coordinates.getY(0), 41085396.0);
+    EXPECT_DOUBLE_EQ(coordinates.getX(1), 0.0);
+    EXPECT_DOUBLE_EQ(coordinates.getY(2), -20.0);
+}
+
+TEST(GraphImportTest, DimacsCoordinatesRejectBadIds) {
+    const std::string path = "import_test_bad.co";
+    writeFile(path, "p aux sp co 2\nv 3 1 1\n");
+    EXPECT_THROW(importDimacsCoordinates(path), std::runtime_error);
+    writeFile(path, "v 1 1 1\n");
+    EXPECT_THROW(importDimacsCoordinates(path), std::runtime_error);
+    std::remove(path.c_str());
+}
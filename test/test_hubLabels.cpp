@@ -0,0 +1,156 @@
+#include <gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "hubLabels.h"
+#include "testGraphs.h"
+
+namespace {
+
+void expectExact(const CsrGraph& g, const HubLabels& labels) {
+    expectMatchesDijkstra(g, 7, 1, [&](int source, int target, int expected) {
+        ASSERT_EQ(labels.distance(source, target), expected);
+    });
+}
+
+// The section table follows the magic, four 32-bit fields and three 64-bit counts of the file header.
+const uint64_t sectionTablePosition = 8 + 4 * 4 + 3 * 8;
+enum { FORWARD_OFFSETS, FORWARD_HUBS, FORWARD_DISTANCES, BACKWARD_OFFSETS, BACKWARD_HUBS };
+
+template <typename T>
+void overwrite(const std::string& path, int section, uint64_t index, T value) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    uint64_t position = 0;
+    file.seekg(static_cast<std::streamoff>(sectionTablePosition + section * sizeof(uint64_t)));
+    file.read(reinterpret_cast<char*>(&position), sizeof(position));
+    file.seekp(static_cast<std::streamoff>(position + index * sizeof(T)));
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// The forward entry count sits after the magic, four 32-bit fields and the vertex count.
+void overwriteForwardEntries(const std::string& path, uint64_t value) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(static_cast<std::streamoff>(8 + 4 * 4 + 8));
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}
+
+TEST(HubLabelsTest, MatchesDijkstraOnUndirectedGrid) {
+    CsrGraph g = gridGraph(14, false);
+    ContractionHierarchy ch(g, 1);
+    HubLabels labels(ch, 2);
+    EXPECT_FALSE(labels.isDirected());
+    expectExact(g, labels);
+}
+
+TEST(HubLabelsTest, MatchesDijkstraOnDirectedGrid) {
+    CsrGraph g = gridGraph(12, true);
+    ContractionHierarchy ch(g, 2);
+    HubLabels labels(ch, 1);
+    EXPECT_TRUE(labels.isDirected());
+    expectExact(g, labels);
+}
+
+TEST(HubLabelsTest, PruningKeepsLabelsSmall) {
+    CsrGraph g = gridGraph(20, false);
+    ContractionHierarchy ch(g, 1);
+    HubLabels labels(ch);
+    HubLabels::Stats stats = labels.getStats();
+    EXPECT_EQ(stats.backwardEntries, 0u);
+    EXPECT_DOUBLE_EQ(stats.averageLabelSize, static_cast<double>(stats.forwardEntries) / 400);
+    EXPECT_LT(stats.averageLabelSize, 400.0 / 4);
+    EXPECT_GE(stats.maxLabelSize, 1u);
+    EXPECT_GT(stats.memoryBytes, stats.forwardEntries * sizeof(int));
+
+    size_t sumOfSizes = 0;
+    for (size_t v = 0; v < 400; ++v) {
+        EXPECT_GE(labels.getForwardLabelSize(v), 1u);
+        EXPECT_EQ(labels.getBackwardLabelSize(v), labels.getForwardLabelSize(v));
+        sumOfSizes += labels.getForwardLabelSize(v);
+    }
+    EXPECT_EQ(sumOfSizes, stats.forwardEntries);
+}
+
+TEST(HubLabelsTest, UnreachableAndInvalidVertices) {
+    Graph g(4, true);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 2);
+    g.addEdge(0, 2, 5);
+    ContractionHierarchy ch(g);
+    HubLabels labels(ch);
+    EXPECT_EQ(labels.distance(0, 2), 4);
+    EXPECT_EQ(labels.distance(2, 0), -1);
+    EXPECT_EQ(labels.distance(3, 3), 0);
+    EXPECT_EQ(labels.distance(0, 3), -1);
+    EXPECT_THROW(labels.distance(0, 4), std::out_of_range);
+    EXPECT_THROW(labels.distance(-1, 0), std::out_of_range);
+}
+
+TEST(HubLabelsTest, LabelsRoundTripThroughMappedFile) {
+    CsrGraph g = gridGraph(10, true);
+    ContractionHierarchy ch(g, 1);
+    HubLabels labels(ch);
+    const std::string path = "hub_labels_test.hl";
+    labels.save(path);
+    {
+        HubLabels loaded = HubLabels::load(path);
+        EXPECT_THROW((BasicHubLabels<int, int64_t>::load(path)), std::runtime_error);
+        EXPECT_TRUE(loaded.isDirected());
+        EXPECT_EQ(loaded.getStats().forwardEntries, labels.getStats().forwardEntries);
+        EXPECT_EQ(loaded.getStats().backwardEntries, labels.getStats().backwardEntries);
+        expectExact(g, loaded);
+    }
+    std::remove(path.c_str());
+    EXPECT_THROW(HubLabels::load(path), std::runtime_error);
+}
+
+TEST(HubLabelsTest, RejectsCorruptedLabels) {
+    CsrGraph g = gridGraph(6, true);
+    ContractionHierarchy ch(g, 1);
+    HubLabels labels(ch);
+    const std::string path = "hub_labels_test_corrupted.hl";
+
+    labels.save(path);
+    overwrite<uint32_t>(path, FORWARD_HUBS, 3, 36);
+    EXPECT_THROW(HubLabels::load(path), std::runtime_error);
+    labels.save(path);
+    overwrite<uint32_t>(path, BACKWARD_HUBS, 0, 1000);
+    EXPECT_THROW(HubLabels::load(path), std::runtime_error);
+
+    // A label ending before it starts, with both ends of the offsets intact.
+    labels.save(path);
+    overwrite<uint64_t>(path, FORWARD_OFFSETS, 2, 0);
+    EXPECT_THROW(HubLabels::load(path), std::runtime_error);
+    labels.save(path);
+    overwrite<uint64_t>(path, BACKWARD_OFFSETS, 1, labels.getStats().backwardEntries + 1);
+    EXPECT_THROW(HubLabels::load(path), std::runtime_error);
+
+    labels.save(path);
+    EXPECT_EQ(HubLabels::load(path).distance(0, 35), labels.distance(0, 35));
+    std::remove(path.c_str());
+}
+
+TEST(HubLabelsTest, RejectsCountsThatWrapTheSectionSize) {
+    CsrGraph g = gridGraph(6, false);
+    ContractionHierarchy ch(g, 1);
+    HubLabels labels(ch);
+    const std::string path = "hub_labels_test_counts.hl";
+
+    // 2^62 four-byte hubs wrap to a zero-byte section; the matching last offset gets past the label checks.
+    const uint64_t huge = uint64_t(1) << 62;
+    labels.save(path);
+    overwriteForwardEntries(path, huge);
+    overwrite<uint64_t>(path, FORWARD_OFFSETS, 36, huge);
+    EXPECT_THROW(HubLabels::load(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(HubLabelsTest, WideDistances) {
+    BasicGraph<uint16_t> g(3);
+    g.addEdge(0, 1, 60000);
+    g.addEdge(1, 2, 60000);
+    BasicContractionHierarchy<uint16_t, uint32_t> ch(g);
+    BasicHubLabels<uint16_t, uint32_t> labels(ch);
+    EXPECT_EQ(labels.distance(0, 2), 120000u);
+    EXPECT_EQ(labels.distance(2, 0), 120000u);
+}
@@ -0,0 +1,145 @@
+#include <gtest.h>
+#include "reorder.h"
+#include "dijkstra.h"
+
+namespace {
+
+CsrGraph scrambledPath(size_t n, const myVector<uint32_t>& labels) {
+    CsrGraphBuilder b(n);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        b.addEdge(labels[i], labels[i + 1], static_cast<int>(i % 5 + 1));
+    }
+    return b.build();
+}
+
+myVector<uint32_t> scrambledLabels(size_t n) {
+    myVector<uint32_t> labels(n);
+    for (size_t i = 0; i < n; ++i) {
+        labels[i] = static_cast<uint32_t>((i * 37) % n);
+    }
+    return labels;
+}
+
+template <typename W>
+size_t bandwidth(const BasicCsrGraph<W>& g) {
+    size_t result = 0;
+    for (size_t u = 0; u < g.getNumVertices(); ++u) {
+        g.forEachNeighbor(u, [&](size_t v, W) { result = std::max(result, u > v ? u - v : v - u); });
+    }
+    return result;
+}
+
+bool isPermutation(const myVector<uint32_t>& p) {
+    myVector<bool> seen(p.size(), false);
+    for (size_t i = 0; i < p.size(); ++i) {
+        if (p[i] >= p.size() || seen[p[i]]) return false;
+        seen[p[i]] = true;
+    }
+    return true;
+}
+
+}
+
+TEST(ReorderTest, OrderingsArePermutations) {
+    CsrGraph g = scrambledPath(64, scrambledLabels(64));
+    EXPECT_TRUE(isPermutation(reverseCuthillMcKeeOrder(g)));
+    EXPECT_TRUE(isPermutation(bfsOrder(g)));
+    EXPECT_TRUE(isPermutation(degreeOrder(g)));
+}
+
+TEST(ReorderTest, CuthillMcKeeRestoresPathLocality) {
+    CsrGraph g = scrambledPath(101, scrambledLabels(101));
+    EXPECT_GT(bandwidth(g), 10);
+    CsrGraph relabeled = relabelGraph(g, reverseCuthillMcKeeOrder(g));
+    EXPECT_EQ(bandwidth(relabeled), 1);
+    EXPECT_EQ(relabeled.getNumArcs(), g.getNumArcs());
+}
+
+TEST(ReorderTest, BfsOrderCoversDisconnectedComponents) {
+    CsrGraphBuilder b(5);
+    b.addEdge(3, 4, 1);
+    b.addEdge(0, 2, 1);
+    CsrGraph g = b.build();
+    auto order = bfsOrder(g);
+    EXPECT_TRUE(isPermutation(order));
+    EXPECT_EQ(order[0], 0);
+    EXPECT_EQ(order[2], 1);
+}
+
+TEST(ReorderTest, DegreeOrderPutsHubsFirst) {
+    CsrGraphBuilder b(4);
+    b.addEdge(3, 0, 1);
+    b.addEdge(3, 1, 1);
+    b.addEdge(3, 2, 1);
+    auto order = degreeOrder(b.build());
+    EXPECT_EQ(order[3], 0);
+}
+
+TEST(ReorderTest, HilbertOrderKeepsNeighboursClose) {
+    myVector<double> x, y;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            x.push_back(i);
+            y.push_back(j);
+        }
+    }
+    auto order = hilbertOrder(x, y);
+    EXPECT_TRUE(isPermutation(order));
+    myVector<uint32_t> inverse(order.size());
+    for (size_t v = 0; v < order.size(); ++v) inverse[order[v]] = static_cast<uint32_t>(v);
+    for (size_t k = 0; k + 1 < inverse.size(); ++k) {
+        const double dx = x[inverse[k]] - x[inverse[k + 1]];
+        const double dy = y[inverse[k]] - y[inverse[k + 1]];
+        EXPECT_DOUBLE_EQ(dx * dx + dy * dy, 1.0);
+    }
+}
+
+TEST(ReorderTest, RelabelRejectsInvalidPermutation) {
+    CsrGraph g = scrambledPath(3, scrambledLabels(3));
+    myVector<uint32_t> bad(3, 0);
+    EXPECT_THROW(relabelGraph(g, bad), std::invalid_argument);
+}
+
+TEST(ReorderTest, DijkstraMapsIdsBack) {
+    CsrGraph g = scrambledPath(50, scrambledLabels(50));
+    ReorderedGraph reordered(g, reverseCuthillMcKeeOrder(g));
+    Dijkstra plain(g);
+    Dijkstra local(reordered);
+    myVector<int> predPlain, predLocal;
+    auto expected = plain.shortestPathsWithPredecessors(7, Dijkstra::D_HEAP, predPlain, 2);
+    auto actual = local.shortestPathsWithPredecessors(7, Dijkstra::D_HEAP, predLocal, 2);
+    for (size_t v = 0; v < 50; ++v) {
+        EXPECT_EQ(actual[v], expected[v]);
+        EXPECT_EQ(predLocal[v], predPlain[v]);
+    }
+    EXPECT_THROW(local.shortestPathsWithPredecessors(50, Dijkstra::D_HEAP, predLocal, 2), std::out_of_range);
+}
+
+TEST(ReorderTest, ReverseSearchOnDirectedReorderedGraph) {
+    CsrGraphBuilder b(4, true);
+    b.addEdge(2, 0, 1);
+    b.addEdge(0, 3, 2);
+    b.addEdge(3, 1, 4);
+    CsrGraph g = b.build();
+    ReorderedGraph reordered(g, degreeOrder(g));
+    Dijkstra d(reordered);
+    myVector<int> succ;
+    auto to = d.shortestPathsToTarget(1, Dijkstra::BINOMIAL_HEAP, succ, 2);
+    EXPECT_EQ(to[2], 7);
+    EXPECT_EQ(succ[2], 0);
+    EXPECT_EQ(succ[0], 3);
+}
+
+TEST(ReorderTest, PointToPointPathInOriginalIds) {
+    CsrGraph g = scrambledPath(30, scrambledLabels(30));
+    ReorderedGraph reordered(g, bfsOrder(g));
+    Dijkstra plain(g);
+    Dijkstra local(reordered);
+    Dijkstra::PathResult expected = plain.shortestPath(3, 21, Dijkstra::D_HEAP, 2);
+    Dijkstra::PathResult actual = local.shortestPath(3, 21, Dijkstra::D_HEAP, 2);
+    EXPECT_EQ(actual.distance, expected.distance);
+    ASSERT_EQ(actual.path.size(), expected.path.size());
+    for (size_t i = 0; i < actual.path.size(); ++i) {
+        EXPECT_EQ(actual.path[i], expected.path[i]);
+    }
+}